@@ -49,6 +49,14 @@ typedef enum
     DIAG_TIMING_METRIC_PLAY,
     DIAG_TIMING_METRIC_PAT_PMT_ACQUIRED,
     DIAG_TIMING_METRIC_PTS_DECODED,
+    DIAG_TIMING_METRIC_DLNA_PROBE_START,
+    DIAG_TIMING_METRIC_DLNA_PROBE_END,
+    DIAG_TIMING_METRIC_PIPELINE_CREATED,
+    DIAG_TIMING_METRIC_SOURCE_CREATED,
+    DIAG_TIMING_METRIC_DEMUX_ADDED,
+    DIAG_TIMING_METRIC_PAUSED,
+    DIAG_TIMING_METRIC_FIRST_PTS_RECEIVED,
+    DIAG_TIMING_METRIC_DECODER_UNMUTED,
 }tCgmiDiag_timingEvent;
 
 
@@ -60,6 +68,16 @@ typedef struct
     unsigned long long markTime;
 }tCgmiDiags_timingMetric;
 
+/** Time spent reaching a stage of a load
+ */
+typedef struct
+{
+    tCgmiDiag_timingEvent timingEvent;  ///< Stage (marker) reached
+    unsigned long long markTime;        ///< When it was reached, MS since the Epoch
+    unsigned long long sinceLoad;       ///< MS since the LOAD marker
+    unsigned long long duration;        ///< MS since the previous marker of the same load
+}tCgmiDiags_stageDuration;
+
 
 /**
  *  \brief \b cgmiDiags_GetTimingMetricsMaxCount
@@ -109,6 +127,20 @@ cgmi_Status cgmiDiags_GetTimingMetrics(tCgmiDiags_timingMetric metrics[], int *p
  */
 cgmi_Status cgmiDiags_ResetTimingMetrics(void);
 
+/**
+ *  \brief \b cgmiDiags_GetStageDurations
+ *  This is a request to get the per stage latency breakdown of a load, i.e. every timing marker recorded
+ *  for a session index after its LOAD marker, in the order they were reached.
+ *  \param[in] sessionIndex  The session index (tCgmiDiags_timingMetric.sessionIndex) of the load.
+ *  \param[out] stages  An array to be populated with the stages.  This array must be allocated by the caller.
+ *  \param[in,out] pCount    In: Indicates the size of stages array.  Out:  Indicates the actual number of stages populated.
+ *  \pre    The system has to be initialized via cgmi_Init()
+ *  \return  CGMI_ERROR_SUCCESS when the API succeeds
+ *  \return  CGMI_ERROR_BAD_PARAM when the LOAD marker of sessionIndex is not (or no longer) in the timing metrics buffer
+ *  \ingroup CGMI-diags
+ */
+cgmi_Status cgmiDiags_GetStageDurations(unsigned int sessionIndex, tCgmiDiags_stageDuration stages[], int *pCount);
+
 #ifdef __cplusplus
 }
 #endif
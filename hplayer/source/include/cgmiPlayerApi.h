@@ -80,7 +80,7 @@ typedef enum
    NOTIFY_SEEK_DONE,                      ///< The seek has completed
    NOTIFY_START_OF_STREAM,                ///< The Current position is now at the Start of the stream
    NOTIFY_END_OF_STREAM,                  ///< You are at the end of stream or EOF
-   NOTIFY_PSI_READY,                      ///< PSI is detected, ready to decode (valid for TS content only)
+   NOTIFY_PSI_READY,                      ///< PSI is detected, ready to decode (valid for TS content only), may come from the PSI cache of a URI loaded before
    NOTIFY_DECRYPTION_FAILED,              ///< Not able to decrypt the stream, we don't know how to decrypt
    NOTIFY_NO_DECRYPTION_KEY,              ///<No key has been provided to decrypt this content.
    NOTIFY_VIDEO_ASPECT_RATIO_CHANGED,     ///<The stream has changed it's aspect ratio
@@ -90,10 +90,11 @@ typedef enum
    NOTIFY_CHANGED_LANGUAGE_TELETEXT,      ///<The teletext language has changed.
    NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE,   ///<The requested URL could not be opened.
    NOTIFY_CHANGED_RATE,                   ///<The playback rate has changed.
-   NOTIFY_DECODE_ERROR,                   ///<Decoder issued errors.
+   NOTIFY_DECODE_ERROR,                   ///<Decoder issued errors, code holds the CGMI_DECODE_BRANCH_ bits recovered.
    NOTIFY_LOAD_DONE,                      ///<Load URI done.
    NOTIFY_NETWORK_ERROR,                  ///<A network error has occured.
-   NOTIFY_MEDIAPLAYER_UNKNOWN             ///<An unexpected error has occured.
+   NOTIFY_MEDIAPLAYER_UNKNOWN,            ///<An unexpected error has occured.
+   NOTIFY_PSI_CHANGED                     ///<PSI changed after NOTIFY_PSI_READY, code holds the CGMI_PSI_CHANGED_ bits.
 
 }tcgmi_Event;
 
@@ -141,6 +142,17 @@ typedef enum
    STREAM_TYPE_UNKNOWN
 }tcgmi_StreamType;
 
+/** Pipeline state reported by cgmi_GetState
+ */
+typedef enum
+{
+   PIPELINE_STATE_NONE = 0,               ///<No state change pending (only reported as the pending state)
+   PIPELINE_STATE_NULL,                   ///<Nothing loaded
+   PIPELINE_STATE_READY,                  ///<Pipeline created but not prerolled
+   PIPELINE_STATE_PAUSED,                 ///<Prerolled, or paused by the user
+   PIPELINE_STATE_PLAYING                 ///<Playing
+}tcgmi_PipelineState;
+
 typedef enum
 {
     PICTURE_CTRL_CONTRAST = 0,
@@ -181,6 +193,77 @@ typedef struct
    uint64_t hwAudioDecHandle;
 }sessionInfo;
 
+#define CGMI_AVSYNC_HISTOGRAM_BINS 9
+
+/** A/V sync statistics of a session, see cgmi_GetAvSyncStats
+
+    Drift is the presented video PTS minus the presented audio PTS in ms,
+    positive when video is ahead of audio.  histogram[] counts the drift
+    samples taken since the last load by bucket (ms):
+    < -1000, [-1000,-200), [-200,-100), [-100,-40), [-40,40], (40,100],
+    (100,200], (200,1000], > 1000
+ */
+typedef struct
+{
+   int          currentDriftMs;                          ///<Most recent drift sample
+   float        driftSlope;                              ///<Drift trend over the recent samples in ms per second
+   unsigned int sampleIntervalMs;                        ///<Rate at which the drift is sampled
+   unsigned int numSamples;                              ///<Number of samples since the last load
+   unsigned int numRecoveries;                           ///<Flushes triggered by sustained drift
+   unsigned int histogram[CGMI_AVSYNC_HISTOGRAM_BINS];   ///<Drift samples per bucket
+}tcgmi_AvSyncStats;
+
+/** Event delivery statistics of a session, see cgmi_GetEventQueueStats
+ */
+typedef struct
+{
+   unsigned int currentDepth;       ///<Events emitted but not yet delivered
+   unsigned int maxDepth;           ///<Deepest the queue has been
+   uint64_t     numDispatched;      ///<Events delivered
+   unsigned int avgLatencyUs;       ///<Mean time from emit to the callback being called
+   unsigned int maxLatencyUs;       ///<Longest time from emit to the callback being called
+}tcgmi_EventQueueStats;
+
+/** Code reported with NOTIFY_DECODE_ERROR, the branches that were flushed to recover
+ */
+#define CGMI_DECODE_BRANCH_VIDEO   0x1
+#define CGMI_DECODE_BRANCH_AUDIO   0x2
+#define CGMI_DECODE_BRANCH_ALL     (CGMI_DECODE_BRANCH_VIDEO | CGMI_DECODE_BRANCH_AUDIO)
+
+/** Code reported with NOTIFY_PSI_CHANGED, the tables that differ from the previous PSI
+ */
+#define CGMI_PSI_CHANGED_PROGRAMS        0x01
+#define CGMI_PSI_CHANGED_STREAMS         0x02
+#define CGMI_PSI_CHANGED_AUDIO           0x04
+#define CGMI_PSI_CHANGED_SUBTITLE        0x08
+#define CGMI_PSI_CHANGED_CLOSED_CAPTION  0x10
+#define CGMI_PSI_CHANGED_SELECTED_PROGRAM 0x20
+
+#define CGMI_DECODER_STATS_HISTORY 300
+
+/** Decoder error counters, as read from the decoders or as a per-interval delta
+ */
+typedef struct
+{
+   unsigned int videoPtsErrors;
+   unsigned int videoDecodeErrors;
+   unsigned int videoDecodeDrops;
+   unsigned int audioPtsErrors;
+}tcgmi_DecoderCounters;
+
+/** Decoder statistics of a session, see cgmi_GetDecoderStats
+
+    history[] holds how much each counter grew per intervalMs, oldest entry
+    first, covering the last numIntervals intervals the session was sampled.
+ */
+typedef struct
+{
+   tcgmi_DecoderCounters current;                                 ///<Counters at the last sample
+   unsigned int          intervalMs;                              ///<Span of one history entry
+   unsigned int          numIntervals;                            ///<Valid entries in history
+   tcgmi_DecoderCounters history[CGMI_DECODER_STATS_HISTORY];     ///<Per-interval deltas, oldest first
+}tcgmi_DecoderStats;
+
 /** Function pointer type for event callback that CGMI uses to report async events
  */
 typedef void (*cgmi_EventCallback)(void *pUserData, void* pSession, tcgmi_Event event, uint64_t code );
@@ -257,7 +340,8 @@ cgmi_Status cgmi_Term (void);
  *  \brief \b cgmi_CreateSession
  *
  *  Create a session to interact with the gstreamer frame work
- *  \param[in] eventCB  This is a function pointer for CGMI to report async events too.
+ *  \param[in] eventCB  This is a function pointer for CGMI to report async events too.  It is called
+ *                      from a CGMI thread, one event at a time in the order they occurred.
  *
  *  \param[in] pUserData  This is a private userdata to be returned in callbacks
  *
@@ -265,7 +349,11 @@ cgmi_Status cgmi_Term (void);
  *
  * \post    On success the user can call all the remaining CGMI api's with the provided Session handle
  *
+ *  The handle is an opaque identifier, not a pointer.  Once the session is destroyed the handle
+ *  is never valid again, calls made with it fail with CGMI_ERROR_INVALID_HANDLE.
+ *
  * \return  CGMI_ERROR_SUCCESS when everything has started correctly
+ * \return  CGMI_ERROR_OUT_OF_MEMORY when no more sessions can be created
  *
  *  \image html playback_trickmode.png "Hot to do playback and trick modes "
  *
@@ -317,7 +405,10 @@ cgmi_Status cgmi_canPlayType(const char *type, int *pbCanPlay );
  *
  *  \param[in]  cpblob - a pointer to a cpBlobStruct. This struct contains  data which  is needed
  *  for encrypted HLS streaming.For all other types of sessions(clear HLS/Live/Playback etc') NULL should be passed to the cpblob var.
- *  \param[in] sessionSettings - a pointer to session settings JSON string
+ *  \param[in] sessionSettings - a pointer to session settings JSON string.  Recognized keys are
+ *  "AudioLanguage" (default ISO 639 audio language) and "MonitorIntervalMs" (A/V drift sampling
+ *  period in ms, default 250, the decoder error counters are read once a second regardless),
+ *  e.g. {"AudioLanguage":"eng","MonitorIntervalMs":"500"}
  *  \post    On success the user can now play the uri pointed to. The user has to wait for NOTIFY_LOAD_DONE message before querying
  *           the duration or other metadata info of the asset pointed by the URI.
  *
@@ -332,6 +423,56 @@ cgmi_Status cgmi_canPlayType(const char *type, int *pbCanPlay );
  */
 cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings );
 
+/**
+ *  \brief \b cgmi_LoadAsync
+ *
+ *  Same as cgmi_Load but returns as soon as the pipeline has been created.  Resolving the uri,
+ *  waiting for the previous pipeline to be torn down and prerolling all happen in the background.
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[in] uri  String that hold the location of the asset to play
+ *
+ *  \param[in]  cpblob - a pointer to a cpBlobStruct, see cgmi_Load.
+ *  \param[in] sessionSettings - a pointer to session settings JSON string
+ *  \post    On success the load completes in the background.  NOTIFY_LOAD_DONE is sent once the asset is
+ *           ready to play, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE if it fails or does not preroll within 10 seconds.
+ *           A cgmi_Unload, cgmi_Load or cgmi_LoadAsync issued before then cancels the pending load.
+ *
+ * \return  CGMI_ERROR_SUCCESS when the load has been started
+ * \return  CGMI_ERROR_BAD_PARAM  when the uri is NULL.
+ * \return  CGMI_ERROR_OUT_OF_MEMORY  when an allocation of memory has failed.
+ * \return  CGMI_ERROR_NOT_IMPLEMENTED  when the pipeline can not be created because of a missing plugin.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_LoadAsync (void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings );
+
+/**
+ *  \brief \b cgmi_Preload
+ *
+ *  Speculatively build the pipeline for a uri that is expected to be loaded next (e.g. the
+ *  next channel) and start prerolling it with the decoders muted.  The preloaded pipeline is
+ *  held in a second slot of the session, the currently loaded asset is not affected.  A later
+ *  cgmi_Load of the same uri, with no cpblob and no session settings, swaps the preloaded pipeline
+ *  in instead of building and prerolling a new one.  Any other cgmi_Load, a new cgmi_Preload or
+ *  cgmi_DestroySession releases it.
+ *  Platforms that cannot run two decode pipelines at once will fail the preload, cgmi_Load then
+ *  falls back to building the pipeline itself.
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[in] uri  String that hold the location of the asset to preload.  NULL (or an empty string
+ *  over the D-Bus interface) releases any preloaded pipeline.
+ *
+ * \return  CGMI_ERROR_SUCCESS when the pipeline has been created and is prerolling
+ * \return  CGMI_ERROR_NOT_IMPLEMENTED  when the pipeline can not be created because of a missing plugin.
+ * \return  CGMI_ERROR_FAILED  when the pipeline could not start prerolling.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_Preload (void *pSession, const char *uri );
+
 /**
  *  \brief \b cgmi_Unload
  *
@@ -429,6 +570,26 @@ cgmi_Status cgmi_SetPosition (void *pSession,  float position);
  */
 cgmi_Status cgmi_GetPosition (void *pSession,  float *pPosition);
 
+/**
+ *  \brief \b cgmi_GetState
+ *
+ *  Returns the pipeline state as last reported on the session's bus.  This never waits for a
+ *  pending state change (e.g. the preroll after cgmi_LoadAsync) to complete.
+ *
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[out] pState  The current state of the pipeline.
+ *
+ *  \param[out] pPendingState  The state the pipeline is transitioning to, PIPELINE_STATE_NONE if none.
+ *                             May be NULL.
+ *
+ * \return  CGMI_ERROR_SUCCESS when the state is obtained and sent back.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_GetState (void *pSession, tcgmi_PipelineState *pState, tcgmi_PipelineState *pPendingState);
+
 /**
  *  \brief \b cgmi_GetDuration
  *
@@ -934,6 +1095,30 @@ cgmi_Status cgmi_GetPidInfo( void *pSession, int index, tcgmi_PidData *pPidData
  */
 cgmi_Status cgmi_SetPidInfo( void *pSession, int index, tcgmi_StreamType type, int enable );
 
+/**
+ *  \brief \b cgmi_SelectProgram
+ *
+ *  Switches to another program of a multi-program transport stream without
+ *  reloading the session.  The demux is re-pointed to the PIDs of the new
+ *  program and, when its PMT has been seen already, the stream, audio,
+ *  subtitle and closed caption info is updated right away.
+ *  NOTIFY_PSI_CHANGED with CGMI_PSI_CHANGED_SELECTED_PROGRAM set is sent
+ *  once the new program's PSI is in effect.
+ *
+ *  \param[in]  pSession       This is a handle to the active session.
+ *
+ *  \param[in]  programNumber  Program number of the program as listed in the PAT
+ *
+ *  \pre                       The Session must be open and NOTIFY_PSI_READY received.
+ *
+ *  \return                    CGMI_ERROR_SUCCESS when call succeeds.
+ *                             CGMI_ERROR_BAD_PARAM when the program is not in the PAT.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_SelectProgram( void *pSession, int programNumber );
+
 
 /**
  *  \brief \b cgmi_SetLogging
@@ -965,6 +1150,61 @@ cgmi_Status cgmi_SetLogging ( const char *gstDebugStr);
  */
 cgmi_Status cgmi_GetTsbSlide(void *pSession, unsigned long *pTsbSlide);
 
+/**
+ *  \brief \b cgmi_GetAvSyncStats
+ *
+ *   Returns the audio/video sync statistics gathered while the session plays at 1x.
+ *   Drift is sampled at the "MonitorIntervalMs" session setting rate (see cgmi_Load)
+ *   and a flush is issued when it stays out of bounds, not on a single extreme sample.
+ *
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[out] pStats  Drift histogram, current drift and drift slope
+ *
+ *  \return                  CGMI_ERROR_SUCCESS when call succeeds.
+ *  \return                  CGMI_ERROR_NOT_SUPPORTED when monitoring is disabled in this build.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_GetAvSyncStats(void *pSession, tcgmi_AvSyncStats *pStats);
+
+/**
+ *  \brief \b cgmi_GetDecoderStats
+ *
+ *   Returns the decoder error counters along with how much they grew over each of the
+ *   last CGMI_DECODER_STATS_HISTORY seconds the session was playing at 1x.
+ *
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[out] pStats  Current counters and their per-interval history
+ *
+ *  \return                  CGMI_ERROR_SUCCESS when call succeeds.
+ *  \return                  CGMI_ERROR_NOT_SUPPORTED when monitoring is disabled in this build.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_GetDecoderStats(void *pSession, tcgmi_DecoderStats *pStats);
+
+/**
+ *  \brief \b cgmi_GetEventQueueStats
+ *
+ *   Events are queued and the event callback passed to cgmi_CreateSession is called
+ *   from a CGMI thread, one event at a time and in order, never from a GStreamer
+ *   streaming thread.  This returns how far delivery is lagging behind.
+ *
+ *  \param[in] pSession  This is a handle to the active session.
+ *
+ *  \param[out] pStats  Queue depth and emit to callback latency since cgmi_CreateSession
+ *
+ *  \return                  CGMI_ERROR_SUCCESS when call succeeds.
+ *
+ *  \ingroup CGMI
+ *
+ */
+cgmi_Status cgmi_GetEventQueueStats(void *pSession, tcgmi_EventQueueStats *pStats);
+
 /**
  *  \brief \b cgmi_GetNumSubtitleLanguages
  *
@@ -31,6 +31,11 @@ extern "C"
 #endif
 #endif
 
+// Sessions and section filters are handed out as 32 bit handles (slot index
+// plus generation), not pointers, so they marshal the same on any architecture.
+#define tCgmiDbusHandle guint32
+#define DBUS_HANDLE_TYPE "u"
+
 
 #ifdef __cplusplus
 }
@@ -71,8 +71,8 @@
     if ( pSess == NULL || gPlayerEventCallbacks == NULL || \
         g_hash_table_lookup(gPlayerEventCallbacks, (gpointer)pSess) == NULL ) \
     { \
-        g_print("%s:%d - %s Error invalid sessionId %lu.\n", \
-                __FILE__, __LINE__, __FUNCTION__, (tCgmiDbusPointer)pSess); \
+        g_print("%s:%d - %s Error invalid sessionId %u.\n", \
+                __FILE__, __LINE__, __FUNCTION__, GPOINTER_TO_UINT(pSess)); \
         return CGMI_ERROR_BAD_PARAM; \
     }
 
@@ -132,7 +132,7 @@ static gboolean on_handle_notification (  OrgCiscoCgmi *proxy,
 {
     tcgmi_PlayerEventCallbackData *playerCb = NULL;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSess = 0;
+    tCgmiDbusHandle pSess = 0;
 
     g_print("Enter on_handle_notification sessionHandle = %lu, event = %d code = %" G_GINT64_MODIFIER "d \n",
             (tCgmiDbusPointer)sessionHandle, event, code);
@@ -154,7 +154,7 @@ static gboolean on_handle_notification (  OrgCiscoCgmi *proxy,
         {
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSess );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSess );
         g_variant_unref( sessVar );
 
         // Find callback for this session
@@ -163,10 +163,10 @@ static gboolean on_handle_notification (  OrgCiscoCgmi *proxy,
             g_print("Internal error:  Callback hash table not initialized.\n");
             break;
         }
-        playerCb = g_hash_table_lookup(gPlayerEventCallbacks, (gpointer)pSess);
+        playerCb = g_hash_table_lookup(gPlayerEventCallbacks, GUINT_TO_POINTER(pSess));
         if ( playerCb == NULL || playerCb->callback == NULL )
         {
-            g_print("Failed to find callback for sessionId (%lu) in hash table.\n",
+            g_print("Failed to find callback for sessionId (%u) in hash table.\n",
                     pSess );
 
             break;
@@ -174,7 +174,7 @@ static gboolean on_handle_notification (  OrgCiscoCgmi *proxy,
 
         // Execute callback
         playerCb->callback( playerCb->userParam,
-                            (void *)pSess,
+                            GUINT_TO_POINTER(pSess),
                             (tcgmi_Event)event,
                             (uint64_t)code );
 
@@ -198,7 +198,7 @@ static gboolean on_handle_section_buffer_notify (  OrgCiscoCgmi *proxy,
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariantIter *iter = NULL;
     GVariant *filterIdVar = NULL;
-    tCgmiDbusPointer pFilterId = 0;
+    tCgmiDbusHandle pFilterId = 0;
     int bufIdx = 0;
 
     //g_print("Enter on_handle_section_buffer_notify filterId = 0x%08lx...\n", (void *)filterId);
@@ -220,15 +220,15 @@ static gboolean on_handle_section_buffer_notify (  OrgCiscoCgmi *proxy,
             break;
         }
 
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &pFilterId );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &pFilterId );
         g_variant_unref( filterIdVar );
 
         // Find callbacks
-        filterCbs = g_hash_table_lookup( gSectionFilterCbs, (gpointer)pFilterId );
+        filterCbs = g_hash_table_lookup( gSectionFilterCbs, GUINT_TO_POINTER(pFilterId) );
         if( NULL == filterCbs || NULL == filterCbs->bufferCB || NULL == filterCbs->sectionCB )
         {
             //g_print("Failed to find callback(s) for pFilterId (0x%08lx) in hash table.\n",
-            //        (void *)pFilterId );
+            //        GUINT_TO_POINTER(pFilterId) );
             break;
         }
 
@@ -238,7 +238,7 @@ static gboolean on_handle_section_buffer_notify (  OrgCiscoCgmi *proxy,
         // Ask for a buffer from the app
         retStat = filterCbs->bufferCB( filterCbs->pUserData,
             filterCbs->pFilterPriv,
-            (void *)pFilterId,
+            GUINT_TO_POINTER(pFilterId),
             &retBuffer,
             &retBufferSize );
 
@@ -271,7 +271,7 @@ static gboolean on_handle_section_buffer_notify (  OrgCiscoCgmi *proxy,
         // Send buffer
         retStat = filterCbs->sectionCB( filterCbs->pUserData,
             filterCbs->pFilterPriv,
-            (void *)pFilterId,
+            GUINT_TO_POINTER(pFilterId),
             sectionStatus,
             retBuffer,
             sectionSize );
@@ -836,7 +836,7 @@ cgmi_Status cgmi_CreateSession ( cgmi_EventCallback eventCB,
 {
     cgmi_Status retStat = CGMI_ERROR_SUCCESS;
     GError *error = NULL;
-    tCgmiDbusPointer sessionId;
+    tCgmiDbusHandle sessionId;
     GVariant *sessVar = NULL, *dbusVar = NULL;
     tcgmi_PlayerEventCallbackData *eventCbData = NULL;
 
@@ -877,11 +877,11 @@ cgmi_Status cgmi_CreateSession ( cgmi_EventCallback eventCB,
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &sessionId );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &sessionId );
         g_variant_unref( sessVar );
         g_variant_unref( dbusVar );
 
-        *pSession = (void *)sessionId;
+        *pSession = GUINT_TO_POINTER(sessionId);
 
         eventCbData = g_malloc0(sizeof(tcgmi_PlayerEventCallbackData));
         if (eventCbData == NULL)
@@ -904,7 +904,7 @@ cgmi_Status cgmi_CreateSession ( cgmi_EventCallback eventCB,
             break;
         }
 
-        g_hash_table_insert( gPlayerEventCallbacks, (gpointer)sessionId,
+        g_hash_table_insert( gPlayerEventCallbacks, GUINT_TO_POINTER(sessionId),
                              (gpointer)eventCbData );
 
     }
@@ -932,7 +932,7 @@ cgmi_Status cgmi_DestroySession( void *pSession )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -970,7 +970,7 @@ cgmi_Status cgmi_DestroySession( void *pSession )
 
     if ( gPlayerEventCallbacks != NULL )
     {
-        g_hash_table_remove( gPlayerEventCallbacks, GINT_TO_POINTER((tCgmiDbusPointer)pSession) );
+        g_hash_table_remove( gPlayerEventCallbacks, pSession );
     }
 
     pthread_mutex_unlock(&gEventCallbackMutex);
@@ -1003,7 +1003,8 @@ cgmi_Status cgmi_canPlayType( const char *type, int *pbCanPlay )
     return retStat;
 }
 
-cgmi_Status cgmi_Load( void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+static cgmi_Status cgmi_load_common( void *pSession, const char *uri, cpBlobStruct * cpblob,
+                                     const char *sessionSettings, gboolean bAsync )
 {
    cgmi_Status     retStat = CGMI_ERROR_SUCCESS;
    GVariantBuilder *dataBuilder = NULL;
@@ -1025,7 +1026,7 @@ cgmi_Status cgmi_Load( void *pSession, const char *uri, cpBlobStruct * cpblob, c
    enforce_dbus_preconditions();
 
    do{
-      sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+      sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
       if( sessVar == NULL )
       {
          g_print("Failed to create new variant\n");
@@ -1064,15 +1065,30 @@ cgmi_Status cgmi_Load( void *pSession, const char *uri, cpBlobStruct * cpblob, c
 
       cpBlobStruct_Variant = g_variant_builder_end(dataBuilder);
 
-      org_cisco_cgmi_call_load_sync( gProxy,
-         dbusVar,
-         (const gchar *)uri,
-         cpBlobStruct_Variant,
-         cpBlobStruct_Variant_Size,
-         (sessionSettings != NULL)?sessionSettings:"",
-         (gint *)&retStat,
-         NULL,
-         &error );
+      if ( TRUE == bAsync )
+      {
+         org_cisco_cgmi_call_load_async_sync( gProxy,
+            dbusVar,
+            (const gchar *)uri,
+            cpBlobStruct_Variant,
+            cpBlobStruct_Variant_Size,
+            (sessionSettings != NULL)?sessionSettings:"",
+            (gint *)&retStat,
+            NULL,
+            &error );
+      }
+      else
+      {
+         org_cisco_cgmi_call_load_sync( gProxy,
+            dbusVar,
+            (const gchar *)uri,
+            cpBlobStruct_Variant,
+            cpBlobStruct_Variant_Size,
+            (sessionSettings != NULL)?sessionSettings:"",
+            (gint *)&retStat,
+            NULL,
+            &error );
+      }
 
    }while(0);
 
@@ -1090,6 +1106,70 @@ cgmi_Status cgmi_Load( void *pSession, const char *uri, cpBlobStruct * cpblob, c
    return retStat;
 }
 
+cgmi_Status cgmi_Load( void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+{
+   return cgmi_load_common( pSession, uri, cpblob, sessionSettings, FALSE );
+}
+
+cgmi_Status cgmi_LoadAsync( void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+{
+   return cgmi_load_common( pSession, uri, cpblob, sessionSettings, TRUE );
+}
+
+cgmi_Status cgmi_Preload( void *pSession, const char *uri )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *sessVar = NULL, *dbusVar = NULL;
+
+    // Preconditions
+    if( pSession == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        // NULL can't go over D-Bus, an empty uri releases the preload slot
+        org_cisco_cgmi_call_preload_sync( gProxy,
+                                          dbusVar,
+                                          (uri != NULL)?uri:"",
+                                          (gint *)&retStat,
+                                          NULL,
+                                          &error );
+
+    }while(0);
+
+    //Clean up
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    return retStat;
+}
+
 cgmi_Status cgmi_Unload( void *pSession )
 {
     cgmi_Status retStat = CGMI_ERROR_SUCCESS;
@@ -1107,7 +1187,7 @@ cgmi_Status cgmi_Unload( void *pSession )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1159,7 +1239,7 @@ cgmi_Status cgmi_Play( void *pSession, int autoPlay )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1212,7 +1292,7 @@ cgmi_Status cgmi_SetRate( void *pSession, float rate )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1265,7 +1345,7 @@ cgmi_Status cgmi_SetPosition( void *pSession, float position )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1319,7 +1399,7 @@ cgmi_Status cgmi_GetPosition( void *pSession, float *pPosition )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1357,6 +1437,68 @@ cgmi_Status cgmi_GetPosition( void *pSession, float *pPosition )
     return retStat;
 }
 
+cgmi_Status cgmi_GetState( void *pSession, tcgmi_PipelineState *pState, tcgmi_PipelineState *pPendingState )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    gint state = PIPELINE_STATE_NULL;
+    gint pendingState = PIPELINE_STATE_NONE;
+    GVariant *sessVar = NULL, *dbusVar = NULL;
+
+    // Preconditions
+    if( pSession == NULL || pState == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        org_cisco_cgmi_call_get_state_sync( gProxy,
+                                            dbusVar,
+                                            &state,
+                                            &pendingState,
+                                            (gint *)&retStat,
+                                            NULL,
+                                            &error );
+
+    }while(0);
+
+    //Clean up
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    *pState = (tcgmi_PipelineState)state;
+    if( pPendingState != NULL )
+    {
+        *pPendingState = (tcgmi_PipelineState)pendingState;
+    }
+
+    return retStat;
+}
+
 cgmi_Status cgmi_GetDuration( void *pSession,  float *pDuration,
                               cgmi_SessionType *type )
 {
@@ -1376,7 +1518,7 @@ cgmi_Status cgmi_GetDuration( void *pSession,  float *pDuration,
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1445,7 +1587,7 @@ cgmi_Status cgmi_GetRates (void *pSession,  float pRates[],  unsigned int *pNumR
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("CGMI_CLIENT: Failed to create new variant\n");
@@ -1516,7 +1658,7 @@ cgmi_Status cgmi_SetVideoRectangle( void *pSession, int srcx, int srcy, int srcw
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1576,7 +1718,7 @@ cgmi_Status cgmi_GetVideoResolution( void *pSession, int *srcw, int *srch )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1630,7 +1772,7 @@ cgmi_Status cgmi_GetVideoDecoderIndex( void *pSession, int *idx )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1683,7 +1825,7 @@ cgmi_Status cgmi_GetNumAudioLanguages( void *pSession, int *count )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1738,7 +1880,7 @@ cgmi_Status cgmi_GetAudioLangInfo( void *pSession, int index,
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1803,7 +1945,7 @@ cgmi_Status cgmi_SetAudioStream( void *pSession, int index )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1856,7 +1998,7 @@ cgmi_Status cgmi_SetDefaultAudioLang( void *pSession, const char *language )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1909,7 +2051,7 @@ cgmi_Status cgmi_GetNumClosedCaptionServices( void *pSession, int *count )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -1964,7 +2106,7 @@ cgmi_Status cgmi_GetClosedCaptionServiceInfo( void *pSession, int index,
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2021,7 +2163,7 @@ cgmi_Status cgmi_CreateSectionFilter( void *pSession, int pid, void *pFilterPriv
     tcgmi_PlayerEventCallbackData *cbData;
     GVariant *sessVar = NULL, *sessDbusVar = NULL;
     GVariant *filterIdVar = NULL, *filterDbusVar = NULL;
-    tCgmiDbusPointer filterIdPtr;
+    tCgmiDbusHandle filterIdPtr;
 
     // Preconditions
     if( pSession == NULL || pFilterId == NULL )
@@ -2034,7 +2176,7 @@ cgmi_Status cgmi_CreateSectionFilter( void *pSession, int pid, void *pFilterPriv
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2073,11 +2215,11 @@ cgmi_Status cgmi_CreateSectionFilter( void *pSession, int pid, void *pFilterPriv
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &filterIdPtr );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &filterIdPtr );
         g_variant_unref( filterIdVar );
         g_variant_unref( filterDbusVar );
 
-        *pFilterId = (void *)filterIdPtr;
+        *pFilterId = GUINT_TO_POINTER(filterIdPtr);
 
     }while(0);
 
@@ -2089,7 +2231,7 @@ cgmi_Status cgmi_CreateSectionFilter( void *pSession, int pid, void *pFilterPriv
     dbus_check_error(error);
 
     //TODO:  Remove debug
-    g_print("Created filter ID 0x%08lx\n", filterIdPtr);
+    g_print("Created filter ID 0x%08x\n", filterIdPtr);
 
     do
     {
@@ -2150,7 +2292,7 @@ cgmi_Status cgmi_DestroySectionFilter(void *pSession, void *pFilterId )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2168,7 +2310,7 @@ cgmi_Status cgmi_DestroySectionFilter(void *pSession, void *pFilterId )
         }
         dbusVar = g_variant_ref_sink(dbusVar);
 
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2205,7 +2347,7 @@ cgmi_Status cgmi_DestroySectionFilter(void *pSession, void *pFilterId )
     {
         // let the hash table free the tcgmi_SectionFilterCbData instance
         // TODO:  Is this casting required?
-        g_hash_table_remove( gSectionFilterCbs, GINT_TO_POINTER((tCgmiDbusPointer)pFilterId) );
+        g_hash_table_remove( gSectionFilterCbs, pFilterId );
     }
 
     dbus_check_error(error);
@@ -2260,7 +2402,7 @@ cgmi_Status cgmi_SetSectionFilter(void *pSession, void *pFilterId, tcgmi_FilterD
         }
 
         // Marshal id pointers
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2278,7 +2420,7 @@ cgmi_Status cgmi_SetSectionFilter(void *pSession, void *pFilterId, tcgmi_FilterD
         }
         sessDbusVar = g_variant_ref_sink(sessDbusVar);
 
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2369,7 +2511,7 @@ cgmi_Status cgmi_StartSectionFilter(void *pSession,
 
     do{
         // Marshal id pointers
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2387,7 +2529,7 @@ cgmi_Status cgmi_StartSectionFilter(void *pSession,
         }
         sessDbusVar = g_variant_ref_sink(sessDbusVar);
 
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2461,7 +2603,7 @@ cgmi_Status cgmi_StopSectionFilter(void *pSession, void *pFilterId )
 
     do{
         // Marshal id pointers
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2479,7 +2621,7 @@ cgmi_Status cgmi_StopSectionFilter(void *pSession, void *pFilterId )
         }
         sessDbusVar = g_variant_ref_sink(sessDbusVar);
 
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2537,7 +2679,7 @@ cgmi_Status _cgmi_startUserDataFilterHelper(void *pSession, userDataBufferCB buf
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2634,7 +2776,7 @@ cgmi_Status _cgmi_stopUserDataFilterHelper(void *pSession, userDataBufferCB buff
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2707,7 +2849,7 @@ cgmi_Status cgmi_GetNumPids( void *pSession, int *pCount )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2760,7 +2902,7 @@ cgmi_Status cgmi_GetPidInfo( void *pSession, int index, tcgmi_PidData *pPidData
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2815,7 +2957,7 @@ cgmi_Status cgmi_SetPidInfo( void *pSession, int index, tcgmi_StreamType type, i
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -2853,6 +2995,59 @@ cgmi_Status cgmi_SetPidInfo( void *pSession, int index, tcgmi_StreamType type, i
     return retStat;
 }
 
+cgmi_Status cgmi_SelectProgram( void *pSession, int programNumber )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *sessVar = NULL, *dbusVar = NULL;
+
+    // Preconditions
+    if( pSession == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        org_cisco_cgmi_call_select_program_sync( gProxy,
+                dbusVar,
+                programNumber,
+                (gint *)&retStat,
+                NULL,
+                &error );
+
+    }while(0);
+
+    //Clean up
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    return retStat;
+}
+
 cgmi_Status cgmi_SetLogging ( const char *gstDebugStr)
 {
     GError *error = NULL;
@@ -2969,6 +3164,61 @@ cgmi_Status cgmiDiags_ResetTimingMetrics (void)
     return retStat;
 }
 
+cgmi_Status cgmiDiags_GetStageDurations ( unsigned int sessionIndex, tCgmiDiags_stageDuration stages[], int *pCount )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *pOutBuf = NULL;
+    GVariantIter *iter = NULL;
+    unsigned char *pTemStagesBuf = (unsigned char *)stages;
+    unsigned int max_stages_buf_byte;
+
+    // Preconditions
+    if((pCount == NULL) || (NULL == stages))
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    if(0 == *pCount)
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    max_stages_buf_byte = sizeof(tCgmiDiags_stageDuration)*(*pCount);
+
+    enforce_dbus_preconditions();
+
+    org_cisco_cgmi_call_get_stage_durations_sync ( gProxy,
+                                                   sessionIndex,
+                                                   (gint)(*pCount),
+                                                   (gint *)pCount,
+                                                   &pOutBuf,
+                                                   (gint *)&retStat,
+                                                   NULL,
+                                                   &error);
+
+    dbus_check_error(error);
+
+    // Unmarshal stage buffer
+    g_variant_get( pOutBuf, "ay", &iter );
+    if( NULL == iter )
+    {
+        g_print("%s: Error - Failed to get iterator from gvariant\n", __FUNCTION__);
+    }
+    else
+    {
+        unsigned int bufIdx = 0;
+        while( bufIdx < max_stages_buf_byte && g_variant_iter_loop(iter, "y", &pTemStagesBuf[bufIdx]) )
+        {
+            bufIdx++;
+        }
+        g_variant_iter_free( iter );
+    }
+    g_variant_unref( pOutBuf );
+
+    return retStat;
+}
+
 cgmi_Status cgmi_GetTsbSlide( void *pSession, unsigned long *pTsbSlide )
 {
     cgmi_Status retStat = CGMI_ERROR_SUCCESS;
@@ -2987,7 +3237,7 @@ cgmi_Status cgmi_GetTsbSlide( void *pSession, unsigned long *pTsbSlide )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3025,6 +3275,243 @@ cgmi_Status cgmi_GetTsbSlide( void *pSession, unsigned long *pTsbSlide )
     return retStat;
 }
 
+cgmi_Status cgmi_GetAvSyncStats( void *pSession, tcgmi_AvSyncStats *pStats )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *sessVar = NULL, *dbusVar = NULL, *histVar = NULL;
+    GVariantIter *iter = NULL;
+    gint currentDriftMs = 0;
+    gdouble driftSlope = 0.0;
+    guint sampleIntervalMs = 0, numSamples = 0, numRecoveries = 0, count = 0;
+    gint ii = 0;
+
+    // Preconditions
+    if( pSession == NULL || pStats == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    memset( pStats, 0, sizeof(*pStats) );
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        org_cisco_cgmi_call_get_av_sync_stats_sync( gProxy,
+                                                    dbusVar,
+                                                    &currentDriftMs,
+                                                    &driftSlope,
+                                                    &sampleIntervalMs,
+                                                    &numSamples,
+                                                    &numRecoveries,
+                                                    &histVar,
+                                                    (gint *)&retStat,
+                                                    NULL,
+                                                    &error );
+
+        if( NULL != histVar )
+        {
+            g_variant_get( histVar, "au", &iter );
+            while( ii < CGMI_AVSYNC_HISTOGRAM_BINS && g_variant_iter_loop(iter, "u", &count) )
+            {
+                pStats->histogram[ii++] = count;
+            }
+            g_variant_iter_free( iter );
+        }
+
+    }while(0);
+
+    //Clean up
+    if( histVar != NULL ) { g_variant_unref(histVar); }
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    pStats->currentDriftMs = currentDriftMs;
+    pStats->driftSlope = (float)driftSlope;
+    pStats->sampleIntervalMs = sampleIntervalMs;
+    pStats->numSamples = numSamples;
+    pStats->numRecoveries = numRecoveries;
+
+    return retStat;
+}
+
+cgmi_Status cgmi_GetEventQueueStats( void *pSession, tcgmi_EventQueueStats *pStats )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *sessVar = NULL, *dbusVar = NULL;
+    guint currentDepth = 0, maxDepth = 0, avgLatencyUs = 0, maxLatencyUs = 0;
+    guint64 numDispatched = 0;
+
+    // Preconditions
+    if( pSession == NULL || pStats == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        org_cisco_cgmi_call_get_event_queue_stats_sync( gProxy,
+                                                        dbusVar,
+                                                        &currentDepth,
+                                                        &maxDepth,
+                                                        &numDispatched,
+                                                        &avgLatencyUs,
+                                                        &maxLatencyUs,
+                                                        (gint *)&retStat,
+                                                        NULL,
+                                                        &error );
+
+    }while(0);
+
+    //Clean up
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    pStats->currentDepth = currentDepth;
+    pStats->maxDepth = maxDepth;
+    pStats->numDispatched = numDispatched;
+    pStats->avgLatencyUs = avgLatencyUs;
+    pStats->maxLatencyUs = maxLatencyUs;
+
+    return retStat;
+}
+
+cgmi_Status cgmi_GetDecoderStats( void *pSession, tcgmi_DecoderStats *pStats )
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    GError *error = NULL;
+    GVariant *sessVar = NULL, *dbusVar = NULL, *histVar = NULL;
+    GVariantIter *iter = NULL;
+    guint videoPtsErrors = 0, videoDecodeErrors = 0, videoDecodeDrops = 0, audioPtsErrors = 0;
+    guint intervalMs = 0;
+    tcgmi_DecoderCounters *pEntry = NULL;
+
+    // Preconditions
+    if( pSession == NULL || pStats == NULL )
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    enforce_session_preconditions(pSession);
+
+    enforce_dbus_preconditions();
+
+    memset( pStats, 0, sizeof(*pStats) );
+
+    do{
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
+        if( sessVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        sessVar = g_variant_ref_sink(sessVar);
+
+        dbusVar = g_variant_new ( "v", sessVar );
+        if( dbusVar == NULL )
+        {
+            g_print("Failed to create new variant\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        dbusVar = g_variant_ref_sink(dbusVar);
+
+        org_cisco_cgmi_call_get_decoder_stats_sync( gProxy,
+                                                    dbusVar,
+                                                    &videoPtsErrors,
+                                                    &videoDecodeErrors,
+                                                    &videoDecodeDrops,
+                                                    &audioPtsErrors,
+                                                    &intervalMs,
+                                                    &histVar,
+                                                    (gint *)&retStat,
+                                                    NULL,
+                                                    &error );
+
+        if( NULL != histVar )
+        {
+            g_variant_get( histVar, "a(uuuu)", &iter );
+            while( pStats->numIntervals < CGMI_DECODER_STATS_HISTORY )
+            {
+                pEntry = &pStats->history[pStats->numIntervals];
+                if( !g_variant_iter_next(iter, "(uuuu)",
+                                         &pEntry->videoPtsErrors,
+                                         &pEntry->videoDecodeErrors,
+                                         &pEntry->videoDecodeDrops,
+                                         &pEntry->audioPtsErrors) )
+                {
+                    break;
+                }
+                pStats->numIntervals++;
+            }
+            g_variant_iter_free( iter );
+        }
+
+    }while(0);
+
+    //Clean up
+    if( histVar != NULL ) { g_variant_unref(histVar); }
+    if( dbusVar != NULL ) { g_variant_unref(dbusVar); }
+    if( sessVar != NULL ) { g_variant_unref(sessVar); }
+
+    dbus_check_error(error);
+
+    pStats->current.videoPtsErrors = videoPtsErrors;
+    pStats->current.videoDecodeErrors = videoDecodeErrors;
+    pStats->current.videoDecodeDrops = videoDecodeDrops;
+    pStats->current.audioPtsErrors = audioPtsErrors;
+    pStats->intervalMs = intervalMs;
+
+    return retStat;
+}
+
 cgmi_Status cgmi_GetNumSubtitleLanguages( void *pSession, int *count )
 {
     cgmi_Status retStat = CGMI_ERROR_SUCCESS;
@@ -3042,7 +3529,7 @@ cgmi_Status cgmi_GetNumSubtitleLanguages( void *pSession, int *count )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3097,7 +3584,7 @@ cgmi_Status cgmi_GetSubtitleInfo( void *pSession, int index, char *buf, int bufS
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3165,7 +3652,7 @@ cgmi_Status cgmi_SetDefaultSubtitleLang( void *pSession, const char *language )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3219,7 +3706,7 @@ cgmi_Status cgmi_GetStc( void *pSession, uint64_t *pStc )
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3266,7 +3753,7 @@ cgmi_Status cgmi_CreateFilter( void *pSession, int pid, void *pFilterPriv, tcgmi
     tcgmi_PlayerEventCallbackData *cbData;
     GVariant *sessVar = NULL, *sessDbusVar = NULL;
     GVariant *filterIdVar = NULL, *filterDbusVar = NULL;
-    tCgmiDbusPointer filterIdPtr;
+    tCgmiDbusHandle filterIdPtr;
 
     // Preconditions
     if( pSession == NULL || pFilterId == NULL )
@@ -3279,7 +3766,7 @@ cgmi_Status cgmi_CreateFilter( void *pSession, int pid, void *pFilterPriv, tcgmi
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3319,11 +3806,11 @@ cgmi_Status cgmi_CreateFilter( void *pSession, int pid, void *pFilterPriv, tcgmi
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &filterIdPtr );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &filterIdPtr );
         g_variant_unref( filterIdVar );
         g_variant_unref( filterDbusVar );
 
-        *pFilterId = (void *)filterIdPtr;
+        *pFilterId = GUINT_TO_POINTER(filterIdPtr);
 
     }while(0);
 
@@ -3334,7 +3821,7 @@ cgmi_Status cgmi_CreateFilter( void *pSession, int pid, void *pFilterPriv, tcgmi
     dbus_check_error(error);
 
     //TODO:  Remove debug
-    g_print("Created filter ID 0x%08lx\n", filterIdPtr);
+    g_print("Created filter ID 0x%08x\n", filterIdPtr);
 
     do
     {
@@ -3420,7 +3907,7 @@ cgmi_Status cgmi_SetPictureSetting( void *pSession, tcgmi_PictureCtrl pctl, int
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -3475,7 +3962,7 @@ cgmi_Status cgmi_GetPictureSetting( void *pSession, tcgmi_PictureCtrl pctl, int
     enforce_dbus_preconditions();
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
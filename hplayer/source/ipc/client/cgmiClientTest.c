@@ -661,7 +661,7 @@ static cgmi_Status startPlayback(const char *url, void **ppSessionId)
     g_print("Calling cgmi_CreateSession...\n");
     retStat = cgmi_CreateSession( cgmiCallback, NULL, &pSessionId );
     CHECK_ERROR_RETURN_STAT(retStat);
-    g_print("create session returned sessionId = (%lx)\n", (tCgmiDbusPointer)pSessionId);
+    g_print("create session returned sessionId = (%x)\n", GPOINTER_TO_UINT(pSessionId));
     *ppSessionId = pSessionId;
 
     g_print("Calling cgmi_Load...\n");
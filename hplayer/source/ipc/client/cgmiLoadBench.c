@@ -0,0 +1,336 @@
+/*
+    CGMI
+    Copyright (C) {2015}  {Cisco System}
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+
+    Contributing Authors: Matt Snoby, Kris Kersey, Zack Wine, Chris Foster,
+                          Tankut Akgul, Saravanakumar Periyaswamy
+
+*/
+
+/*
+ * Per-Load cost benchmark.
+ *
+ * "probe" times the platform probing cgmi_Load used to do on every call
+ * (g_strnfill'd description, brcmvideosink registry lookup, g_strlcat)
+ * against filling the uri into the launch template probed once at
+ * cgmi_Init, from one thread and from several at once.
+ *
+ * "load" loops cgmi_Load/cgmi_Unload on one or more sessions and reports
+ * what a Load costs end to end.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgmiPlayerApi.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#define LOAD_BENCH_VERSION       "1.0"
+#define DEFAULT_PROBE_ITERATIONS 10000
+#define DEFAULT_LOAD_ITERATIONS  20
+#define MAX_BENCH_THREADS        16
+#define BENCH_PIPELINE_SIZE      (MAX_URI_SIZE + 128)
+
+#define CHECK_ERROR(err) \
+    if( err != CGMI_ERROR_SUCCESS ) \
+    { \
+        g_print("CGMI_LOAD_BENCH %s:%d - %s :: Failed with %s \n", __FILE__, __LINE__, __FUNCTION__, cgmi_ErrorString(err) ); \
+    }
+
+typedef struct
+{
+    const char  *url;
+    int         iterations;
+    gboolean    bLegacy;
+    void        *pSessionId;
+    gint64      total;
+    gint64      min;
+    gint64      max;
+    int         count;
+}tBenchThread;
+
+static gchar gTemplatePrefix[32];
+static gchar gTemplateSuffix[64];
+
+////////////////////////////////////////////////////////////////////////////////
+// Statistics
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchRecord( tBenchThread *pThread, gint64 elapsed )
+{
+    if ( 0 == pThread->count || elapsed < pThread->min )
+        pThread->min = elapsed;
+    if ( elapsed > pThread->max )
+        pThread->max = elapsed;
+    pThread->total += elapsed;
+    pThread->count++;
+}
+
+static void benchReport( const char *name, tBenchThread *threads, int numThreads, gint64 wall )
+{
+    gint64 total = 0, min = G_MAXINT64, max = 0;
+    int count = 0;
+    int i;
+
+    for ( i = 0; i < numThreads; i++ )
+    {
+        if ( 0 == threads[i].count )
+            continue;
+        total += threads[i].total;
+        count += threads[i].count;
+        min = MIN( min, threads[i].min );
+        max = MAX( max, threads[i].max );
+    }
+
+    if ( 0 == count )
+    {
+        g_print("%-24s threads: %2d  no successful iterations\n", name, numThreads);
+        return;
+    }
+
+    g_print("%-24s threads: %2d  count: %6d  mean: %10.2f us  min: %8lld us  max: %8lld us  wall: %lld ms\n",
+            name, numThreads, count, (double)total / count, (long long)min, (long long)max,
+            (long long)(wall / 1000));
+}
+
+static void benchRun( const char *name, GThreadFunc func, tBenchThread *threads, int numThreads )
+{
+    GThread *handles[MAX_BENCH_THREADS];
+    gint64 start;
+    int i;
+
+    start = g_get_monotonic_time();
+    for ( i = 0; i < numThreads; i++ )
+        handles[i] = g_thread_new( name, func, &threads[i] );
+    for ( i = 0; i < numThreads; i++ )
+        g_thread_join( handles[i] );
+
+    benchReport( name, threads, numThreads, g_get_monotonic_time() - start );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Launch description, per Load (before) and from a template (after)
+////////////////////////////////////////////////////////////////////////////////
+
+static GstPlugin *benchFindSinkPlugin( void )
+{
+#if GST_CHECK_VERSION(1,0,0)
+    return gst_registry_find_plugin( gst_registry_get(), "brcmvideosink" );
+#else
+    return gst_registry_find_plugin( gst_registry_get_default(), "brcmvideosink" );
+#endif
+}
+
+static void benchInitTemplate( void )
+{
+    GstPlugin *plugin;
+
+#if GST_CHECK_VERSION(1,0,0)
+    g_strlcpy( gTemplatePrefix, "playbin uri=", sizeof(gTemplatePrefix) );
+#else
+    g_strlcpy( gTemplatePrefix, "playbin2 uri=", sizeof(gTemplatePrefix) );
+#endif
+
+    plugin = benchFindSinkPlugin();
+    if ( NULL != plugin )
+    {
+        g_strlcat( gTemplateSuffix, " flags= 0x63", sizeof(gTemplateSuffix) );
+        gst_object_unref( plugin );
+    }
+}
+
+static gpointer benchProbeThread( gpointer data )
+{
+    tBenchThread *pThread = (tBenchThread *)data;
+    gchar buffer[BENCH_PIPELINE_SIZE];
+    gchar *pPipeline;
+    GstPlugin *plugin;
+    gint64 start;
+    int i;
+
+    for ( i = 0; i < pThread->iterations; i++ )
+    {
+        start = g_get_monotonic_time();
+        if ( TRUE == pThread->bLegacy )
+        {
+            pPipeline = g_strnfill( BENCH_PIPELINE_SIZE, '\0' );
+            g_strlcpy( pPipeline, gTemplatePrefix, BENCH_PIPELINE_SIZE );
+            g_strlcat( pPipeline, pThread->url, BENCH_PIPELINE_SIZE );
+            plugin = benchFindSinkPlugin();
+            if ( NULL != plugin )
+            {
+                g_strlcat( pPipeline, " flags= 0x63", BENCH_PIPELINE_SIZE );
+                gst_object_unref( plugin );
+            }
+            g_free( pPipeline );
+        }
+        else
+        {
+            g_snprintf( buffer, sizeof(buffer), "%s%s%s", gTemplatePrefix, pThread->url, gTemplateSuffix );
+        }
+        benchRecord( pThread, g_get_monotonic_time() - start );
+    }
+
+    return NULL;
+}
+
+static int benchProbe( const char *url, int iterations, int numThreads )
+{
+    tBenchThread threads[MAX_BENCH_THREADS];
+    int i;
+
+    gst_init( NULL, NULL );
+    benchInitTemplate();
+
+    g_print("Launch template: %s<uri>%s\n", gTemplatePrefix, gTemplateSuffix);
+
+    memset( threads, 0, sizeof(threads) );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        threads[i].url = url;
+        threads[i].iterations = iterations;
+        threads[i].bLegacy = TRUE;
+    }
+    benchRun( "per-Load probe", benchProbeThread, threads, numThreads );
+
+    memset( threads, 0, sizeof(threads) );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        threads[i].url = url;
+        threads[i].iterations = iterations;
+        threads[i].bLegacy = FALSE;
+    }
+    benchRun( "launch template", benchProbeThread, threads, numThreads );
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Load/Unload loop
+////////////////////////////////////////////////////////////////////////////////
+
+static void cgmiCallback( void *pUserData, void *pSession, tcgmi_Event event, uint64_t code )
+{
+    if ( NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE == event || NOTIFY_STREAMING_NOT_OK == event )
+        g_print( "CGMI Player Event Recevied : %d   \n", event );
+}
+
+static gpointer benchLoadThread( gpointer data )
+{
+    tBenchThread *pThread = (tBenchThread *)data;
+    cgmi_Status retStat;
+    gint64 start, elapsed;
+    int i;
+
+    for ( i = 0; i < pThread->iterations; i++ )
+    {
+        start = g_get_monotonic_time();
+        retStat = cgmi_Load( pThread->pSessionId, pThread->url, NULL, NULL );
+        elapsed = g_get_monotonic_time() - start;
+        CHECK_ERROR(retStat);
+        if ( CGMI_ERROR_SUCCESS != retStat )
+            break;
+
+        benchRecord( pThread, elapsed );
+
+        retStat = cgmi_Unload( pThread->pSessionId );
+        CHECK_ERROR(retStat);
+    }
+
+    return NULL;
+}
+
+static int benchLoad( const char *url, int iterations, int numThreads )
+{
+    tBenchThread threads[MAX_BENCH_THREADS];
+    cgmi_Status retStat;
+    int i;
+
+    retStat = cgmi_Init();
+    CHECK_ERROR(retStat);
+    if ( CGMI_ERROR_SUCCESS != retStat )
+        return -1;
+
+    memset( threads, 0, sizeof(threads) );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        threads[i].url = url;
+        threads[i].iterations = iterations;
+        retStat = cgmi_CreateSession( cgmiCallback, NULL, &threads[i].pSessionId );
+        CHECK_ERROR(retStat);
+        if ( CGMI_ERROR_SUCCESS != retStat )
+        {
+            numThreads = i;
+            break;
+        }
+    }
+
+    if ( 0 < numThreads )
+        benchRun( "cgmi_Load", benchLoadThread, threads, numThreads );
+
+    for ( i = 0; i < numThreads; i++ )
+    {
+        retStat = cgmi_DestroySession( threads[i].pSessionId );
+        CHECK_ERROR(retStat);
+    }
+
+    retStat = cgmi_Term();
+    CHECK_ERROR(retStat);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = 0;
+    int numThreads = 1;
+
+    g_print("Starting load benchmark v%s...\n", LOAD_BENCH_VERSION);
+
+    if (argc < 3)
+    {
+        g_print("usage: %s probe <url> [iterations] [threads] | load <url> [iterations] [sessions]\n", argv[0]);
+        return -1;
+    }
+
+    if (argc > 3)
+        iterations = atoi(argv[3]);
+    if (argc > 4)
+        numThreads = CLAMP(atoi(argv[4]), 1, MAX_BENCH_THREADS);
+
+    if (strcmp(argv[1], "probe") == 0)
+    {
+        return benchProbe( argv[2], (iterations > 0) ? iterations : DEFAULT_PROBE_ITERATIONS, numThreads );
+    }
+    else if (strcmp(argv[1], "load") == 0)
+    {
+        return benchLoad( argv[2], (iterations > 0) ? iterations : DEFAULT_LOAD_ITERATIONS, numThreads );
+    }
+
+    g_print("Unknown benchmark %s\n", argv[1]);
+    return -1;
+}
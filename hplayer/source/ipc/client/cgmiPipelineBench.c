@@ -0,0 +1,200 @@
+/*
+    CGMI
+    Copyright (C) {2015}  {Cisco System}
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+
+    Contributing Authors: Matt Snoby, Kris Kersey, Zack Wine, Chris Foster,
+                          Tankut Akgul, Saravanakumar Periyaswamy
+
+*/
+
+/*
+ * Pipeline creation cost benchmark.  Builds and releases playbin the way
+ * cgmi_Load used to (textual description through gst_parse_launch_full
+ * with a GstParseContext) and the way it does now (gst_element_factory_create
+ * from a cached factory plus g_object_set of uri and flags), and reports
+ * the cost per pipeline of each.  Nothing is taken past the NULL state.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cgmiPlayerApi.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Macros
+////////////////////////////////////////////////////////////////////////////////
+
+#define PIPELINE_BENCH_VERSION   "1.0"
+#define DEFAULT_ITERATIONS       1000
+#define PLAYBIN_FLAGS            0x63
+#define BENCH_PIPELINE_SIZE      (MAX_URI_SIZE + 128)
+
+#if GST_CHECK_VERSION(1,0,0)
+#define PLAYBIN_ELEMENT          "playbin"
+#else
+#define PLAYBIN_ELEMENT          "playbin2"
+#endif
+
+typedef struct
+{
+    gint64      total;
+    gint64      min;
+    gint64      max;
+    int         count;
+}tBenchStats;
+
+////////////////////////////////////////////////////////////////////////////////
+// Statistics
+////////////////////////////////////////////////////////////////////////////////
+
+static void benchRecord( tBenchStats *pStats, gint64 elapsed )
+{
+    if ( 0 == pStats->count || elapsed < pStats->min )
+        pStats->min = elapsed;
+    if ( elapsed > pStats->max )
+        pStats->max = elapsed;
+    pStats->total += elapsed;
+    pStats->count++;
+}
+
+static void benchReport( const char *name, tBenchStats *pStats )
+{
+    if ( 0 == pStats->count )
+    {
+        g_print("%-28s no pipeline could be created\n", name);
+        return;
+    }
+
+    g_print("%-28s count: %6d  mean: %10.2f us  min: %8lld us  max: %8lld us\n",
+            name, pStats->count, (double)pStats->total / pStats->count,
+            (long long)pStats->min, (long long)pStats->max);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Creation paths
+////////////////////////////////////////////////////////////////////////////////
+
+static GstElement *benchParseLaunch( const char *url )
+{
+    GstParseContext *ctx;
+    GError *g_error_str = NULL;
+    GstElement *pipeline;
+    gchar **arr;
+    gchar *pPipeline;
+
+    pPipeline = g_strnfill( BENCH_PIPELINE_SIZE, '\0' );
+    g_snprintf( pPipeline, BENCH_PIPELINE_SIZE, "%s uri=%s flags= 0x%x", PLAYBIN_ELEMENT, url, PLAYBIN_FLAGS );
+
+    ctx = gst_parse_context_new();
+    pipeline = gst_parse_launch_full( pPipeline, ctx, GST_PARSE_FLAG_FATAL_ERRORS, &g_error_str );
+    if ( NULL == pipeline )
+    {
+        arr = gst_parse_context_get_missing_elements( ctx );
+        g_print("Missing these plugins:\n%s\n", (NULL != arr && NULL != arr[0]) ? arr[0] : "none");
+        g_strfreev( arr );
+    }
+
+    if ( NULL != g_error_str )
+        g_error_free( g_error_str );
+    gst_parse_context_free( ctx );
+    g_free( pPipeline );
+
+    return pipeline;
+}
+
+static GstElement *benchFactoryCreate( GstElementFactory *factory, const char *url )
+{
+    GstElement *pipeline;
+
+    pipeline = gst_element_factory_create( factory, NULL );
+    if ( NULL == pipeline )
+        return NULL;
+
+    g_object_set( G_OBJECT(pipeline), "uri", url, NULL );
+    g_object_set( G_OBJECT(pipeline), "flags", PLAYBIN_FLAGS, NULL );
+
+    return pipeline;
+}
+
+int main(int argc, char **argv)
+{
+    GstElementFactory *factory;
+    GstElement *pipeline;
+    tBenchStats parseStats, factoryStats;
+    const char *url;
+    int iterations = DEFAULT_ITERATIONS;
+    gint64 start;
+    int i;
+
+    g_print("Starting pipeline creation benchmark v%s...\n", PIPELINE_BENCH_VERSION);
+
+    if (argc < 2)
+    {
+        g_print("usage: %s <url> [iterations]\n", argv[0]);
+        return -1;
+    }
+
+    url = argv[1];
+    if (argc > 2 && atoi(argv[2]) > 0)
+        iterations = atoi(argv[2]);
+
+    gst_init( &argc, &argv );
+
+    factory = gst_element_factory_find( PLAYBIN_ELEMENT );
+    if ( NULL == factory )
+    {
+        g_print("No %s element factory\n", PLAYBIN_ELEMENT);
+        return -1;
+    }
+
+    memset( &parseStats, 0, sizeof(parseStats) );
+    memset( &factoryStats, 0, sizeof(factoryStats) );
+
+    // alternate the two so neither one gets a warmer cache
+    for ( i = 0; i < iterations; i++ )
+    {
+        start = g_get_monotonic_time();
+        pipeline = benchParseLaunch( url );
+        if ( NULL != pipeline )
+        {
+            gst_object_unref( pipeline );
+            benchRecord( &parseStats, g_get_monotonic_time() - start );
+        }
+
+        start = g_get_monotonic_time();
+        pipeline = benchFactoryCreate( factory, url );
+        if ( NULL != pipeline )
+        {
+            gst_object_unref( pipeline );
+            benchRecord( &factoryStats, g_get_monotonic_time() - start );
+        }
+    }
+
+    benchReport( "gst_parse_launch_full", &parseStats );
+    benchReport( "gst_element_factory_create", &factoryStats );
+
+    gst_object_unref( factory );
+
+    return 0;
+}
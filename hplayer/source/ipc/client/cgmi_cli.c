@@ -84,10 +84,33 @@ void sig_handler(int signum)
 }
 
 
+/*Name of a timing event*/
+static const char *timingEventName(tCgmiDiag_timingEvent event)
+{
+    switch(event)
+    {
+        case DIAG_TIMING_METRIC_UNLOAD: return "DIAG_TIMING_METRIC_UNLOAD";
+        case DIAG_TIMING_METRIC_LOAD: return "DIAG_TIMING_METRIC_LOAD";
+        case DIAG_TIMING_METRIC_PLAY: return "DIAG_TIMING_METRIC_PLAY";
+        case DIAG_TIMING_METRIC_PAT_PMT_ACQUIRED: return "DIAG_TIMING_METRIC_PAT_PMT_ACQUIRED";
+        case DIAG_TIMING_METRIC_PTS_DECODED: return "DIAG_TIMING_METRIC_PTS_DECODED";
+        case DIAG_TIMING_METRIC_DLNA_PROBE_START: return "DIAG_TIMING_METRIC_DLNA_PROBE_START";
+        case DIAG_TIMING_METRIC_DLNA_PROBE_END: return "DIAG_TIMING_METRIC_DLNA_PROBE_END";
+        case DIAG_TIMING_METRIC_PIPELINE_CREATED: return "DIAG_TIMING_METRIC_PIPELINE_CREATED";
+        case DIAG_TIMING_METRIC_SOURCE_CREATED: return "DIAG_TIMING_METRIC_SOURCE_CREATED";
+        case DIAG_TIMING_METRIC_DEMUX_ADDED: return "DIAG_TIMING_METRIC_DEMUX_ADDED";
+        case DIAG_TIMING_METRIC_PAUSED: return "DIAG_TIMING_METRIC_PAUSED";
+        case DIAG_TIMING_METRIC_FIRST_PTS_RECEIVED: return "DIAG_TIMING_METRIC_FIRST_PTS_RECEIVED";
+        case DIAG_TIMING_METRIC_DECODER_UNMUTED: return "DIAG_TIMING_METRIC_DECODER_UNMUTED";
+        default: return NULL;
+    }
+}
+
 /*Dumping timing entry*/
 static void dumpTimingEntry(void)
 {
     int maxCount, i, numEntry;
+    const char *name;
     tCgmiDiags_timingMetric *pMetricsBuf = NULL;
 
     if(CGMI_ERROR_SUCCESS == cgmiDiags_GetTimingMetricsMaxCount(&maxCount))
@@ -102,31 +125,14 @@ static void dumpTimingEntry(void)
         {
             for(i=0;(i < maxCount) && (i < numEntry);i++)
             {
-                switch(pMetricsBuf[i].timingEvent)
+                name = timingEventName(pMetricsBuf[i].timingEvent);
+                if(NULL != name)
                 {
-                    case DIAG_TIMING_METRIC_UNLOAD:
-                    {
-                        printf("event = DIAG_TIMING_METRIC_UNLOAD; index = %d; time = %llu; uri = %s\n", pMetricsBuf[i].sessionIndex, pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
-                    }
-                    break;
-                    case DIAG_TIMING_METRIC_LOAD:
-                    {
-                        printf("event = DIAG_TIMING_METRIC_LOAD; index = %d; time = %llu; uri = %s\n", pMetricsBuf[i].sessionIndex, pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
-                    }
-                    break;
-                    case DIAG_TIMING_METRIC_PLAY:
-                    {
-                        printf("event = DIAG_TIMING_METRIC_PLAY; index = %d; time = %llu; uri = %s\n", pMetricsBuf[i].sessionIndex, pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
-                    }
-                    break;
-                    case DIAG_TIMING_METRIC_PTS_DECODED:
-                    {
-                        printf("event = DIAG_TIMING_METRIC_PTS_DECODED; index = %d; time = %llu; uri = %s\n", pMetricsBuf[i].sessionIndex, pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
-                    }
-                    break;
-                    default:
-                        printf("Unknown entry!\n");
-                    break;
+                    printf("event = %s; index = %d; time = %llu; uri = %s\n", name, pMetricsBuf[i].sessionIndex, pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
+                }
+                else
+                {
+                    printf("Unknown entry!\n");
                 }
             }
         }
@@ -134,49 +140,58 @@ static void dumpTimingEntry(void)
     }
 }
 
-/*Dumping timing entry*/
+/*Dumping channel change time and its per stage breakdown*/
 static void dumpChannelChangeTime(void)
 {
-    int maxCount, i, numEntry;
+    int maxCount, i, j, numEntry, numStages;
+    const char *name;
     tCgmiDiags_timingMetric *pMetricsBuf = NULL;
-
-    cgmiDiags_GetTimingMetricsMaxCount(&maxCount);
+    tCgmiDiags_stageDuration *pStagesBuf = NULL;
 
     if(CGMI_ERROR_SUCCESS == cgmiDiags_GetTimingMetricsMaxCount(&maxCount))
     {
         pMetricsBuf = (tCgmiDiags_timingMetric *)malloc(sizeof(tCgmiDiags_timingMetric)*maxCount);
+        pStagesBuf = (tCgmiDiags_stageDuration *)malloc(sizeof(tCgmiDiags_stageDuration)*maxCount);
     }
 
-    if(NULL != pMetricsBuf)
+    if((NULL != pMetricsBuf) && (NULL != pStagesBuf))
     {
         numEntry = maxCount;
         if(CGMI_ERROR_SUCCESS == cgmiDiags_GetTimingMetrics (pMetricsBuf, &numEntry))
         {
             for(i=0;(i < maxCount) && (i < numEntry);i++)
             {
-                switch(pMetricsBuf[i].timingEvent)
+                if(DIAG_TIMING_METRIC_LOAD != pMetricsBuf[i].timingEvent)
+                {
+                    continue;
+                }
+
+                /* durations are worked out by cgmi-diags */
+                numStages = maxCount;
+                if(CGMI_ERROR_SUCCESS != cgmiDiags_GetStageDurations(pMetricsBuf[i].sessionIndex, pStagesBuf, &numStages))
                 {
-                    int j;
+                    continue;
+                }
 
-                    case DIAG_TIMING_METRIC_LOAD:
+                for(j=0;j < numStages;j++)
+                {
+                    if(DIAG_TIMING_METRIC_PTS_DECODED == pStagesBuf[j].timingEvent)
                     {
-                        for(j=i+1;(j < maxCount) && (j < numEntry);j++)
-                        {
-                            if((DIAG_TIMING_METRIC_PTS_DECODED == pMetricsBuf[j].timingEvent) && (pMetricsBuf[i].sessionIndex == pMetricsBuf[j].sessionIndex))
-                            {
-                                printf("Channel change time for index = %d is %llu ms with uri = %s\n", pMetricsBuf[i].sessionIndex, pMetricsBuf[j].markTime - pMetricsBuf[i].markTime, pMetricsBuf[i].sessionUri);
-                            }
-                        }
+                        printf("Channel change time for index = %d is %llu ms with uri = %s\n", pMetricsBuf[i].sessionIndex, pStagesBuf[j].sinceLoad, pMetricsBuf[i].sessionUri);
                     }
-                    break;
-                    default:
-                        //nop
-                    break;
+                }
+
+                for(j=0;j < numStages;j++)
+                {
+                    name = timingEventName(pStagesBuf[j].timingEvent);
+                    printf("    %-40s +%6llu ms (%6llu ms since load)\n", (NULL != name) ? name : "Unknown entry!", pStagesBuf[j].duration, pStagesBuf[j].sinceLoad);
                 }
             }
         }
-        free(pMetricsBuf);
     }
+
+    free(pMetricsBuf);
+    free(pStagesBuf);
 }
 
 /*update current playing url*/
@@ -689,7 +704,9 @@ static void cgmiCallback( void *pUserData, void *pSession, tcgmi_Event event, ui
             printf("NOTIFY_CHANGED_RATE: %d", (gint) code);
             break;
         case NOTIFY_DECODE_ERROR:
-            printf("NOTIFY_DECODE_ERROR");
+            printf("NOTIFY_DECODE_ERROR (recovered %s)",
+                   (code == CGMI_DECODE_BRANCH_VIDEO) ? "video" :
+                   (code == CGMI_DECODE_BRANCH_AUDIO) ? "audio" : "audio and video");
             break;
         case NOTIFY_LOAD_DONE:
             {
@@ -714,6 +731,15 @@ static void cgmiCallback( void *pUserData, void *pSession, tcgmi_Event event, ui
         case NOTIFY_MEDIAPLAYER_UNKNOWN:
             printf("NOTIFY_MEDIAPLAYER_UNKNOWN");
             break;
+        case NOTIFY_PSI_CHANGED:
+            printf("NOTIFY_PSI_CHANGED:%s%s%s%s%s%s",
+                   (code & CGMI_PSI_CHANGED_PROGRAMS) ? " programs" : "",
+                   (code & CGMI_PSI_CHANGED_STREAMS) ? " streams" : "",
+                   (code & CGMI_PSI_CHANGED_AUDIO) ? " audio" : "",
+                   (code & CGMI_PSI_CHANGED_SUBTITLE) ? " subtitle" : "",
+                   (code & CGMI_PSI_CHANGED_CLOSED_CAPTION) ? " cc" : "",
+                   (code & CGMI_PSI_CHANGED_SELECTED_PROGRAM) ? " program-selected" : "");
+            break;
 
         default:
             printf("UNKNOWN");
@@ -732,6 +758,8 @@ void help(void)
            "\tplay <url> [autoplay]  Or play <url> <autoplay> <drmType> <cpBlob>\n"
            "\tresume <url> <position (seconds) (float)> [autoplay] Or resume  <url> <position (seconds) (float)> <autoplay> <drmType> <cpBlob>\n"
            "\tstop (or unload)\n"
+           "\tasyncload <url>  (NOTIFY_LOAD_DONE signals completion)\n"
+           "\tpreload [url]  (no url releases the preloaded pipeline)\n"
            "\n"
            "\taudioplay <url>\n"
            "\taudiostop\n"
@@ -740,6 +768,7 @@ void help(void)
            "\tsetrate <rate (float)>\n"
            "\n"
            "\tgetposition\n"
+           "\tgetstate\n"
            "\tsetposition <position (seconds) (float)>\n"
            "\n"
            "\tgetduration\n"
@@ -762,6 +791,7 @@ void help(void)
            "\n"
            "\tgetpidinfo\n"
            "\tsetpid <index> <A/V type (0:audio, 1:video)> <0:disable, 1:enable>\n"
+           "\tselectprogram <program number>\n"
            "\n"
            "\tsetlogging <GST_DEBUG format>\n"
            "\n"
@@ -776,6 +806,9 @@ void help(void)
            "\tresettimingentry\n"
            "\n"
            "\tgettsbslide\n"
+           "\tgetavsyncstats\n"
+           "\tgetdecoderstats\n"
+           "\tgeteventqueuestats\n"
            "\n"
            "\tgetpicturesetting <setting>\n"
            "\tsetpicturesetting <setting> <value>\n"
@@ -1357,6 +1390,22 @@ int main(int argc, char **argv)
                 printf( "Position: %f\n", Position );
             }
         }
+        /* getstate */
+        else if (strncmp(command, "getstate", 8) == 0)
+        {
+            static const char *stateNames[] = { "NONE", "NULL", "READY", "PAUSED", "PLAYING" };
+            tcgmi_PipelineState state, pendingState;
+
+            retCode = cgmi_GetState(pSessionId, &state, &pendingState);
+            if (CGMI_ERROR_SUCCESS == retCode && state <= PIPELINE_STATE_PLAYING && pendingState <= PIPELINE_STATE_PLAYING)
+            {
+                printf( "State: %s (pending %s)\n", stateNames[state], stateNames[pendingState] );
+            }
+            else
+            {
+                printf("CGMI GetState Failed\n");
+            }
+        }
         /* setposition */
         else if (strncmp(command, "setposition", 11) == 0)
         {
@@ -1650,6 +1699,44 @@ int main(int argc, char **argv)
                 printf("Error returned %d\n", retCode);
             }
         }
+        /* load without waiting for preroll */
+        else if (strncmp(command, "asyncload", 9) == 0)
+        {
+            if ( strlen( command ) <= 10 )
+            {
+                printf( "\tasyncload <url>\n" );
+                continue;
+            }
+            strncpy( arg, command + 10, strlen(command) - 10 );
+            arg[strlen(command) - 10] = '\0';
+
+            updateCurrentPlaySrcUrl(arg);
+            retCode = cgmi_LoadAsync( pSessionId, arg, NULL, NULL );
+            if ( retCode != CGMI_ERROR_SUCCESS )
+            {
+                printf("Error returned %d\n", retCode);
+            }
+        }
+        /* preload the predicted next url */
+        else if (strncmp(command, "preload", 7) == 0)
+        {
+            if ( strlen( command ) <= 8 )
+            {
+                /* no url releases the preloaded pipeline */
+                retCode = cgmi_Preload( pSessionId, NULL );
+            }
+            else
+            {
+                strncpy( arg, command + 8, strlen(command) - 8 );
+                arg[strlen(command) - 8] = '\0';
+
+                retCode = cgmi_Preload( pSessionId, arg );
+            }
+            if ( retCode != CGMI_ERROR_SUCCESS )
+            {
+                printf("Error returned %d\n", retCode);
+            }
+        }
         /* get closed caption services available */
         else if (strncmp(command, "getccinfo", 9) == 0)
         {
@@ -1816,6 +1903,30 @@ int main(int argc, char **argv)
                 printf("Error returned %d\n", retCode);
             }
         }
+        /* switch to another program of the multiplex */
+        else if (strncmp(command, "selectprogram", 13) == 0)
+        {
+            gint program;
+            if ( strlen( command ) <= 14 )
+            {
+                printf( "\tselectprogram <program number>\n" );
+                continue;
+            }
+            strncpy( arg, command + 14, strlen(command) - 14 );
+            arg[strlen(command) - 14] = '\0';
+
+            program = atoi( arg );
+
+            retCode = cgmi_SelectProgram( pSessionId, program );
+            if ( retCode == CGMI_ERROR_BAD_PARAM )
+            {
+                printf("Program %d is not in the PAT %d\n", program, retCode);
+            }
+            else if ( retCode != CGMI_ERROR_SUCCESS )
+            {
+                printf("Error returned %d\n", retCode);
+            }
+        }
         /* play EAS audio */
         else if (strncmp(command, "audioplay", 9) == 0)
         {
@@ -2211,6 +2322,77 @@ int main(int argc, char **argv)
                printf("CGMI GetTsbSlide Failed\n");
             }
         }
+        else if (strncmp(command, "getavsyncstats", 14) == 0)
+        {
+            tcgmi_AvSyncStats avSync;
+            static const char *binNames[CGMI_AVSYNC_HISTOGRAM_BINS] = {
+               "< -1000", "-1000..-200", "-200..-100", "-100..-40", "-40..40",
+               "40..100", "100..200", "200..1000", "> 1000" };
+            int ii;
+
+            retCode = cgmi_GetAvSyncStats(pSessionId, &avSync);
+            if (CGMI_ERROR_SUCCESS == retCode)
+            {
+                printf( "A/V drift: %d ms, slope %.2f ms/s, %u samples every %u ms, %u recoveries\n",
+                        avSync.currentDriftMs, avSync.driftSlope, avSync.numSamples,
+                        avSync.sampleIntervalMs, avSync.numRecoveries );
+                for (ii = 0; ii < CGMI_AVSYNC_HISTOGRAM_BINS; ii++)
+                {
+                    printf( "\t%12s ms: %u\n", binNames[ii], avSync.histogram[ii] );
+                }
+            }
+            else
+            {
+               printf("CGMI GetAvSyncStats Failed\n");
+            }
+        }
+        else if (strncmp(command, "geteventqueuestats", 18) == 0)
+        {
+            tcgmi_EventQueueStats eventStats;
+
+            retCode = cgmi_GetEventQueueStats(pSessionId, &eventStats);
+            if (CGMI_ERROR_SUCCESS == retCode)
+            {
+                printf( "Events: %u queued (max %u), %llu delivered, latency avg %u us max %u us\n",
+                        eventStats.currentDepth, eventStats.maxDepth,
+                        (unsigned long long)eventStats.numDispatched,
+                        eventStats.avgLatencyUs, eventStats.maxLatencyUs );
+            }
+            else
+            {
+               printf("CGMI GetEventQueueStats Failed\n");
+            }
+        }
+        else if (strncmp(command, "getdecoderstats", 15) == 0)
+        {
+            static tcgmi_DecoderStats decStats;
+            unsigned int ii;
+
+            retCode = cgmi_GetDecoderStats(pSessionId, &decStats);
+            if (CGMI_ERROR_SUCCESS == retCode)
+            {
+                printf( "Video PTS errors: %u, video decode errors: %u, video drops: %u, audio PTS errors: %u\n",
+                        decStats.current.videoPtsErrors, decStats.current.videoDecodeErrors,
+                        decStats.current.videoDecodeDrops, decStats.current.audioPtsErrors );
+                printf( "Last %u intervals of %u ms, oldest first (vpts/vdec/vdrop/apts), error free ones skipped:\n",
+                        decStats.numIntervals, decStats.intervalMs );
+                for (ii = 0; ii < decStats.numIntervals; ii++)
+                {
+                    if ( decStats.history[ii].videoPtsErrors || decStats.history[ii].videoDecodeErrors ||
+                         decStats.history[ii].videoDecodeDrops || decStats.history[ii].audioPtsErrors )
+                    {
+                        printf( "\t-%4u s: %u/%u/%u/%u\n",
+                                (decStats.numIntervals - ii) * decStats.intervalMs / 1000,
+                                decStats.history[ii].videoPtsErrors, decStats.history[ii].videoDecodeErrors,
+                                decStats.history[ii].videoDecodeDrops, decStats.history[ii].audioPtsErrors );
+                    }
+                }
+            }
+            else
+            {
+               printf("CGMI GetDecoderStats Failed\n");
+            }
+        }
         /* get picture settings */
         else if (strncmp(command, "getpicturesetting", 17) == 0)
         {
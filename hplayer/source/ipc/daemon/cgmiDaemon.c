@@ -325,7 +325,7 @@ static void cgmiEventCallback( void *pUserData, void *pSession, tcgmi_Event even
 
     do{
         // Marshal filter id pointer
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSession );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSession) );
         if( sessVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -353,8 +353,8 @@ static void cgmiEventCallback( void *pUserData, void *pSession, tcgmi_Event even
     if( sessDbusVar != NULL ) { g_variant_unref(sessDbusVar); }
     if( sessVar != NULL ) { g_variant_unref(sessVar); }
 
-    CGMID_INFO("cgmiEventCallback -- pSession: %lu, event%d \n",
-            (tCgmiDbusPointer)pSession, event);
+    CGMID_INFO("cgmiEventCallback -- pSession: %u, event%d \n",
+            GPOINTER_TO_UINT(pSession), event);
 }
 
 static cgmi_Status cgmiQueryBufferCallback(
@@ -432,7 +432,7 @@ static cgmi_Status cgmiSectionBufferCallback(
         sectionArray = g_variant_builder_end( sectionBuilder );
 
         // Marshal filter id pointer
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             g_print("Failed to create new variant\n");
@@ -654,7 +654,7 @@ on_handle_cgmi_create_session (
     retStat = cgmi_CreateSession( cgmiEventCallback, (void *)object, &pSessionId );
 
     do{
-        sessVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pSessionId );
+        sessVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pSessionId) );
         if( sessVar == NULL )
         {
             CGMID_ERROR("Failed to create new variant\n");
@@ -693,7 +693,7 @@ on_handle_cgmi_destroy_session (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession = 0;
+    tCgmiDbusHandle pSession = 0;
 
     CGMID_ENTER();
 
@@ -705,10 +705,10 @@ on_handle_cgmi_destroy_session (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_DestroySession( (void *)pSession );
+        retStat = cgmi_DestroySession( GUINT_TO_POINTER(pSession) );
 
     }while(0);
 
@@ -740,16 +740,15 @@ on_handle_cgmi_can_play_type (
     return TRUE;
 }
 
-static gboolean
-on_handle_cgmi_load (
-                     OrgCiscoCgmi *object,
-                     GDBusMethodInvocation *invocation,
-                     GVariant *arg_sessionId,
-                     const gchar *uri,
-                     GVariant *arg_cpBlobStruct,
-                     guint64 arg_cpBlobStructSize,
-                     const gchar *sessionSettings
-                     )
+static cgmi_Status
+cgmid_load_common (
+                   GVariant *arg_sessionId,
+                   const gchar *uri,
+                   GVariant *arg_cpBlobStruct,
+                   guint64 arg_cpBlobStructSize,
+                   const gchar *sessionSettings,
+                   gboolean bAsync
+                   )
 {
    cgmi_Status      retStat = CGMI_ERROR_FAILED;
    gchar            *cpBlob = NULL;
@@ -757,12 +756,7 @@ on_handle_cgmi_load (
    gchar            byte;
    uint32_t         ii = 0;
    GVariant         *sessVar = NULL;
-   tCgmiDbusPointer pSession;
-   gchar            *audioLanguage;
-   gchar            *subtitleLanguage;
-   gboolean         subtitleEnable;
-
-   CGMID_ENTER();
+   tCgmiDbusHandle pSession;
 
    do{
       g_variant_get( arg_sessionId, "v", &sessVar );
@@ -772,7 +766,7 @@ on_handle_cgmi_load (
          break;
       }
 
-      g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+      g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
       g_variant_unref( sessVar );
       if (arg_cpBlobStructSize>0)
       {
@@ -799,23 +793,113 @@ on_handle_cgmi_load (
             break;
          }
       }
-      retStat = cgmi_Load( (void *)pSession, uri, (cpBlobStruct *)cpBlob, sessionSettings );
-      g_print("CALLED cgmi_Load");
+      if (TRUE == bAsync)
+      {
+         retStat = cgmi_LoadAsync( GUINT_TO_POINTER(pSession), uri, (cpBlobStruct *)cpBlob, sessionSettings );
+         g_print("CALLED cgmi_LoadAsync");
+      }
+      else
+      {
+         retStat = cgmi_Load( GUINT_TO_POINTER(pSession), uri, (cpBlobStruct *)cpBlob, sessionSettings );
+         g_print("CALLED cgmi_Load");
+      }
 
    }while(0);
 
-   org_cisco_cgmi_complete_load (object,
-      invocation,
-      retStat);
-
    if (NULL != cpBlob)
    {
       g_free(cpBlob);
    }
 
+   return retStat;
+}
+
+static gboolean
+on_handle_cgmi_load (
+                     OrgCiscoCgmi *object,
+                     GDBusMethodInvocation *invocation,
+                     GVariant *arg_sessionId,
+                     const gchar *uri,
+                     GVariant *arg_cpBlobStruct,
+                     guint64 arg_cpBlobStructSize,
+                     const gchar *sessionSettings
+                     )
+{
+   cgmi_Status      retStat;
+
+   CGMID_ENTER();
+
+   retStat = cgmid_load_common( arg_sessionId, uri, arg_cpBlobStruct,
+                                arg_cpBlobStructSize, sessionSettings, FALSE );
+
+   org_cisco_cgmi_complete_load (object,
+      invocation,
+      retStat);
+
    return TRUE;
 }
 
+static gboolean
+on_handle_cgmi_load_async (
+                     OrgCiscoCgmi *object,
+                     GDBusMethodInvocation *invocation,
+                     GVariant *arg_sessionId,
+                     const gchar *uri,
+                     GVariant *arg_cpBlobStruct,
+                     guint64 arg_cpBlobStructSize,
+                     const gchar *sessionSettings
+                     )
+{
+   cgmi_Status      retStat;
+
+   CGMID_ENTER();
+
+   retStat = cgmid_load_common( arg_sessionId, uri, arg_cpBlobStruct,
+                                arg_cpBlobStructSize, sessionSettings, TRUE );
+
+   org_cisco_cgmi_complete_load_async (object,
+      invocation,
+      retStat);
+
+   return TRUE;
+}
+
+static gboolean
+on_handle_cgmi_preload (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId,
+    const gchar *uri )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    GVariant *sessVar = NULL;
+    tCgmiDbusHandle pSession;
+
+    CGMID_ENTER();
+
+    do{
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        // An empty uri releases the preload slot
+        retStat = cgmi_Preload( GUINT_TO_POINTER(pSession), (uri[0] != '\0')?uri:NULL );
+
+    }while(0);
+
+    org_cisco_cgmi_complete_preload (object,
+                                     invocation,
+                                     retStat);
+
+    return TRUE;
+}
+
 static gboolean
 on_handle_cgmi_unload (
     OrgCiscoCgmi *object,
@@ -824,7 +908,7 @@ on_handle_cgmi_unload (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -836,10 +920,10 @@ on_handle_cgmi_unload (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_Unload( (void *)pSession );
+        retStat = cgmi_Unload( GUINT_TO_POINTER(pSession) );
 
     }while(0);
 
@@ -860,7 +944,7 @@ on_handle_cgmi_play (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -872,10 +956,10 @@ on_handle_cgmi_play (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_Play( (void *)pSession, arg_autoPlay );
+        retStat = cgmi_Play( GUINT_TO_POINTER(pSession), arg_autoPlay );
 
     }while(0);
 
@@ -895,7 +979,7 @@ on_handle_cgmi_set_rate (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -907,10 +991,10 @@ on_handle_cgmi_set_rate (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetRate( (void *)pSession, arg_rate );
+        retStat = cgmi_SetRate( GUINT_TO_POINTER(pSession), arg_rate );
 
     }while(0);
 
@@ -930,7 +1014,7 @@ on_handle_cgmi_set_position (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -942,10 +1026,10 @@ on_handle_cgmi_set_position (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetPosition( (void *)pSession, arg_position );
+        retStat = cgmi_SetPosition( GUINT_TO_POINTER(pSession), arg_position );
 
     }while(0);
 
@@ -965,7 +1049,7 @@ on_handle_cgmi_get_position (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     float position = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     //CGMID_ENTER();
 
@@ -977,10 +1061,10 @@ on_handle_cgmi_get_position (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetPosition( (void *)pSession, &position );
+        retStat = cgmi_GetPosition( GUINT_TO_POINTER(pSession), &position );
 
     }while(0);
 
@@ -992,6 +1076,44 @@ on_handle_cgmi_get_position (
     return TRUE;
 }
 
+static gboolean
+on_handle_cgmi_get_state (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    tcgmi_PipelineState state = PIPELINE_STATE_NULL;
+    tcgmi_PipelineState pendingState = PIPELINE_STATE_NONE;
+    GVariant *sessVar = NULL;
+    tCgmiDbusHandle pSession;
+
+    //CGMID_ENTER();
+
+    do{
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        retStat = cgmi_GetState( GUINT_TO_POINTER(pSession), &state, &pendingState );
+
+    }while(0);
+
+    org_cisco_cgmi_complete_get_state (object,
+                                       invocation,
+                                       state,
+                                       pendingState,
+                                       retStat);
+
+    return TRUE;
+}
+
 static gboolean
 on_handle_cgmi_get_duration (
     OrgCiscoCgmi *object,
@@ -1002,7 +1124,7 @@ on_handle_cgmi_get_duration (
     float duration = 0;
     cgmi_SessionType type = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     //CGMID_ENTER();
 
@@ -1014,10 +1136,10 @@ on_handle_cgmi_get_duration (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetDuration( (void *)pSession, &duration, &type );
+        retStat = cgmi_GetDuration( GUINT_TO_POINTER(pSession), &duration, &type );
 
     }while(0);
 
@@ -1039,7 +1161,7 @@ on_handle_cgmi_get_rates (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
     float *pRates = NULL;
     gdouble rate = 0.0;
     GVariantBuilder *ratesBuilder = NULL;
@@ -1056,7 +1178,7 @@ on_handle_cgmi_get_rates (
           break;
        }
 
-       g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+       g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
        g_variant_unref( sessVar );
 
        pRates = (float *)malloc(sizeof(float) * numRates);
@@ -1067,7 +1189,7 @@ on_handle_cgmi_get_rates (
           break;
        }
 
-       retStat = cgmi_GetRates( (void *)pSession, pRates, &numRates );
+       retStat = cgmi_GetRates( GUINT_TO_POINTER(pSession), pRates, &numRates );
        //CGMID_INFO("numRates = %u\n", numRates);
 
        ratesBuilder = g_variant_builder_new( G_VARIANT_TYPE("ad") );
@@ -1121,7 +1243,7 @@ on_handle_cgmi_set_video_rectangle (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1133,10 +1255,10 @@ on_handle_cgmi_set_video_rectangle (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetVideoRectangle( (void *)pSession, srcx, srcy, srcw, srch, dstx, dsty, dstw, dsth );
+        retStat = cgmi_SetVideoRectangle( GUINT_TO_POINTER(pSession), srcx, srcy, srcw, srch, dstx, dsty, dstw, dsth );
 
     }while(0);
 
@@ -1156,7 +1278,7 @@ on_handle_cgmi_get_video_resolution (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint srcw = 0, srch = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1168,10 +1290,10 @@ on_handle_cgmi_get_video_resolution (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetVideoResolution( (void *)pSession, &srcw, &srch );
+        retStat = cgmi_GetVideoResolution( GUINT_TO_POINTER(pSession), &srcw, &srch );
 
     }while(0);
 
@@ -1193,7 +1315,7 @@ on_handle_cgmi_get_video_decoder_index (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint idx = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1205,10 +1327,10 @@ on_handle_cgmi_get_video_decoder_index (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetVideoDecoderIndex( (void *)pSession, &idx );
+        retStat = cgmi_GetVideoDecoderIndex( GUINT_TO_POINTER(pSession), &idx );
 
     }while(0);
 
@@ -1229,7 +1351,7 @@ on_handle_cgmi_get_num_audio_languages (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint count = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1241,10 +1363,10 @@ on_handle_cgmi_get_num_audio_languages (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetNumAudioLanguages( (void *)pSession, &count );
+        retStat = cgmi_GetNumAudioLanguages( GUINT_TO_POINTER(pSession), &count );
 
     }while(0);
 
@@ -1268,7 +1390,7 @@ on_handle_cgmi_get_audio_lang_info (
     char *buffer = NULL;
     char isEnabled;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1294,10 +1416,10 @@ on_handle_cgmi_get_audio_lang_info (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetAudioLangInfo( (void *)pSession, index, buffer, bufSize, &isEnabled );
+        retStat = cgmi_GetAudioLangInfo( GUINT_TO_POINTER(pSession), index, buffer, bufSize, &isEnabled );
 
     }while(0);
 
@@ -1322,7 +1444,7 @@ on_handle_cgmi_set_audio_stream (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1334,10 +1456,10 @@ on_handle_cgmi_set_audio_stream (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetAudioStream( (void *)pSession, index );
+        retStat = cgmi_SetAudioStream( GUINT_TO_POINTER(pSession), index );
 
     }while(0);
 
@@ -1357,7 +1479,7 @@ on_handle_cgmi_set_default_audio_lang (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1369,10 +1491,10 @@ on_handle_cgmi_set_default_audio_lang (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetDefaultAudioLang( (void *)pSession, language );
+        retStat = cgmi_SetDefaultAudioLang( GUINT_TO_POINTER(pSession), language );
 
     }while(0);
 
@@ -1392,7 +1514,7 @@ on_handle_cgmi_get_num_closed_caption_services (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint count = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1404,10 +1526,10 @@ on_handle_cgmi_get_num_closed_caption_services (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetNumClosedCaptionServices( (void *)pSession, &count );
+        retStat = cgmi_GetNumClosedCaptionServices( GUINT_TO_POINTER(pSession), &count );
 
     }while(0);
 
@@ -1432,7 +1554,7 @@ on_handle_cgmi_get_closed_caption_service_info (
     char isDigital;
     int serviceNum;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1457,10 +1579,10 @@ on_handle_cgmi_get_closed_caption_service_info (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetClosedCaptionServiceInfo( (void *)pSession, index, buffer, bufSize, &serviceNum, &isDigital );
+        retStat = cgmi_GetClosedCaptionServiceInfo( GUINT_TO_POINTER(pSession), index, buffer, bufSize, &serviceNum, &isDigital );
 
     }while(0);
 
@@ -1488,7 +1610,7 @@ on_handle_cgmi_create_section_filter (
     void *pFilterId;
     GVariant *sessVar = NULL;
     GVariant *filterIdVar = NULL, *dbusVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1499,17 +1621,17 @@ on_handle_cgmi_create_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
         // Provide a pointer to the sessionId as the private data.
-        retStat = cgmi_CreateSectionFilter( (void *)pSession,
+        retStat = cgmi_CreateSectionFilter( GUINT_TO_POINTER(pSession),
                                          arg_filterPid,
                                          (void *)object,
                                          &pFilterId );
 
         // Build GVariant to return filter ID pointer
-        filterIdVar = g_variant_new ( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+        filterIdVar = g_variant_new ( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
         if( filterIdVar == NULL )
         {
             CGMID_INFO("Failed to create new variant\n");
@@ -1555,7 +1677,7 @@ on_handle_cgmi_destroy_section_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL, *filterIdVar = NULL;
-    tCgmiDbusPointer pSession, pFilterId;
+    tCgmiDbusHandle pSession, pFilterId;
 
     CGMID_ENTER();
 
@@ -1566,7 +1688,7 @@ on_handle_cgmi_destroy_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
         g_variant_get( arg_filterId, "v", &filterIdVar );
@@ -1575,11 +1697,11 @@ on_handle_cgmi_destroy_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &pFilterId );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &pFilterId );
         g_variant_unref( filterIdVar );
 
-        retStat = cgmi_DestroySectionFilter( (void *)pSession,
-                                          (void *)pFilterId );
+        retStat = cgmi_DestroySectionFilter( GUINT_TO_POINTER(pSession),
+                                          GUINT_TO_POINTER(pFilterId) );
 
 
     }while(0);
@@ -1605,7 +1727,7 @@ on_handle_cgmi_set_section_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL, *filterIdVar = NULL;
-    tCgmiDbusPointer pSession, pFilterId;
+    tCgmiDbusHandle pSession, pFilterId;
     tcgmi_FilterData pFilter;
     GVariantIter *iter = NULL;
     guchar *filterValue = NULL;
@@ -1660,7 +1782,7 @@ on_handle_cgmi_set_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
         g_variant_get( arg_filterId, "v", &filterIdVar );
@@ -1669,11 +1791,11 @@ on_handle_cgmi_set_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &pFilterId );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &pFilterId );
         g_variant_unref( filterIdVar );
 
-        retStat = cgmi_SetSectionFilter( (void *)pSession,
-                                      (void *)pFilterId,
+        retStat = cgmi_SetSectionFilter( GUINT_TO_POINTER(pSession),
+                                      GUINT_TO_POINTER(pFilterId),
                                       &pFilter );
 
     }while(0);
@@ -1701,7 +1823,7 @@ on_handle_cgmi_start_section_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL, *filterIdVar = NULL;
-    tCgmiDbusPointer pSession, pFilterId;
+    tCgmiDbusHandle pSession, pFilterId;
 
     CGMID_ENTER();
 
@@ -1713,7 +1835,7 @@ on_handle_cgmi_start_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
         g_variant_get( arg_filterId, "v", &filterIdVar );
@@ -1722,11 +1844,11 @@ on_handle_cgmi_start_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &pFilterId );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &pFilterId );
         g_variant_unref( filterIdVar );
 
-        retStat = cgmi_StartSectionFilter( (void *)pSession,
-                                        (void *)pFilterId,
+        retStat = cgmi_StartSectionFilter( GUINT_TO_POINTER(pSession),
+                                        GUINT_TO_POINTER(pFilterId),
                                         timeout,
                                         oneShot,
                                         enableCRC,
@@ -1752,7 +1874,7 @@ on_handle_cgmi_stop_section_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL, *filterIdVar = NULL;
-    tCgmiDbusPointer pSession, pFilterId;
+    tCgmiDbusHandle pSession, pFilterId;
 
     CGMID_ENTER();
 
@@ -1764,7 +1886,7 @@ on_handle_cgmi_stop_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
         g_variant_get( arg_filterId, "v", &filterIdVar );
@@ -1773,11 +1895,11 @@ on_handle_cgmi_stop_section_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( filterIdVar, DBUS_POINTER_TYPE, &pFilterId );
+        g_variant_get( filterIdVar, DBUS_HANDLE_TYPE, &pFilterId );
         g_variant_unref( filterIdVar );
 
-        retStat = cgmi_StopSectionFilter( (void *)pSession,
-                                       (void *)pFilterId );
+        retStat = cgmi_StopSectionFilter( GUINT_TO_POINTER(pSession),
+                                       GUINT_TO_POINTER(pFilterId) );
 
     }while(0);
 
@@ -1796,7 +1918,7 @@ on_handle_cgmi_start_user_data_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
     tcgmi_FifoCallbackSink *callbackData;
 
     CGMID_ENTER();
@@ -1810,7 +1932,7 @@ on_handle_cgmi_start_user_data_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
 
@@ -1822,12 +1944,12 @@ on_handle_cgmi_start_user_data_filter (
             retStat = CGMI_ERROR_OUT_OF_MEMORY;
             break;
         }
-        g_hash_table_insert( gUserDataCallbackHash, (gpointer)pSession,
+        g_hash_table_insert( gUserDataCallbackHash, GUINT_TO_POINTER(pSession),
                              (gpointer)callbackData );
 
         // Create unique fifo name
         snprintf(callbackData->fifoName, CMGI_FIFO_NAME_MAX,
-            "/tmp/cgmiUserData-%016lx.fifo", pSession);
+            "/tmp/cgmiUserData-%08x.fifo", pSession);
 
         // Create thread to open fifo
         CGMID_INFO("Creating fifo\n");
@@ -1843,7 +1965,7 @@ on_handle_cgmi_start_user_data_filter (
         }
 
         CGMID_INFO("Calling lib cgmi_startUserDataFilter\n");
-        retStat = cgmi_startUserDataFilter( (void *)pSession,
+        retStat = cgmi_startUserDataFilter( GUINT_TO_POINTER(pSession),
                                             cgmiUserDataBufferCB,
                                             (void *)callbackData );
 
@@ -1865,7 +1987,7 @@ on_handle_cgmi_stop_user_data_filter (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
     tcgmi_FifoCallbackSink *callbackData;
 
     CGMID_ENTER();
@@ -1878,15 +2000,15 @@ on_handle_cgmi_stop_user_data_filter (
             retStat = CGMI_ERROR_FAILED;
             break;
         }
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_stopUserDataFilter( (void *)pSession,
+        retStat = cgmi_stopUserDataFilter( GUINT_TO_POINTER(pSession),
                                            (void *)cgmiUserDataBufferCB );
 
         // Look up the callbackData
         callbackData = (tcgmi_FifoCallbackSink *) g_hash_table_lookup(
-            gUserDataCallbackHash, (gpointer)pSession );
+            gUserDataCallbackHash, GUINT_TO_POINTER(pSession) );
 
         if (callbackData == NULL)
         {
@@ -1898,7 +2020,7 @@ on_handle_cgmi_stop_user_data_filter (
         retStat = closeFifo( callbackData );
 
         // Remove callbackData from hash... this will free callbackData
-        g_hash_table_remove( gUserDataCallbackHash, (gpointer)pSession );
+        g_hash_table_remove( gUserDataCallbackHash, GUINT_TO_POINTER(pSession) );
 
     }while(0);
 
@@ -1918,7 +2040,7 @@ on_handle_cgmi_get_num_pids (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint count = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -1930,10 +2052,10 @@ on_handle_cgmi_get_num_pids (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetNumPids( (void *)pSession, &count );
+        retStat = cgmi_GetNumPids( GUINT_TO_POINTER(pSession), &count );
 
     }while(0);
 
@@ -1954,7 +2076,7 @@ on_handle_cgmi_get_pid_info (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
     tcgmi_PidData pidData;
 
     CGMID_ENTER();
@@ -1967,10 +2089,10 @@ on_handle_cgmi_get_pid_info (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetPidInfo( (void *)pSession, index, &pidData );
+        retStat = cgmi_GetPidInfo( GUINT_TO_POINTER(pSession), index, &pidData );
 
     }while(0);
 
@@ -1994,7 +2116,7 @@ on_handle_cgmi_set_pid_info (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -2006,10 +2128,10 @@ on_handle_cgmi_set_pid_info (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetPidInfo( (void *)pSession, index, type, enable );
+        retStat = cgmi_SetPidInfo( GUINT_TO_POINTER(pSession), index, type, enable );
 
     }while(0);
 
@@ -2020,6 +2142,41 @@ on_handle_cgmi_set_pid_info (
     return TRUE;
 }
 
+static gboolean
+on_handle_cgmi_select_program (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId,
+    gint programNumber )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    GVariant *sessVar = NULL;
+    tCgmiDbusHandle pSession;
+
+    CGMID_ENTER();
+
+    do{
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        retStat = cgmi_SelectProgram( GUINT_TO_POINTER(pSession), programNumber );
+
+    }while(0);
+
+    org_cisco_cgmi_complete_select_program (object,
+            invocation,
+            retStat);
+
+    return TRUE;
+}
+
 static gboolean
 on_handle_cgmi_set_logging (
     OrgCiscoCgmi *object,
@@ -2125,6 +2282,68 @@ on_handle_cgmiDiags_reset_timing_metrics (
     return TRUE;
 }
 
+static gboolean
+on_handle_cgmiDiags_get_stage_durations(
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    guint arg_sessionIndex,
+    gint arg_bufSizeIn)
+{
+    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
+    gint count = arg_bufSizeIn;
+    GVariantBuilder *outBufBuilder = NULL;
+    GVariant *outBuf = NULL;
+    int idx = 0, inBufSize = 0, outBufSize = 0;
+    char *pInBuf = NULL;
+
+    CGMID_ENTER();
+
+    do{
+        inBufSize = sizeof(tCgmiDiags_stageDuration)*count;
+        pInBuf = g_malloc(inBufSize);
+
+        if(NULL == pInBuf)
+        {
+           g_print("Failed to create input buffer\n");
+           retStat = CGMI_ERROR_OUT_OF_MEMORY;
+           break;
+        }
+
+        retStat = cgmiDiags_GetStageDurations(arg_sessionIndex, (tCgmiDiags_stageDuration *)pInBuf, &count);
+
+        outBufSize = sizeof(tCgmiDiags_stageDuration)*count;
+
+        // Marshal gvariant buffer
+        outBufBuilder = g_variant_builder_new( G_VARIANT_TYPE("ay") );
+        if( outBufBuilder == NULL )
+        {
+            g_print("Failed to create new variant builder\n");
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        for( idx = 0; (idx < inBufSize) && (idx < outBufSize); idx++ )
+        {
+            g_variant_builder_add( outBufBuilder, "y", pInBuf[idx] );
+        }
+        outBuf = g_variant_builder_end( outBufBuilder );
+    }while(0);
+
+    // the reply needs a buffer even when we bailed out early
+    if( NULL == outBuf )
+    {
+        count = 0;
+        outBuf = g_variant_new_array( G_VARIANT_TYPE_BYTE, NULL, 0 );
+    }
+
+    org_cisco_cgmi_complete_get_stage_durations (object, invocation, count, outBuf, retStat);
+
+    //Clean up
+    if( outBufBuilder != NULL ) { g_variant_builder_unref(outBufBuilder); }
+    if( pInBuf != NULL ) { g_free(pInBuf); }
+
+    return TRUE;
+}
+
 static gboolean
 on_handle_cgmi_get_tsb_slide (
     OrgCiscoCgmi *object,
@@ -2134,7 +2353,7 @@ on_handle_cgmi_get_tsb_slide (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     unsigned long tsbSlide = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     //CGMID_ENTER();
 
@@ -2146,10 +2365,10 @@ on_handle_cgmi_get_tsb_slide (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetTsbSlide( (void *)pSession, &tsbSlide );
+        retStat = cgmi_GetTsbSlide( GUINT_TO_POINTER(pSession), &tsbSlide );
 
     }while(0);
 
@@ -2161,6 +2380,160 @@ on_handle_cgmi_get_tsb_slide (
     return TRUE;
 }
 
+static gboolean
+on_handle_cgmi_get_av_sync_stats (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    tcgmi_AvSyncStats stats;
+    GVariant *sessVar = NULL;
+    GVariantBuilder *histBuilder = NULL;
+    tCgmiDbusHandle pSession;
+    gint ii;
+
+    memset( &stats, 0, sizeof(stats) );
+
+    do{
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        retStat = cgmi_GetAvSyncStats( GUINT_TO_POINTER(pSession), &stats );
+
+    }while(0);
+
+    histBuilder = g_variant_builder_new( G_VARIANT_TYPE("au") );
+    for( ii = 0; ii < CGMI_AVSYNC_HISTOGRAM_BINS; ii++ )
+    {
+        g_variant_builder_add( histBuilder, "u", stats.histogram[ii] );
+    }
+
+    org_cisco_cgmi_complete_get_av_sync_stats ( object,
+                                                invocation,
+                                                stats.currentDriftMs,
+                                                stats.driftSlope,
+                                                stats.sampleIntervalMs,
+                                                stats.numSamples,
+                                                stats.numRecoveries,
+                                                g_variant_builder_end(histBuilder),
+                                                retStat );
+
+    g_variant_builder_unref( histBuilder );
+
+    return TRUE;
+}
+
+static gboolean
+on_handle_cgmi_get_event_queue_stats (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    tcgmi_EventQueueStats stats;
+    GVariant *sessVar = NULL;
+    tCgmiDbusHandle pSession;
+
+    memset( &stats, 0, sizeof(stats) );
+
+    do{
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        retStat = cgmi_GetEventQueueStats( GUINT_TO_POINTER(pSession), &stats );
+
+    }while(0);
+
+    org_cisco_cgmi_complete_get_event_queue_stats ( object,
+                                                    invocation,
+                                                    stats.currentDepth,
+                                                    stats.maxDepth,
+                                                    stats.numDispatched,
+                                                    stats.avgLatencyUs,
+                                                    stats.maxLatencyUs,
+                                                    retStat );
+
+    return TRUE;
+}
+
+static gboolean
+on_handle_cgmi_get_decoder_stats (
+    OrgCiscoCgmi *object,
+    GDBusMethodInvocation *invocation,
+    GVariant *arg_sessionId )
+{
+    cgmi_Status retStat = CGMI_ERROR_FAILED;
+    tcgmi_DecoderStats *pStats = NULL;
+    GVariant *sessVar = NULL;
+    GVariantBuilder *histBuilder = NULL;
+    tCgmiDbusHandle pSession;
+    guint ii;
+
+    // too big for the stack of a dbus handler
+    pStats = g_malloc0( sizeof(tcgmi_DecoderStats) );
+
+    do{
+        if( pStats == NULL )
+        {
+            retStat = CGMI_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+
+        g_variant_get( arg_sessionId, "v", &sessVar );
+        if( sessVar == NULL )
+        {
+            retStat = CGMI_ERROR_FAILED;
+            break;
+        }
+
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
+        g_variant_unref( sessVar );
+
+        retStat = cgmi_GetDecoderStats( GUINT_TO_POINTER(pSession), pStats );
+
+    }while(0);
+
+    histBuilder = g_variant_builder_new( G_VARIANT_TYPE("a(uuuu)") );
+    for( ii = 0; pStats != NULL && ii < pStats->numIntervals; ii++ )
+    {
+        g_variant_builder_add( histBuilder, "(uuuu)",
+                               pStats->history[ii].videoPtsErrors,
+                               pStats->history[ii].videoDecodeErrors,
+                               pStats->history[ii].videoDecodeDrops,
+                               pStats->history[ii].audioPtsErrors );
+    }
+
+    org_cisco_cgmi_complete_get_decoder_stats ( object,
+                                                invocation,
+                                                pStats ? pStats->current.videoPtsErrors : 0,
+                                                pStats ? pStats->current.videoDecodeErrors : 0,
+                                                pStats ? pStats->current.videoDecodeDrops : 0,
+                                                pStats ? pStats->current.audioPtsErrors : 0,
+                                                pStats ? pStats->intervalMs : 0,
+                                                g_variant_builder_end(histBuilder),
+                                                retStat );
+
+    g_variant_builder_unref( histBuilder );
+    g_free( pStats );
+
+    return TRUE;
+}
+
 static gboolean
 on_handle_cgmi_get_num_subtitle_languages (
     OrgCiscoCgmi *object,
@@ -2170,7 +2543,7 @@ on_handle_cgmi_get_num_subtitle_languages (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint count = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -2182,10 +2555,10 @@ on_handle_cgmi_get_num_subtitle_languages (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetNumSubtitleLanguages( (void *)pSession, &count );
+        retStat = cgmi_GetNumSubtitleLanguages( GUINT_TO_POINTER(pSession), &count );
 
     }while(0);    
 
@@ -2208,7 +2581,7 @@ on_handle_cgmi_get_subtitle_info (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     char *buffer = NULL;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
     gushort pid = 0;
     gushort compPageId = 0;
     gushort ancPageId = 0;
@@ -2239,10 +2612,10 @@ on_handle_cgmi_get_subtitle_info (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetSubtitleInfo( (void *)pSession, index, buffer, bufSize, &pid, &type, &compPageId, &ancPageId );
+        retStat = cgmi_GetSubtitleInfo( GUINT_TO_POINTER(pSession), index, buffer, bufSize, &pid, &type, &compPageId, &ancPageId );
 
     }while(0);
        
@@ -2270,7 +2643,7 @@ on_handle_cgmi_set_default_subtitle_lang (
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -2282,10 +2655,10 @@ on_handle_cgmi_set_default_subtitle_lang (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetDefaultSubtitleLang( (void *)pSession, language );
+        retStat = cgmi_SetDefaultSubtitleLang( GUINT_TO_POINTER(pSession), language );
 
     }while(0);
 
@@ -2305,7 +2678,7 @@ on_handle_cgmi_get_stc (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     uint64_t stc = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     //CGMID_ENTER();
 
@@ -2317,10 +2690,10 @@ on_handle_cgmi_get_stc (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetStc( (void *)pSession, &stc );
+        retStat = cgmi_GetStc( GUINT_TO_POINTER(pSession), &stc );
 
     }while(0);
 
@@ -2343,7 +2716,7 @@ on_handle_cgmi_create_filter( OrgCiscoCgmi *object,
    void *pFilterId;
    GVariant *sessVar = NULL;
    GVariant *filterIdVar = NULL, *dbusVar = NULL;
-   tCgmiDbusPointer pSession;
+   tCgmiDbusHandle pSession;
 
    CGMID_ENTER();
 
@@ -2355,18 +2728,18 @@ on_handle_cgmi_create_filter( OrgCiscoCgmi *object,
          retStat = CGMI_ERROR_FAILED;
          break;
       }
-      g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+      g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
       g_variant_unref( sessVar );
 
       // Provide a pointer to the sessionId as the private data.
-      retStat = cgmi_CreateFilter( (void *)pSession,
+      retStat = cgmi_CreateFilter( GUINT_TO_POINTER(pSession),
                                    arg_filterPid,
                                    (void *)object,
                                    arg_filterFormat,
                                    &pFilterId );
 
       // Build GVariant to return filter ID pointer
-      filterIdVar = g_variant_new( DBUS_POINTER_TYPE, (tCgmiDbusPointer)pFilterId );
+      filterIdVar = g_variant_new( DBUS_HANDLE_TYPE, GPOINTER_TO_UINT(pFilterId) );
       if ( filterIdVar == NULL )
       {
          CGMID_INFO( "Failed to create new variant\n" );
@@ -2415,7 +2788,7 @@ on_handle_cgmi_set_picture_setting(
 {
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -2427,10 +2800,10 @@ on_handle_cgmi_set_picture_setting(
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_SetPictureSetting( (void *)pSession, pctl, value );
+        retStat = cgmi_SetPictureSetting( GUINT_TO_POINTER(pSession), pctl, value );
 
     }while(0);
 
@@ -2451,7 +2824,7 @@ on_handle_cgmi_get_picture_setting (
     cgmi_Status retStat = CGMI_ERROR_FAILED;
     gint value = 0;
     GVariant *sessVar = NULL;
-    tCgmiDbusPointer pSession;
+    tCgmiDbusHandle pSession;
 
     CGMID_ENTER();
 
@@ -2463,10 +2836,10 @@ on_handle_cgmi_get_picture_setting (
             break;
         }
 
-        g_variant_get( sessVar, DBUS_POINTER_TYPE, &pSession );
+        g_variant_get( sessVar, DBUS_HANDLE_TYPE, &pSession );
         g_variant_unref( sessVar );
 
-        retStat = cgmi_GetPictureSetting( (void *)pSession, pctl, &value );
+        retStat = cgmi_GetPictureSetting( GUINT_TO_POINTER(pSession), pctl, &value );
 
     }while(0);
 
@@ -2592,6 +2965,16 @@ on_bus_acquired (GDBusConnection *connection,
                       G_CALLBACK (on_handle_cgmi_load),
                       NULL);
 
+    g_signal_connect (interface,
+                      "handle-load-async",
+                      G_CALLBACK (on_handle_cgmi_load_async),
+                      NULL);
+
+    g_signal_connect (interface,
+                      "handle-preload",
+                      G_CALLBACK (on_handle_cgmi_preload),
+                      NULL);
+
     g_signal_connect (interface,
                       "handle-unload",
                       G_CALLBACK (on_handle_cgmi_unload),
@@ -2617,6 +3000,11 @@ on_bus_acquired (GDBusConnection *connection,
                       G_CALLBACK (on_handle_cgmi_get_position),
                       NULL);
 
+    g_signal_connect (interface,
+                      "handle-get-state",
+                      G_CALLBACK (on_handle_cgmi_get_state),
+                      NULL);
+
     g_signal_connect (interface,
                       "handle-get-duration",
                       G_CALLBACK (on_handle_cgmi_get_duration),
@@ -2722,6 +3110,11 @@ on_bus_acquired (GDBusConnection *connection,
                       G_CALLBACK (on_handle_cgmi_set_pid_info),
                       NULL);
 
+    g_signal_connect (interface,
+                      "handle-select-program",
+                      G_CALLBACK (on_handle_cgmi_select_program),
+                      NULL);
+
     g_signal_connect (interface,
                       "handle-set-logging",
                       G_CALLBACK (on_handle_cgmi_set_logging),
@@ -2742,11 +3135,31 @@ on_bus_acquired (GDBusConnection *connection,
                       G_CALLBACK (on_handle_cgmiDiags_reset_timing_metrics),
                       NULL);
 
+    g_signal_connect (interface,
+                      "handle-get-stage-durations",
+                      G_CALLBACK (on_handle_cgmiDiags_get_stage_durations),
+                      NULL);
+
     g_signal_connect (interface,
                       "handle-get-tsb-slide",
                       G_CALLBACK (on_handle_cgmi_get_tsb_slide),
                       NULL);
 
+    g_signal_connect (interface,
+                      "handle-get-av-sync-stats",
+                      G_CALLBACK (on_handle_cgmi_get_av_sync_stats),
+                      NULL);
+
+    g_signal_connect (interface,
+                      "handle-get-event-queue-stats",
+                      G_CALLBACK (on_handle_cgmi_get_event_queue_stats),
+                      NULL);
+
+    g_signal_connect (interface,
+                      "handle-get-decoder-stats",
+                      G_CALLBACK (on_handle_cgmi_get_decoder_stats),
+                      NULL);
+
     g_signal_connect (interface,
                       "handle-get-num-subtitle-languages",
                       G_CALLBACK (on_handle_cgmi_get_num_subtitle_languages),
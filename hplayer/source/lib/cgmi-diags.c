@@ -506,6 +506,105 @@ cgmi_Status cgmiDiags_ResetTimingMetrics (void)
     return retStatus;
 }
 
+/**
+ *  \brief \b cgmiDiags_GetStageDurations
+ *
+ *  This is a request to get the per stage latency breakdown of a load.
+ *
+ *  \param[in] sessionIndex  The session index of the load.
+ *
+ *  \param[out] stages  An array of to be populated with stages.  This array must be allocated by the caller.
+ *
+ *  \param[in,out] pCount    In: Indicates the size of stages array.  Out:  Indicates the actual number of stages populated.
+ *
+ *  \pre    The system has to be initialized via cgmi_Init()
+ *
+ *  \return  CGMI_ERROR_SUCCESS when the API succeeds
+ *  \return  CGMI_ERROR_BAD_PARAM when no LOAD marker is buffered for sessionIndex
+ *
+ *  \ingroup CGMI-diags
+ *
+ */
+cgmi_Status cgmiDiags_GetStageDurations ( unsigned int sessionIndex, tCgmiDiags_stageDuration stages[], int *pCount )
+{
+    cgmi_Status retStatus = CGMI_ERROR_SUCCESS;
+    tCgmiDiags_timingMetric *pEntry;
+    int start, numEntries, i;
+    int count = 0;
+    bool foundLoad = false;
+    unsigned long long loadTime = 0;
+    unsigned long long prevTime = 0;
+
+    if((NULL == stages) || (NULL == pCount))
+    {
+        return CGMI_ERROR_BAD_PARAM;
+    }
+
+    pthread_mutex_lock(&cgmiDiagMutex);
+
+    if(true == cgmiDiagInitialized)
+    {
+        //walk the buffer once, oldest entry first
+        if(true == timingBufWrapped)
+        {
+            start = timingBufIndex;
+            numEntries = CGMI_DIAGS_TIMING_METRIC_MAX_ENTRY;
+        }
+        else
+        {
+            start = 0;
+            numEntries = timingBufIndex;
+        }
+
+        for(i = 0; i < numEntries; i++)
+        {
+            pEntry = &gTimingBuf[(start + i) % CGMI_DIAGS_TIMING_METRIC_MAX_ENTRY];
+
+            if(pEntry->sessionIndex != sessionIndex)
+            {
+                continue;
+            }
+
+            if(DIAG_TIMING_METRIC_LOAD == pEntry->timingEvent)
+            {
+                foundLoad = true;
+                loadTime = pEntry->markTime;
+                prevTime = pEntry->markTime;
+                count = 0;
+                continue;
+            }
+
+            if((false == foundLoad) || (count >= *pCount))
+            {
+                continue;
+            }
+
+            //markers come from several threads, don't let a clock step produce huge durations
+            stages[count].timingEvent = pEntry->timingEvent;
+            stages[count].markTime = pEntry->markTime;
+            stages[count].sinceLoad = (pEntry->markTime > loadTime) ? (pEntry->markTime - loadTime) : 0;
+            stages[count].duration = (pEntry->markTime > prevTime) ? (pEntry->markTime - prevTime) : 0;
+            prevTime = pEntry->markTime;
+            count++;
+        }
+
+        if(false == foundLoad)
+        {
+            retStatus = CGMI_ERROR_BAD_PARAM;
+        }
+
+        *pCount = count;
+    }
+    else
+    {
+        retStatus = CGMI_ERROR_NOT_INITIALIZED;
+    }
+
+    pthread_mutex_unlock(&cgmiDiagMutex);
+
+    return retStatus;
+}
+
 /**
  *  \brief \b cgmiDiags_GetNextSessionIndex
  *
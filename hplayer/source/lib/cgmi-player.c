@@ -38,6 +38,7 @@
 #include "cgmiPlayerApi.h"
 #include "cgmi-priv-player.h"
 #include "cgmi-section-filter-priv.h"
+#include "cgmi-psi-priv.h"
 #include "cgmiDiagsApi.h"
 #include "cgmi-diags-priv.h"
 
@@ -48,12 +49,31 @@ GST_DEBUG_CATEGORY_STATIC (cgmi);
 #define INVALID_INDEX                  -2
 #define INVALID_PID                    (-1)
 
-#define PTS_FLUSH_THRESHOLD            (10 * 45000) //10 secs
+#define PTS_TICKS_PER_MS               45           //decoder PTS are reported at 45KHz
+#define AVSYNC_DRIFT_THRESHOLD_MS      400          //drift considered out of sync
+#define AVSYNC_SUSTAIN_MS              3000         //how long it must stay out of sync before a flush
 #define PTS_ERROR_COUNT_THRESHOLD      20
 #define VIDEO_DECODE_DROPS_THRESHOLD   20
 #define VIDEO_DECODE_ERRORS_THRESHOLD  20
 #define ERROR_WINDOW_SIZE              5
 #define STEADY_STATE_WINDOW_SIZE       5
+#define DEFAULT_MONITOR_INTERVAL_MS    250          //A/V drift sampling
+#define MONITOR_COUNTER_INTERVAL_MS    1000         //decoder error counter reads
+#define MONITOR_NOTIFY_INTERVAL_MS     (ERROR_WINDOW_SIZE * 1000) //same, for decoders that notify
+#define MIN_MONITOR_INTERVAL_MS        100
+#define DECODER_STATS_INTERVAL_MS      1000         //span of one cgmi_GetDecoderStats history entry
+
+#if GST_CHECK_VERSION(1,0,0)
+#define PLAYBIN_ELEMENT                "playbin"
+#else
+#define PLAYBIN_ELEMENT                "playbin2"
+#endif
+
+#define ASYNC_LOAD_TIMEOUT_SEC         10     //same bound cgmi_Load waits for preroll
+#define REAPER_MAX_THREADS             4      //pipelines torn down in parallel
+#define DEFAULT_SESSION_POOL_SIZE      2      //warm sessions, CGMI_SESSION_POOL_SIZE overrides
+#define EVENT_MAX_THREADS              4      //sessions whose events are delivered in parallel
+#define LOAD_MAX_THREADS               4      //cgmi_LoadAsync completions run in parallel
 
 #define DEFAULT_BLOCKSIZE              65536  //Large buffers increase temporary memory pressure since they may
                                               //get queued up in the demux. It also increases channel change time.
@@ -66,12 +86,45 @@ GST_DEBUG_CATEGORY_STATIC (cgmi);
 static gboolean cgmi_gst_handle_msg( GstBus *bus, GstMessage *msg, gpointer data );
 static GstElement *cgmi_gst_find_element( GstBin *bin, gchar *ename );
 static void cgmi_gst_no_more_pads(GstElement *element, gpointer data);
+static void cgmi_event_emit( tSession *pSess, tcgmi_Event event, uint64_t code );
+static void cgmi_load_finish_wait( tSession *pSess );
+static void cgmi_reaper_queue( tSession *pSess, GstElement *pipeline, GstBus *bus );
+static void cgmi_psi_cache_remember( tSession *pSess, guint program, const tPsiTables *psi );
 
 static gchar gDefaultAudioLanguage[4];
 static gchar gDefaultSubtitleLanguage[4];
 
-static GList *gSessionList = NULL;
-static GMutex gSessionListMutex;
+static tCgmiHandleTable gSessionHandles = { CGMI_HANDLE_TYPE_SESSION };
+
+static tLaunchTemplate gLaunchTemplate;
+
+typedef struct
+{
+   tSession    *pSess;
+   GstElement  *pipeline;
+   GstBus      *bus;
+   gint64      queuedTime;
+}tReapJob;
+
+/* the blocking half of a cgmi_LoadAsync, see cgmi_load_finish_func */
+typedef struct
+{
+   tSession    *pSess;
+   tDlnaProbe  *pProbe;
+}tLoadJob;
+
+static GThreadPool *gReaperPool = NULL;
+static GThreadPool *gEventPool = NULL;
+static GThreadPool *gLoadPool = NULL;
+
+static tDispatcher *gDispatchers = NULL;
+static guint gNumDispatchers = 0;
+static GMutex gDispatcherMutex;
+
+static GQueue gSessionPool = G_QUEUE_INIT;
+static GMutex gSessionPoolMutex;
+static guint gSessionPoolSize = 0;
+static GThreadPool *gSessionPoolRefill = NULL;
 
 static int  cgmi_CheckSessionHandle(tSession *pSess)
 {
@@ -84,6 +137,45 @@ static int  cgmi_CheckSessionHandle(tSession *pSess)
 
 }
 
+// resolve the handle an application passed in, NULL if it is stale or bogus
+tSession *cgmi_LookupSession(void *pSession)
+{
+   tSession *pSess = cgmi_handle_lookup( &gSessionHandles, pSession );
+
+   if ( NULL == pSess )
+   {
+      GST_WARNING("Session handle %p is not live\n", pSession);
+   }
+   return pSess;
+}
+
+//
+// The pipeline state is cached from the bus (and from our own set_state
+// calls) so status queries never wait behind a pending state change.
+//
+static void cgmi_cache_state( tSession *pSess, GstState current, GstState pending )
+{
+   g_atomic_int_set( &pSess->cachedState, (gint)current | ((gint)pending << 8) );
+}
+
+static GstState cgmi_cached_state( tSession *pSess, GstState *pending )
+{
+   gint cached = g_atomic_int_get( &pSess->cachedState );
+
+   if ( NULL != pending )
+      *pending = (GstState)((cached >> 8) & 0xff);
+   return (GstState)(cached & 0xff);
+}
+
+// the state a pending change is heading to, the current one otherwise
+static GstState cgmi_cached_target_state( tSession *pSess )
+{
+   GstState pending;
+   GstState current = cgmi_cached_state( pSess, &pending );
+
+   return ( GST_STATE_VOID_PENDING != pending ) ? pending : current;
+}
+
 static GstStateChangeReturn cisco_gst_setState( tSession *pSess, GstState state )
 {
    GstStateChangeReturn sret;
@@ -96,12 +188,15 @@ static GstStateChangeReturn cisco_gst_setState( tSession *pSess, GstState state
          break;
       case GST_STATE_CHANGE_NO_PREROLL:
          GST_WARNING("Set %d State No Preroll\n", state);
+         cgmi_cache_state( pSess, state, GST_STATE_VOID_PENDING );
          break;
       case GST_STATE_CHANGE_ASYNC:
          GST_WARNING("Set %d State Async\n", state);
+         cgmi_cache_state( pSess, cgmi_cached_state(pSess, NULL), state );
          break;
       case GST_STATE_CHANGE_SUCCESS:
          GST_WARNING("Set %d State Succeeded\n", state);
+         cgmi_cache_state( pSess, state, GST_STATE_VOID_PENDING );
          break;
       default:
          GST_WARNING("Set %d State Unknown\n", state);
@@ -113,17 +208,10 @@ static GstStateChangeReturn cisco_gst_setState( tSession *pSess, GstState state
 
 static GstState cisco_gst_getState( tSession *pSess )
 {
-   GstStateChangeReturn sret;
-   GstState state = GST_STATE_NULL;
+   if ( NULL == pSess->pipeline )
+      return GST_STATE_NULL;
 
-   if ( NULL != pSess->pipeline )
-   {
-      sret = gst_element_get_state( pSess->pipeline, &state, NULL, GST_SECOND );
-      if ( GST_STATE_CHANGE_SUCCESS != sret )
-         state = GST_STATE_NULL;
-   }
-
-   return state;
+   return cgmi_cached_state( pSess, NULL );
 }
 
 static void cgmi_flush_pipeline(tSession *pSess)
@@ -168,6 +256,284 @@ static void cgmi_flush_pipeline(tSession *pSess)
    return;
 }
 
+#if !defined (DISABLE_MONITORING)
+#if GST_CHECK_VERSION(1,0,0)
+#define FLUSH_BRANCH_MAX_DEPTH  8   //elements walked up from a decoder looking for its queue
+
+//
+// The upstream peer of a pad, looking through ghost pads on the way.
+//
+static GstPad *cgmi_branch_upstream_pad(GstPad *sinkPad)
+{
+   GstPad *peer = NULL;
+   GstPad *next = NULL;
+   GstPad *ghost = NULL;
+
+   peer = gst_pad_get_peer(sinkPad);
+   while(NULL != peer)
+   {
+      if(GST_IS_GHOST_PAD(peer))
+      {
+         // a bin's src pad, go inside
+         next = gst_ghost_pad_get_target(GST_GHOST_PAD(peer));
+      }
+      else if(GST_IS_PROXY_PAD(peer))
+      {
+         // the inside of a bin's sink pad, go out to what feeds the bin
+         ghost = GST_PAD(gst_proxy_pad_get_internal(GST_PROXY_PAD(peer)));
+         next = (NULL != ghost) ? gst_pad_get_peer(ghost) : NULL;
+         if(NULL != ghost)
+         {
+            gst_object_unref(ghost);
+         }
+      }
+      else
+      {
+         break;
+      }
+
+      gst_object_unref(peer);
+      peer = next;
+   }
+
+   return peer;
+}
+
+//
+// The src pad of the queue (or multiqueue slot) feeding decoder, or NULL.
+//
+static GstPad *cgmi_branch_queue_pad(GstElement *decoder)
+{
+   GstPad *sinkPad = NULL;
+   GstPad *srcPad = NULL;
+   GstElement *element = NULL;
+   GstElementFactory *factory = NULL;
+   const gchar *factoryName = NULL;
+   gint depth;
+
+   sinkPad = gst_element_get_static_pad(decoder, "sink");
+   for(depth = 0; NULL != sinkPad && depth < FLUSH_BRANCH_MAX_DEPTH; depth++)
+   {
+      srcPad = cgmi_branch_upstream_pad(sinkPad);
+      gst_object_unref(sinkPad);
+      sinkPad = NULL;
+      if(NULL == srcPad)
+      {
+         break;
+      }
+
+      element = gst_pad_get_parent_element(srcPad);
+      if(NULL == element)
+      {
+         break;
+      }
+
+      factory = gst_element_get_factory(element);
+      factoryName = (NULL != factory) ? GST_OBJECT_NAME(factory) : NULL;
+      if(NULL != factoryName &&
+         (0 == strcmp(factoryName, "queue") || 0 == strcmp(factoryName, "queue2") ||
+          0 == strcmp(factoryName, "multiqueue")))
+      {
+         gst_object_unref(element);
+         return srcPad;
+      }
+
+      // a parser or the like, keep walking up
+      sinkPad = gst_element_get_static_pad(element, "sink");
+      gst_object_unref(element);
+      gst_object_unref(srcPad);
+      srcPad = NULL;
+   }
+
+   if(NULL != sinkPad)
+   {
+      gst_object_unref(sinkPad);
+   }
+   if(NULL != srcPad)
+   {
+      gst_object_unref(srcPad);
+   }
+   return NULL;
+}
+
+//
+// Runs on the queue's own streaming thread, ahead of its next buffer.  The
+// queue itself pushes the flush, so its task is never left holding a
+// FLUSHING return, and every element down to the decoder sees flush_start
+// and flush_stop and restarts.  flush_stop keeps the running time and the
+// segment the branch had is sent back in, so it locks back onto the
+// pipeline clock (late data is dropped by the sink) instead of restarting
+// from 0.
+//
+static GstPadProbeReturn cgmi_flush_branch_probe(GstPad *srcPad, GstPadProbeInfo *info, gpointer data)
+{
+   GstEvent *segment = NULL;
+
+   segment = gst_pad_get_sticky_event(srcPad, GST_EVENT_SEGMENT, 0);
+   if(NULL == segment)
+   {
+      GST_WARNING("%s has not seen a segment yet\n", GST_PAD_NAME(srcPad));
+      return GST_PAD_PROBE_REMOVE;
+   }
+
+   if(FALSE == gst_pad_push_event(srcPad, gst_event_new_flush_start()))
+   {
+      GST_ERROR("Failed to push flush start event from %s\n", GST_PAD_NAME(srcPad));
+   }
+   if(FALSE == gst_pad_push_event(srcPad, gst_event_new_flush_stop(FALSE)))
+   {
+      GST_ERROR("Failed to push flush stop event from %s\n", GST_PAD_NAME(srcPad));
+   }
+
+   // flush_stop drops the sticky segment, hand the old one back
+   gst_pad_push_event(srcPad, segment);
+
+   return GST_PAD_PROBE_REMOVE;
+}
+
+//
+// Flush a single decoder branch from the queue feeding it, so the demux and
+// the other branch never see it.  The flush itself happens on the queue's
+// thread ahead of its next buffer, see cgmi_flush_branch_probe.  FALSE if
+// no queue was found above the decoder.
+//
+static gboolean cgmi_flush_branch(GstElement *decoder)
+{
+   GstPad *srcPad = NULL;
+
+   if(NULL == decoder)
+   {
+      return FALSE;
+   }
+
+   srcPad = cgmi_branch_queue_pad(decoder);
+   if(NULL == srcPad)
+   {
+      GST_WARNING("No queue found above %s\n", GST_ELEMENT_NAME(decoder));
+      return FALSE;
+   }
+
+   gst_pad_add_probe(srcPad, GST_PAD_PROBE_TYPE_BUFFER, cgmi_flush_branch_probe, NULL, NULL);
+   gst_object_unref(srcPad);
+
+   return TRUE;
+}
+#endif
+
+//
+// Recover the given CGMI_DECODE_BRANCH_ bits.  A branch that can't be
+// flushed on its own (no decoder or queue found, GStreamer 0.10 whose
+// flush_stop always resets time) falls back to flushing the whole pipeline.
+//
+static guint cgmi_recover_branches(tSession *pSess, guint branches)
+{
+#if GST_CHECK_VERSION(1,0,0)
+   guint flushed = 0;
+
+   if((branches & CGMI_DECODE_BRANCH_VIDEO) && TRUE == cgmi_flush_branch(pSess->videoDecoder))
+   {
+      flushed |= CGMI_DECODE_BRANCH_VIDEO;
+   }
+   if((branches & CGMI_DECODE_BRANCH_AUDIO) && TRUE == cgmi_flush_branch(pSess->audioDecoder))
+   {
+      flushed |= CGMI_DECODE_BRANCH_AUDIO;
+   }
+   if(flushed == branches)
+   {
+      GST_WARNING("Recovered %s%s branch\n",
+                  (flushed & CGMI_DECODE_BRANCH_VIDEO) ? "video " : "",
+                  (flushed & CGMI_DECODE_BRANCH_AUDIO) ? "audio " : "");
+      return flushed;
+   }
+#endif
+
+   cgmi_flush_pipeline(pSess);
+   return CGMI_DECODE_BRANCH_ALL;
+}
+
+// difference of two 32 bit 45KHz PTS/STC values, across a wrap
+static gint64 cgmi_pts_diff(gint64 a, gint64 b)
+{
+   gint64 diff = a - b;
+
+   if ( diff > G_GINT64_CONSTANT(0x80000000) )
+      diff -= G_GINT64_CONSTANT(0x100000000);
+   else if ( diff < -G_GINT64_CONSTANT(0x80000000) )
+      diff += G_GINT64_CONSTANT(0x100000000);
+   return diff;
+}
+#endif
+
+
+//
+// PSI snapshots.  The track info getters must not stall behind PSI
+// processing, so the tables are published as an immutable, reference
+// counted snapshot: a reader announces itself in
+// psiReaders, loads the pointer and takes a reference, all without a lock.
+// A writer swaps the pointer and retires the old one.  Retired snapshots
+// lose the writer's reference the next time psiReaders is seen at 0, so no
+// reader can be caught between loading a pointer and referencing it, and
+// the writer never waits on a reader.
+//
+static tPsiSnapshot gPsiEmpty = { 1 };
+
+static tPsiSnapshot *cgmi_psi_snapshot_get( tSession *pSess )
+{
+   tPsiSnapshot *snap;
+
+   g_atomic_int_inc( &pSess->psiReaders );
+   snap = g_atomic_pointer_get( &pSess->psiSnapshot );
+   if ( NULL == snap )
+      snap = &gPsiEmpty;
+   g_atomic_int_inc( &snap->refCount );
+   g_atomic_int_add( &pSess->psiReaders, -1 );
+
+   return snap;
+}
+
+static void cgmi_psi_snapshot_put( tPsiSnapshot *snap )
+{
+   // gPsiEmpty keeps the reference it was initialized with
+   if ( NULL != snap && TRUE == g_atomic_int_dec_and_test(&snap->refCount) )
+      g_free( snap );
+}
+
+// a private copy of the current tables to build the next snapshot in, psiMutex held
+static tPsiSnapshot *cgmi_psi_snapshot_copy( tSession *pSess )
+{
+   tPsiSnapshot *snap = g_malloc( sizeof(tPsiSnapshot) );
+   tPsiSnapshot *cur = pSess->psiSnapshot;
+
+   snap->refCount = 1;
+   if ( NULL != cur )
+      memcpy( &snap->tables, &cur->tables, sizeof(tPsiTables) );
+   else
+      memset( &snap->tables, 0, sizeof(tPsiTables) );
+
+   return snap;
+}
+
+// psiMutex held, or no reader left
+static void cgmi_psi_snapshot_release_retired( tSession *pSess )
+{
+   g_slist_free_full( pSess->psiRetired, (GDestroyNotify)cgmi_psi_snapshot_put );
+   pSess->psiRetired = NULL;
+}
+
+// psiMutex held, takes over the caller's reference, NULL publishes empty tables
+static void cgmi_psi_snapshot_publish( tSession *pSess, tPsiSnapshot *snap )
+{
+   tPsiSnapshot *old = pSess->psiSnapshot;
+
+   g_atomic_pointer_set( &pSess->psiSnapshot, snap );
+
+   if ( NULL != old )
+      pSess->psiRetired = g_slist_prepend( pSess->psiRetired, old );
+
+   // a reader not counted here has its reference already or loads snap
+   if ( 0 == g_atomic_int_get(&pSess->psiReaders) )
+      cgmi_psi_snapshot_release_retired( pSess );
+}
 
 static cgmi_Status cgmi_queryDiscreteAudioInfo(tSession *pSess)
 {
@@ -179,15 +545,25 @@ static cgmi_Status cgmi_queryDiscreteAudioInfo(tSession *pSess)
    gchar        *discreteLangISO = NULL;
    gchar        **strArr = NULL;
    gchar        **walk = NULL;
+   tPsiSnapshot *snap = NULL;
+   tPsiTables   *psi;
+
+   if(cgmi_CheckSessionHandle(pSess) == FALSE)
+   {
+      GST_ERROR("Invalid session handle\n");
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   // already merged into the snapshot
+   if(FALSE == pSess->bQueryDiscreteAudioInfo)
+   {
+      return CGMI_ERROR_SUCCESS;
+   }
+
+   g_rec_mutex_lock(&pSess->psiMutex);
 
    do
    {
-      if(cgmi_CheckSessionHandle(pSess) == FALSE)
-      {
-         GST_ERROR("Invalid session handle\n");
-         stat = CGMI_ERROR_INVALID_HANDLE;
-         break;
-      }
       if(FALSE == pSess->bQueryDiscreteAudioInfo)
       {
          break;
@@ -214,27 +590,30 @@ static cgmi_Status cgmi_queryDiscreteAudioInfo(tSession *pSess)
          discreteLangISO = gst_structure_get_string(structure, "commaSepDiscreteLangISO");
          GST_INFO("Comma Separted discrete audio languages: %s\n", discreteLangISO);
 
+         snap = cgmi_psi_snapshot_copy(pSess);
+         psi = &snap->tables;
+
          /* Are there language descriptors for the muxed audio languages? If no, add
           * the muxed audio languages to the list */
          /* TODO - check for duplicates */
-         if(0 == pSess->numAudioLanguages)
+         if(0 == psi->numAudioLanguages)
          {
             strArr = g_strsplit(muxedLangISO, ",", -1);
             walk = strArr;
-            while((walk) && (*walk) && (pSess->numAudioLanguages < MAX_AUDIO_LANGUAGE_DESCRIPTORS))
+            while((walk) && (*walk) && (psi->numAudioLanguages < MAX_AUDIO_LANGUAGE_DESCRIPTORS))
             {
-               if(pSess->numAudioLanguages >= 1)
+               if(psi->numAudioLanguages >= 1)
                {
                   GST_ERROR("There is more than one muxed audio stream without language descriptor\n");
                }
                GST_DEBUG("Muxed Audio Lang ISO: %s\n", *walk);
-               g_strlcpy(pSess->audioLanguages[pSess->numAudioLanguages].isoCode, *walk,
-                     sizeof(pSess->audioLanguages[pSess->numAudioLanguages].isoCode));
-               pSess->audioLanguages[pSess->numAudioLanguages].index = INVALID_INDEX;
-               pSess->audioLanguages[pSess->numAudioLanguages].streamType = STREAM_TYPE_AUDIO;
-               pSess->audioLanguages[pSess->numAudioLanguages].pid = INVALID_PID;
-               pSess->audioLanguages[pSess->numAudioLanguages].bDiscrete = FALSE;
-               pSess->numAudioLanguages++;
+               g_strlcpy(psi->audioLanguages[psi->numAudioLanguages].isoCode, *walk,
+                     sizeof(psi->audioLanguages[psi->numAudioLanguages].isoCode));
+               psi->audioLanguages[psi->numAudioLanguages].index = INVALID_INDEX;
+               psi->audioLanguages[psi->numAudioLanguages].streamType = STREAM_TYPE_AUDIO;
+               psi->audioLanguages[psi->numAudioLanguages].pid = INVALID_PID;
+               psi->audioLanguages[psi->numAudioLanguages].bDiscrete = FALSE;
+               psi->numAudioLanguages++;
                walk++;
             }
             g_strfreev(strArr);
@@ -243,26 +622,30 @@ static cgmi_Status cgmi_queryDiscreteAudioInfo(tSession *pSess)
 
          strArr = g_strsplit(discreteLangISO, ",", -1);
          walk = strArr;
-         while((walk) && (*walk) && (pSess->numAudioLanguages < MAX_AUDIO_LANGUAGE_DESCRIPTORS))
+         while((walk) && (*walk) && (psi->numAudioLanguages < MAX_AUDIO_LANGUAGE_DESCRIPTORS))
          {
             GST_DEBUG("Discrete Audio Lang ISO: %s\n", *walk);
-            g_strlcpy(pSess->audioLanguages[pSess->numAudioLanguages].isoCode, *walk,
-                  sizeof(pSess->audioLanguages[pSess->numAudioLanguages].isoCode));
-            pSess->audioLanguages[pSess->numAudioLanguages].index = INVALID_INDEX;
-            pSess->audioLanguages[pSess->numAudioLanguages].streamType = STREAM_TYPE_AUDIO;
-            pSess->audioLanguages[pSess->numAudioLanguages].pid = INVALID_PID;
-            pSess->audioLanguages[pSess->numAudioLanguages].bDiscrete = TRUE;
-            pSess->numAudioLanguages++;
+            g_strlcpy(psi->audioLanguages[psi->numAudioLanguages].isoCode, *walk,
+                  sizeof(psi->audioLanguages[psi->numAudioLanguages].isoCode));
+            psi->audioLanguages[psi->numAudioLanguages].index = INVALID_INDEX;
+            psi->audioLanguages[psi->numAudioLanguages].streamType = STREAM_TYPE_AUDIO;
+            psi->audioLanguages[psi->numAudioLanguages].pid = INVALID_PID;
+            psi->audioLanguages[psi->numAudioLanguages].bDiscrete = TRUE;
+            psi->numAudioLanguages++;
             walk++;
          }
          g_strfreev(strArr);
          strArr = NULL;
+
+         cgmi_psi_snapshot_publish(pSess, snap);
       }
 
       pSess->bQueryDiscreteAudioInfo = FALSE;
 
    }while(0);
 
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
    if( NULL != query )
    {
       gst_query_unref ( query );
@@ -272,6 +655,53 @@ static cgmi_Status cgmi_queryDiscreteAudioInfo(tSession *pSess)
    return stat;
 }
 
+//
+// The discrete audio query goes to the pipeline, so it is run from the bus
+// dispatcher: once the pipeline has prerolled and again when the PMT's audio
+// changes after that.  The getters only ever read the snapshot.
+//
+static gboolean cgmi_psi_audio_query( gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+
+   // cgmi_psi_audio_cancel got here first
+   if ( FALSE == g_source_is_destroyed(g_main_current_source()) )
+   {
+      g_source_unref( pSess->psiAudioSource );
+      pSess->psiAudioSource = NULL;
+      cgmi_queryDiscreteAudioInfo( pSess );
+   }
+
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   return FALSE;
+}
+
+// psiMutex held
+static void cgmi_psi_audio_schedule( tSession *pSess )
+{
+   if ( NULL == pSess->psiAudioSource )
+   {
+      pSess->psiAudioSource = g_idle_source_new();
+      g_source_set_callback( pSess->psiAudioSource, cgmi_psi_audio_query, pSess, NULL );
+      g_source_attach( pSess->psiAudioSource, pSess->thread_ctx );
+   }
+}
+
+static void cgmi_psi_audio_cancel( tSession *pSess )
+{
+   g_rec_mutex_lock(&pSess->psiMutex);
+   if ( NULL != pSess->psiAudioSource )
+   {
+      g_source_destroy( pSess->psiAudioSource );
+      g_source_unref( pSess->psiAudioSource );
+      pSess->psiAudioSource = NULL;
+   }
+   g_rec_mutex_unlock(&pSess->psiMutex);
+}
+
 static void cgmi_GetHwDecHandles(tSession *pSess)
 {
    if(NULL != pSess->videoDecoder)
@@ -310,750 +740,2685 @@ void debug_cisco_gst_streamDurPos( tSession *pSess )
 
 }
 #if !defined (DISABLE_MONITORING)
-//TODO need to document this thread, when does it get shutdown.
-gpointer cgmi_monitor( gpointer data )
-{
-   gint64 videoPts, audioPts, endTime;
-   guint videoPtsErrors;
-   guint videoDecodeDrops;
-   guint videoDecodeErrors;
-   guint audioPtsErrors;
-
-   guint videoPtsErrorsPrev = 0;
-   guint videoDecodeDropsPrev = 0;
-   guint videoDecodeErrorsPrev = 0;
-   guint audioPtsErrorsPrev = 0;
-   guint errorWindow = 0;
-
-   gboolean flushDone = FALSE;
-   tSession *pSess = (tSession*)data;
-   if ( NULL == pSess )
-      return NULL;
-
-   while( pSess->runMonitor )
-   {
-      if ( cisco_gst_getState(pSess) == GST_STATE_PLAYING && pSess->rate == 1.0 )
-      {
-         videoPts = 0;
-         audioPts = 0;
-
-         if ( NULL != pSess->videoDecoder )
-         {
-            g_object_get( pSess->videoDecoder,
-                          "video_pts", &videoPts,
-                          "video_pts_errors", &videoPtsErrors,
-                          "video_decode_errors", &videoDecodeErrors,
-                          "video_decode_drops", &videoDecodeDrops,
-                          NULL);
-         }
-         if ( NULL != pSess->audioDecoder )
-         {
-            g_object_get( pSess->audioDecoder,
-                          "audio_pts", &audioPts,
-                          "audio_pts_errors", &audioPtsErrors,
-                          NULL );
-         }
+//
+// Decoder health monitoring.  One thread services every session: sessions
+// are kept in a queue ordered by their next sample time and the thread
+// sleeps until the earliest one is due.
+//
+static GThread  *gMonitorThread = NULL;
+static GMutex   gMonitorMutex;
+static GCond    gMonitorCond;
+static GQueue   gMonitorQueue = G_QUEUE_INIT;
+static tSession *gMonitorCurrent = NULL;
+static gboolean gMonitorRun = FALSE;
+
+static void cgmi_monitor_reset_window( tSession *pSess, guint videoPtsErrors, guint audioPtsErrors,
+                                       guint videoDecodeDrops, guint videoDecodeErrors )
+{
+   pSess->videoPtsErrorsPrev = videoPtsErrors;
+   pSess->audioPtsErrorsPrev = audioPtsErrors;
+   pSess->videoDecodeDropsPrev = videoDecodeDrops;
+   pSess->videoDecodeErrorsPrev = videoDecodeErrors;
+   pSess->errorWindow = 0;
+}
 
-         //During seeks or transition between trick modes, the monitored counters
-         //may have spikes which may cause spurious errors. Therefore, we need monitoring
-         //to take action only during steady 1x playback state
-         if ( TRUE == pSess->steadyState )
-         {
-            flushDone = FALSE;
-            if ( videoPts > 0 && audioPts > 0 )
-            {
-               if ( videoPts - audioPts > PTS_FLUSH_THRESHOLD || videoPts - audioPts < -PTS_FLUSH_THRESHOLD )
-               {
-                  g_print("Flushing buffers due to large audio-video PTS difference...\n");
-                  g_print("videoPts = %" G_GINT64_MODIFIER "d, audioPts = %" G_GINT64_MODIFIER "d, diff = %" G_GINT64_MODIFIER "d\n", videoPts, audioPts, (videoPts - audioPts));
-
-                  cgmi_flush_pipeline( pSess );
-                  flushDone = TRUE;
-                  //reset error window
-                  videoPtsErrorsPrev = videoPtsErrors;
-                  audioPtsErrorsPrev = audioPtsErrors;
-                  videoDecodeDropsPrev = videoDecodeDrops;
-                  videoDecodeErrorsPrev = videoDecodeErrors;
-                  errorWindow = 0;
-
-                  //A flush may also cause transient unstability
-                  pSess->steadyState = FALSE;
-                  pSess->steadyStateWindow = 0;
-               }
-            }
-            if ( FALSE == flushDone )
-            {
-               if ( errorWindow > ERROR_WINDOW_SIZE )
-               {
-                  //error monitor window reached max size, reset it and resample counters
-                  videoPtsErrorsPrev = videoPtsErrors;
-                  audioPtsErrorsPrev = audioPtsErrors;
-                  videoDecodeDropsPrev = videoDecodeDrops;
-                  videoDecodeErrorsPrev = videoDecodeErrors;
-                  errorWindow = 0;
-               }
+static guint cgmi_counter_delta( guint now, guint base )
+{
+   // a reload brings in a fresh decoder whose counters start over
+   return ( now >= base ) ? now - base : now;
+}
 
-               if ( (gint)videoPtsErrors - (gint)videoPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD ||
-                    (gint)audioPtsErrors - (gint)audioPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD ||
-                    (gint)videoDecodeDrops - (gint)videoDecodeDropsPrev > VIDEO_DECODE_DROPS_THRESHOLD ||
-                    (gint)videoDecodeErrors - (gint)videoDecodeErrorsPrev > VIDEO_DECODE_ERRORS_THRESHOLD )
-               {
-                  g_print("Decoder error threshold reached within %d ms", errorWindow * 1000);
-
-                  g_print("videoPtsErrors = %u (prev = %u, diff = %u)\n", videoPtsErrors, videoPtsErrorsPrev, videoPtsErrors - videoPtsErrorsPrev);
-                  g_print("videoDecodeErrors = %u (prev = %u, diff = %u)\n", videoDecodeErrors, videoDecodeErrorsPrev, videoDecodeErrors - videoDecodeErrorsPrev);
-                  g_print("videoDecodeDrops = %u (prev = %u, diff = %u)\n", videoDecodeDrops, videoDecodeDropsPrev, videoDecodeDrops - videoDecodeDropsPrev);
-                  g_print("audioPtsErrors = %u (prev = %u, diff = %u)\n", audioPtsErrors, audioPtsErrorsPrev, audioPtsErrors - audioPtsErrorsPrev);
-
-                  g_print("Flushing buffers due to decode errors...\n");
-                  pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_DECODE_ERROR, 0);
-                  cgmi_flush_pipeline( pSess );
-                  flushDone = TRUE;
-                  //reset error window
-                  videoPtsErrorsPrev = videoPtsErrors;
-                  audioPtsErrorsPrev = audioPtsErrors;
-                  videoDecodeDropsPrev = videoDecodeDrops;
-                  videoDecodeErrorsPrev = videoDecodeErrors;
-                  errorWindow = 0;
-
-                  //A flush may also cause transient unstability
-                  pSess->steadyState = FALSE;
-                  pSess->steadyStateWindow = 0;
-               }
+//
+// Keep the decoder counters for cgmi_GetDecoderStats.  Whatever the counters
+// grew by is booked to the interval that was open when the sample came in,
+// intervals with no samples at all (paused, trick play) are recorded as 0.
+//
+// decStatsMutex held
+static void cgmi_decoder_stats_book( tSession *pSess, const tcgmi_DecoderCounters *pNow, gint64 now )
+{
+   tcgmi_DecoderCounters *pEntry;
+   gint64 elapsedMs;
+   guint closed;
 
-               if ( videoPtsErrors > videoPtsErrorsPrev )
-                  g_print("videoPtsErrors = %u (prev = %u, diff = %u)\n", videoPtsErrors, videoPtsErrorsPrev, videoPtsErrors - videoPtsErrorsPrev);
-               if ( audioPtsErrors > audioPtsErrorsPrev )
-                  g_print("audioPtsErrors = %u (prev = %u, diff = %u)\n", audioPtsErrors, audioPtsErrorsPrev, audioPtsErrors - audioPtsErrorsPrev);
-               if ( videoDecodeDrops > videoDecodeDropsPrev )
-                  g_print("videoDecodeDrops = %u (prev = %u, diff = %u)\n", videoDecodeDrops, videoDecodeDropsPrev, videoDecodeDrops - videoDecodeDropsPrev);
-               if ( videoDecodeErrors > videoDecodeErrorsPrev )
-                  g_print("videoDecodeErrors = %u (prev = %u, diff = %u)\n", videoDecodeErrors, videoDecodeErrorsPrev, videoDecodeErrors - videoDecodeErrorsPrev);
-            }
+   if ( 0 == pSess->decStatsIntervalStart )
+   {
+      pSess->decStatsIntervalStart = now;
+      pSess->decStatsBase = *pNow;
+   }
 
-            //Increment error monitor window
-            errorWindow++;
-         }
-         else if ( FALSE == pSess->steadyState )
-         {
-            if ( pSess->steadyStateWindow > STEADY_STATE_WINDOW_SIZE )
-            {
-               g_print("Steady state reached, enabling CGMI error monitor...\n");
-               pSess->steadyStateWindow = 0;
-               pSess->steadyState = TRUE;
-               //reset error window
-               videoPtsErrorsPrev = videoPtsErrors;
-               audioPtsErrorsPrev = audioPtsErrors;
-               videoDecodeDropsPrev = videoDecodeDrops;
-               videoDecodeErrorsPrev = videoDecodeErrors;
-               errorWindow = 0;
-            }
-            else if ( 0 == pSess->steadyStateWindow )
-            {
-               g_print("Transient state, disabling CGMI error monitor for %d ms...\n", STEADY_STATE_WINDOW_SIZE * 1000 );
-            }
+   elapsedMs = (now - pSess->decStatsIntervalStart) / 1000;
+   if ( elapsedMs >= DECODER_STATS_INTERVAL_MS )
+   {
+      closed = (guint)MIN( elapsedMs / DECODER_STATS_INTERVAL_MS, CGMI_DECODER_STATS_HISTORY );
 
-            //Increment steady state window
-            pSess->steadyStateWindow++;
-         }
-      }
+      pEntry = &pSess->decStatsHistory[pSess->decStatsHead];
+      pEntry->videoPtsErrors = cgmi_counter_delta( pNow->videoPtsErrors, pSess->decStatsBase.videoPtsErrors );
+      pEntry->videoDecodeErrors = cgmi_counter_delta( pNow->videoDecodeErrors, pSess->decStatsBase.videoDecodeErrors );
+      pEntry->videoDecodeDrops = cgmi_counter_delta( pNow->videoDecodeDrops, pSess->decStatsBase.videoDecodeDrops );
+      pEntry->audioPtsErrors = cgmi_counter_delta( pNow->audioPtsErrors, pSess->decStatsBase.audioPtsErrors );
+      pSess->decStatsHead = (pSess->decStatsHead + 1) % CGMI_DECODER_STATS_HISTORY;
 
-      // Wait until either cond is signalled or end_time has passed. For handling a spurious wakeup, 
-      // retry g_cond_wait_until() until runMonitor becomes false or break if end_time expires
-      g_mutex_lock(&pSess->monThreadMutex);
-      endTime = g_get_monotonic_time () + G_TIME_SPAN_SECOND;
-      while ( pSess->runMonitor )
+      while ( --closed > 0 )
       {
-         if ( FALSE == g_cond_wait_until(&pSess->monThreadCond, &pSess->monThreadMutex, endTime) )
-         {
-            // timeout occurred
-            break;
-         }
+         memset( &pSess->decStatsHistory[pSess->decStatsHead], 0, sizeof(tcgmi_DecoderCounters) );
+         pSess->decStatsHead = (pSess->decStatsHead + 1) % CGMI_DECODER_STATS_HISTORY;
+         if ( pSess->decStatsCount < CGMI_DECODER_STATS_HISTORY )
+            pSess->decStatsCount++;
       }
-      g_mutex_unlock(&pSess->monThreadMutex);
+      if ( pSess->decStatsCount < CGMI_DECODER_STATS_HISTORY )
+         pSess->decStatsCount++;
+
+      pSess->decStatsIntervalStart += (elapsedMs / DECODER_STATS_INTERVAL_MS) * DECODER_STATS_INTERVAL_MS * 1000;
+      pSess->decStatsBase = *pNow;
    }
-   return NULL;
+   pSess->decStatsCurrent = *pNow;
 }
-#endif
-static void cgmi_gst_delayed_seek( tSession *pSess )
+
+static void cgmi_decoder_stats_record( tSession *pSess, const tcgmi_DecoderCounters *pNow, gint64 now )
 {
-   GST_INFO("Executing delayed seek...\n");
+   g_mutex_lock( &pSess->decStatsMutex );
+   cgmi_decoder_stats_book( pSess, pNow, now );
+   g_mutex_unlock( &pSess->decStatsMutex );
+}
 
-   pSess->steadyState = FALSE;
-   pSess->steadyStateWindow = 0;
+//
+// A single counter that changed, as reported by a decoder notification.
+// The others keep their last known value.
+//
+static void cgmi_decoder_stats_update( tSession *pSess, glong counterOffset, guint value, gint64 now )
+{
+   tcgmi_DecoderCounters counters;
 
-   if( !gst_element_seek( pSess->pipeline,
-            1.0,
-            GST_FORMAT_TIME,
-            GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT,
-            GST_SEEK_TYPE_SET,
-            (gint64)(pSess->pendingSeekPosition * GST_SECOND),
-            GST_SEEK_TYPE_NONE,
-            GST_CLOCK_TIME_NONE ))
+   g_mutex_lock( &pSess->decStatsMutex );
+   counters = pSess->decStatsCurrent;
+   G_STRUCT_MEMBER( guint, &counters, counterOffset ) = value;
+   cgmi_decoder_stats_book( pSess, &counters, now );
+   g_mutex_unlock( &pSess->decStatsMutex );
+}
+
+//
+// A/V sync analyzer.  Every drift sample goes into a histogram and a short
+// history the drift slope is fitted over; recovery is requested only once
+// the drift has stayed out of bounds for AVSYNC_SUSTAIN_MS.
+//
+static guint cgmi_avsync_bin( gint driftMs )
+{
+   static const gint edges[CGMI_AVSYNC_HISTOGRAM_BINS - 1] = { -1000, -200, -100, -40, 41, 101, 201, 1001 };
+   guint bin;
+
+   for ( bin = 0; bin < G_N_ELEMENTS(edges); bin++ )
    {
-      GST_WARNING("Seek to Resume Position Failed\n");
+      if ( driftMs < edges[bin] )
+         break;
+   }
+   return bin;
+}
+
+static void cgmi_avsync_reset( tSession *pSess )
+{
+   g_mutex_lock( &pSess->avSyncMutex );
+   memset( &pSess->avSync, 0, sizeof(pSess->avSync) );
+   pSess->avDriftHead = 0;
+   pSess->avDriftCount = 0;
+   pSess->avDriftSustainedMs = 0;
+   g_mutex_unlock( &pSess->avSyncMutex );
+}
+
+static gboolean cgmi_avsync_sample( tSession *pSess, gint64 ptsDiff, gint64 now, guint elapsedMs )
+{
+   gboolean recover = FALSE;
+   gint driftMs;
+   gdouble sumT = 0, sumD = 0, sumTT = 0, sumTD = 0, t, n, denom;
+   guint i, idx;
+
+   // PTS are 32 bits at 45KHz, don't read a wrap on one decoder as drift
+   ptsDiff = cgmi_pts_diff( ptsDiff, 0 );
+   driftMs = (gint)(ptsDiff / PTS_TICKS_PER_MS);
+
+   g_mutex_lock( &pSess->avSyncMutex );
+
+   pSess->avDriftMs[pSess->avDriftHead] = driftMs;
+   pSess->avDriftTime[pSess->avDriftHead] = now;
+   pSess->avDriftHead = (pSess->avDriftHead + 1) % AVSYNC_HISTORY_SIZE;
+   if ( pSess->avDriftCount < AVSYNC_HISTORY_SIZE )
+      pSess->avDriftCount++;
+
+   pSess->avSync.currentDriftMs = driftMs;
+   pSess->avSync.numSamples++;
+   pSess->avSync.histogram[cgmi_avsync_bin(driftMs)]++;
+
+   // least squares fit of drift (ms) over time (s)
+   pSess->avSync.driftSlope = 0.0;
+   if ( pSess->avDriftCount > 1 )
+   {
+      for ( i = 0; i < pSess->avDriftCount; i++ )
+      {
+         idx = (pSess->avDriftHead + AVSYNC_HISTORY_SIZE - pSess->avDriftCount + i) % AVSYNC_HISTORY_SIZE;
+         t = (gdouble)(pSess->avDriftTime[idx] - now) / G_TIME_SPAN_SECOND;
+         sumT += t;
+         sumD += pSess->avDriftMs[idx];
+         sumTT += t * t;
+         sumTD += t * pSess->avDriftMs[idx];
+      }
+      n = pSess->avDriftCount;
+      denom = n * sumTT - sumT * sumT;
+      if ( denom > 0.0 )
+         pSess->avSync.driftSlope = (float)((n * sumTD - sumT * sumD) / denom);
+   }
+
+   if ( driftMs > AVSYNC_DRIFT_THRESHOLD_MS || driftMs < -AVSYNC_DRIFT_THRESHOLD_MS )
+   {
+      if ( 0 == pSess->avDriftSustainedMs )
+      {
+         g_print("A/V drift of %d ms (slope %.1f ms/s), flushing if it persists %d ms\n",
+                 driftMs, pSess->avSync.driftSlope, AVSYNC_SUSTAIN_MS);
+      }
+      pSess->avDriftSustainedMs += elapsedMs;
    }
    else
    {
-      GstState curState;
-      //wait for the seek to complete
-      gst_element_get_state(pSess->pipeline, &curState, NULL, GST_CLOCK_TIME_NONE);
-      GST_INFO("Seek to Resume Position Succeeded\n");
+      pSess->avDriftSustainedMs = 0;
+   }
+
+   if ( pSess->avDriftSustainedMs >= AVSYNC_SUSTAIN_MS )
+   {
+      recover = TRUE;
+      pSess->avSync.numRecoveries++;
+      // the flush restarts the trend
+      pSess->avDriftSustainedMs = 0;
+      pSess->avDriftCount = 0;
    }
+
+   g_mutex_unlock( &pSess->avSyncMutex );
+
+   return recover;
 }
 
-static gboolean cgmi_gst_handle_msg( GstBus *bus, GstMessage *msg, gpointer data )
+//
+// Drift alone doesn't say which decoder is off.  When the demux exposes
+// its STC (same 45KHz base as the decoder PTS) the branch furthest from it
+// is the one recovered, otherwise both are.
+//
+static guint cgmi_avsync_branch( tSession *pSess, gint64 videoPts, gint64 audioPts )
+{
+   guint64 stc = 0;
+   gint64 videoOff, audioOff;
+
+   if ( NULL == pSess->demux ||
+        NULL == g_object_class_find_property(G_OBJECT_GET_CLASS(pSess->demux), "stc") )
+      return CGMI_DECODE_BRANCH_ALL;
+
+   g_object_get( pSess->demux, "stc", &stc, NULL );
+   if ( 0 == stc )
+      return CGMI_DECODE_BRANCH_ALL;
+
+   videoOff = ABS( cgmi_pts_diff(videoPts, (gint64)stc) );
+   audioOff = ABS( cgmi_pts_diff(audioPts, (gint64)stc) );
+
+   if ( videoOff / PTS_TICKS_PER_MS < AVSYNC_DRIFT_THRESHOLD_MS / 2 )
+      return CGMI_DECODE_BRANCH_AUDIO;
+   if ( audioOff / PTS_TICKS_PER_MS < AVSYNC_DRIFT_THRESHOLD_MS / 2 )
+      return CGMI_DECODE_BRANCH_VIDEO;
+   return CGMI_DECODE_BRANCH_ALL;
+}
+
+//
+// A/V drift, sampled at the session's monitor interval.  Only the two PTS
+// are read here.
+//
+static void cgmi_monitor_sample_drift( tSession *pSess, gint64 now )
+{
+   gint64 videoPts = 0, audioPts = 0;
+   guint intervalMs = pSess->monitorIntervalMs;
+
+   // the windows advance by the time actually elapsed since the previous sample
+   if ( 0 != pSess->monitorLastSample && now > pSess->monitorLastSample )
+      intervalMs = (guint)((now - pSess->monitorLastSample) / 1000);
+   pSess->monitorLastSample = now;
+
+   g_object_get( pSess->videoDecoder, "video_pts", &videoPts, NULL );
+   g_object_get( pSess->audioDecoder, "audio_pts", &audioPts, NULL );
+
+   if ( videoPts <= 0 || audioPts <= 0 )
+      return;
+
+   if ( FALSE == cgmi_avsync_sample(pSess, videoPts - audioPts, now, intervalMs) )
+      return;
+
+   g_print("Flushing buffers due to sustained audio-video drift...\n");
+   g_print("videoPts = %" G_GINT64_MODIFIER "d, audioPts = %" G_GINT64_MODIFIER "d, diff = %" G_GINT64_MODIFIER "d\n", videoPts, audioPts, (videoPts - audioPts));
+
+   cgmi_recover_branches( pSess, cgmi_avsync_branch(pSess, videoPts, audioPts) );
+
+   //A flush may also cause transient unstability, the error window is
+   //restarted from fresh counters once steady state is reached again
+   pSess->steadyState = FALSE;
+   pSess->steadyStateWindow = 0;
+}
+
+//
+// Decoder error counters, read every MONITOR_COUNTER_INTERVAL_MS however
+// fast the drift is sampled.  Decoders that notify their counters report
+// the changes themselves (cgmi_monitor_decoder_notify), once playback is
+// steady they are only read every MONITOR_NOTIFY_INTERVAL_MS as a fallback.
+//
+static void cgmi_monitor_sample_counters( tSession *pSess, gint64 now )
+{
+   guint videoPtsErrors = 0;
+   guint videoDecodeDrops = 0;
+   guint videoDecodeErrors = 0;
+   guint audioPtsErrors = 0;
+   guint branches;
+   tcgmi_DecoderCounters counters;
+   guint intervalMs = MONITOR_COUNTER_INTERVAL_MS;
+
+   // a decoder notification can pull a read in early, so the windows
+   // advance by the time actually elapsed since the previous read
+   if ( 0 != pSess->counterLastPoll && now > pSess->counterLastPoll )
+      intervalMs = (guint)((now - pSess->counterLastPoll) / 1000);
+   pSess->counterLastPoll = now;
+
+   if ( NULL != pSess->videoDecoder )
+   {
+      g_object_get( pSess->videoDecoder,
+                    "video_pts_errors", &videoPtsErrors,
+                    "video_decode_errors", &videoDecodeErrors,
+                    "video_decode_drops", &videoDecodeDrops,
+                    NULL);
+   }
+   if ( NULL != pSess->audioDecoder )
+   {
+      g_object_get( pSess->audioDecoder,
+                    "audio_pts_errors", &audioPtsErrors,
+                    NULL );
+   }
+
+   counters.videoPtsErrors = videoPtsErrors;
+   counters.videoDecodeErrors = videoDecodeErrors;
+   counters.videoDecodeDrops = videoDecodeDrops;
+   counters.audioPtsErrors = audioPtsErrors;
+   cgmi_decoder_stats_record( pSess, &counters, now );
+
+   //During seeks or transition between trick modes, the monitored counters
+   //may have spikes which may cause spurious errors. Therefore, we need monitoring
+   //to take action only during steady 1x playback state
+   if ( TRUE == pSess->steadyState )
+   {
+      if ( pSess->errorWindow > ERROR_WINDOW_SIZE * 1000 )
+      {
+         //error monitor window reached max size, reset it and resample counters
+         cgmi_monitor_reset_window( pSess, videoPtsErrors, audioPtsErrors, videoDecodeDrops, videoDecodeErrors );
+      }
+
+      if ( (gint)videoPtsErrors - (gint)pSess->videoPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD ||
+           (gint)audioPtsErrors - (gint)pSess->audioPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD ||
+           (gint)videoDecodeDrops - (gint)pSess->videoDecodeDropsPrev > VIDEO_DECODE_DROPS_THRESHOLD ||
+           (gint)videoDecodeErrors - (gint)pSess->videoDecodeErrorsPrev > VIDEO_DECODE_ERRORS_THRESHOLD )
+      {
+         g_print("Decoder error threshold reached within %u ms", pSess->errorWindow);
+
+         g_print("videoPtsErrors = %u (prev = %u, diff = %u)\n", videoPtsErrors, pSess->videoPtsErrorsPrev, videoPtsErrors - pSess->videoPtsErrorsPrev);
+         g_print("videoDecodeErrors = %u (prev = %u, diff = %u)\n", videoDecodeErrors, pSess->videoDecodeErrorsPrev, videoDecodeErrors - pSess->videoDecodeErrorsPrev);
+         g_print("videoDecodeDrops = %u (prev = %u, diff = %u)\n", videoDecodeDrops, pSess->videoDecodeDropsPrev, videoDecodeDrops - pSess->videoDecodeDropsPrev);
+         g_print("audioPtsErrors = %u (prev = %u, diff = %u)\n", audioPtsErrors, pSess->audioPtsErrorsPrev, audioPtsErrors - pSess->audioPtsErrorsPrev);
+
+         branches = 0;
+         if ( (gint)videoPtsErrors - (gint)pSess->videoPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD ||
+              (gint)videoDecodeDrops - (gint)pSess->videoDecodeDropsPrev > VIDEO_DECODE_DROPS_THRESHOLD ||
+              (gint)videoDecodeErrors - (gint)pSess->videoDecodeErrorsPrev > VIDEO_DECODE_ERRORS_THRESHOLD )
+            branches |= CGMI_DECODE_BRANCH_VIDEO;
+         if ( (gint)audioPtsErrors - (gint)pSess->audioPtsErrorsPrev > PTS_ERROR_COUNT_THRESHOLD )
+            branches |= CGMI_DECODE_BRANCH_AUDIO;
+
+         g_print("Flushing buffers due to decode errors...\n");
+         branches = cgmi_recover_branches( pSess, branches );
+         cgmi_event_emit(pSess, NOTIFY_DECODE_ERROR, branches);
+         cgmi_monitor_reset_window( pSess, videoPtsErrors, audioPtsErrors, videoDecodeDrops, videoDecodeErrors );
+
+         //A flush may also cause transient unstability
+         pSess->steadyState = FALSE;
+         pSess->steadyStateWindow = 0;
+      }
+
+      if ( videoPtsErrors > pSess->videoPtsErrorsPrev )
+         g_print("videoPtsErrors = %u (prev = %u, diff = %u)\n", videoPtsErrors, pSess->videoPtsErrorsPrev, videoPtsErrors - pSess->videoPtsErrorsPrev);
+      if ( audioPtsErrors > pSess->audioPtsErrorsPrev )
+         g_print("audioPtsErrors = %u (prev = %u, diff = %u)\n", audioPtsErrors, pSess->audioPtsErrorsPrev, audioPtsErrors - pSess->audioPtsErrorsPrev);
+      if ( videoDecodeDrops > pSess->videoDecodeDropsPrev )
+         g_print("videoDecodeDrops = %u (prev = %u, diff = %u)\n", videoDecodeDrops, pSess->videoDecodeDropsPrev, videoDecodeDrops - pSess->videoDecodeDropsPrev);
+      if ( videoDecodeErrors > pSess->videoDecodeErrorsPrev )
+         g_print("videoDecodeErrors = %u (prev = %u, diff = %u)\n", videoDecodeErrors, pSess->videoDecodeErrorsPrev, videoDecodeErrors - pSess->videoDecodeErrorsPrev);
+
+      //Increment error monitor window
+      pSess->errorWindow += intervalMs;
+   }
+   else if ( FALSE == pSess->steadyState )
+   {
+      if ( pSess->steadyStateWindow > STEADY_STATE_WINDOW_SIZE * 1000 )
+      {
+         g_print("Steady state reached, enabling CGMI error monitor...\n");
+         pSess->steadyStateWindow = 0;
+         pSess->steadyState = TRUE;
+         cgmi_monitor_reset_window( pSess, videoPtsErrors, audioPtsErrors, videoDecodeDrops, videoDecodeErrors );
+      }
+      else if ( 0 == pSess->steadyStateWindow )
+      {
+         g_print("Transient state, disabling CGMI error monitor for %d ms...\n", STEADY_STATE_WINDOW_SIZE * 1000 );
+      }
+
+      //Increment steady state window
+      pSess->steadyStateWindow += intervalMs;
+   }
+
+   if ( TRUE == pSess->decoderNotifies && TRUE == pSess->steadyState )
+      pSess->counterNextPoll = now + (gint64)MONITOR_NOTIFY_INTERVAL_MS * 1000;
+   else
+      pSess->counterNextPoll = now + (gint64)MONITOR_COUNTER_INTERVAL_MS * 1000;
+}
+
+//
+// Returns the time the session has to be sampled again at the latest.
+//
+static gint64 cgmi_monitor_sample( tSession *pSess )
+{
+   GstState state = GST_STATE_NULL;
+   GstState pending = GST_STATE_VOID_PENDING;
+   gboolean bDrift;
+   gint64 now = g_get_monotonic_time();
+
+   // idle, paused, transitioning or trick play sessions are skipped, don't
+   // block the shared thread waiting on a state change
+   state = cgmi_cached_state( pSess, &pending );
+   if ( NULL == pSess->pipeline || pSess->rate != 1.0 ||
+        GST_STATE_PLAYING != state || GST_STATE_VOID_PENDING != pending )
+   {
+      pSess->monitorLastSample = 0;
+      pSess->counterLastPoll = 0;
+      pSess->counterNextPoll = 0;
+      return now + (gint64)pSess->monitorIntervalMs * 1000;
+   }
+
+   // drift needs both decoders, without them only the counters are read
+   bDrift = ( NULL != pSess->videoDecoder && NULL != pSess->audioDecoder );
+   if ( TRUE == bDrift && TRUE == pSess->steadyState )
+   {
+      cgmi_monitor_sample_drift( pSess, now );
+   }
+   else
+   {
+      pSess->monitorLastSample = 0;
+   }
+
+   if ( now >= pSess->counterNextPoll )
+   {
+      cgmi_monitor_sample_counters( pSess, now );
+   }
+
+   if ( TRUE == bDrift )
+      return now + (gint64)pSess->monitorIntervalMs * 1000;
+   return pSess->counterNextPoll;
+}
+
+//
+// Decoders that emit notify:: on their error counters get the threshold
+// checked and the stats history updated on every change instead of waiting
+// for the next read, which lets the monitor read them far less often.
+// Flushing from a streaming thread is not safe, so crossing a threshold
+// only pulls the session's next sample forward on the monitor thread.
+//
+static const struct
+{
+   const gchar *property;
+   glong       prevOffset;
+   glong       counterOffset;
+   gint        threshold;
+} gDecoderCounters[] =
+{
+   { "video_pts_errors",    G_STRUCT_OFFSET(tSession, videoPtsErrorsPrev),
+                            G_STRUCT_OFFSET(tcgmi_DecoderCounters, videoPtsErrors),    PTS_ERROR_COUNT_THRESHOLD },
+   { "video_decode_errors", G_STRUCT_OFFSET(tSession, videoDecodeErrorsPrev),
+                            G_STRUCT_OFFSET(tcgmi_DecoderCounters, videoDecodeErrors), VIDEO_DECODE_ERRORS_THRESHOLD },
+   { "video_decode_drops",  G_STRUCT_OFFSET(tSession, videoDecodeDropsPrev),
+                            G_STRUCT_OFFSET(tcgmi_DecoderCounters, videoDecodeDrops),  VIDEO_DECODE_DROPS_THRESHOLD },
+   { "audio_pts_errors",    G_STRUCT_OFFSET(tSession, audioPtsErrorsPrev),
+                            G_STRUCT_OFFSET(tcgmi_DecoderCounters, audioPtsErrors),    PTS_ERROR_COUNT_THRESHOLD },
+};
+
+static void cgmi_monitor_kick( tSession *pSess )
+{
+   g_mutex_lock( &gMonitorMutex );
+   // not queued means it is being sampled right now or no longer monitored
+   if ( TRUE == g_queue_remove(&gMonitorQueue, pSess) )
+   {
+      pSess->monitorNextRun = g_get_monotonic_time();
+      pSess->counterNextPoll = 0;
+      g_queue_push_head( &gMonitorQueue, pSess );
+      g_cond_broadcast( &gMonitorCond );
+   }
+   g_mutex_unlock( &gMonitorMutex );
+}
+
+static void cgmi_monitor_decoder_notify( GObject *obj, GParamSpec *pspec, gpointer data )
 {
    tSession *pSess = (tSession*)data;
-   GstStructure *structure;
+   const gchar *name = g_param_spec_get_name( pspec );
+   GstState pending = GST_STATE_VOID_PENDING;
+   guint value = 0;
+   guint prev;
+   guint i;
 
-   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   if ( FALSE == pSess->decoderNotifies )
    {
-      return FALSE;
+      g_print("Decoder %s notifies %s, error monitoring is event driven\n", GST_ELEMENT_NAME(obj), name);
+      pSess->decoderNotifies = TRUE;
    }
 
-   switch( GST_MESSAGE_TYPE(msg) )
+   // the monitor keeps no stats and checks no thresholds outside of 1x playback either
+   if ( pSess->rate != 1.0 || GST_STATE_PLAYING != cgmi_cached_state(pSess, &pending) ||
+        GST_STATE_VOID_PENDING != pending )
+      return;
+
+   for ( i = 0; i < G_N_ELEMENTS(gDecoderCounters); i++ )
    {
-      GST_INFO("Got bus message of type: %s\n", GST_MESSAGE_SRC_NAME(msg));
+      if ( 0 != strcmp(name, gDecoderCounters[i].property) )
+         continue;
 
-      case GST_MESSAGE_ASYNC_DONE:
-         GST_INFO("Async Done message\n");
-         //pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_SEEK_DONE, 0);
-         break;
+      g_object_get( obj, name, &value, NULL );
+      cgmi_decoder_stats_update( pSess, gDecoderCounters[i].counterOffset, value, g_get_monotonic_time() );
 
-      case GST_MESSAGE_EOS:
-         GST_INFO("End of Stream\n");
-         pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_END_OF_STREAM,0);
+      if ( TRUE != pSess->steadyState )
          break;
 
-      case GST_MESSAGE_ELEMENT:
-      // these are cisco added events.
-#if GST_CHECK_VERSION(1,0,0)
-         structure = (GstStructure *)gst_message_get_structure(msg);
-#else
-         structure = msg->structure;
-#endif
-         if( structure && gst_structure_has_name(structure, "extended_notification"))
-         {
-            //const GValue *ntype;
-            const gchar *ntype;
-            //figure out which extended notification that we have recieved.
-            GST_INFO("RECEIVED extended notification message\n");
-            ntype = gst_structure_get_string(structure, "notification");
-            if (NULL == ntype)
-            {
-               GST_ERROR("Null notification!\n");
-            }
-            if (0 == strcmp(ntype, "first_pts_received"))
-            {
-               GST_INFO("RECEIVED first_pts_received\n");
-            }
-            else if (0 == strcmp(ntype, "first_pts_decoded"))
-            {
-               GST_INFO("RECEIVED first_pts_decoded\n");
-               if ( TRUE == pSess->pendingSeek )
-               {
-                  cgmi_gst_delayed_seek( pSess );
-               }
+      prev = G_STRUCT_MEMBER( guint, pSess, gDecoderCounters[i].prevOffset );
+      if ( (gint)value - (gint)prev > gDecoderCounters[i].threshold )
+      {
+         GST_INFO("%s jumped to %u (prev = %u), sampling now\n", name, value, prev);
+         cgmi_monitor_kick( pSess );
+      }
+      break;
+   }
+}
 
-               if ( FALSE == pSess->pendingSeek )
-               {
-                  if( NULL != pSess->videoDecoder )
-                  {
-                     g_print("Unmuting video decoder...\n");
-                     g_object_set( G_OBJECT(pSess->videoDecoder), "decoder_mute", FALSE, NULL );
-                  }
+static void cgmi_monitor_watch_decoder( tSession *pSess, GstElement *decoder )
+{
+   GObjectClass *klass = G_OBJECT_GET_CLASS( decoder );
+   gchar signal[64];
+   guint i;
 
-                  if( NULL != pSess->audioDecoder && pSess->rate == 1.0 )
-                  {
-                     g_print("Unmuting audio decoder...\n");
-                     g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", FALSE, NULL );
-                  }
+   for ( i = 0; i < G_N_ELEMENTS(gDecoderCounters); i++ )
+   {
+      if ( NULL == g_object_class_find_property(klass, gDecoderCounters[i].property) )
+         continue;
 
-                  cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PTS_DECODED, pSess->diagIndex, pSess->playbackURI, 0);
-                  pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_FIRST_PTS_DECODED, 0 );
-               }
-               else
-                  pSess->pendingSeek = FALSE;
-            }
-            else if (0 == strcmp(ntype, "first_audio_frame_found"))
-            {
-               GST_INFO("RECEIVED first_audio_frame_found\n");
-               if ( TRUE == pSess->noVideo )
-               {
-                  if ( TRUE == pSess->pendingSeek )
-                  {
-                     cgmi_gst_delayed_seek( pSess );
-                  }
+      g_snprintf( signal, sizeof(signal), "notify::%s", gDecoderCounters[i].property );
+      g_signal_connect( decoder, signal, G_CALLBACK(cgmi_monitor_decoder_notify), pSess );
+   }
+}
 
-                  if ( FALSE == pSess->pendingSeek )
-                  {
-                     if( NULL != pSess->audioDecoder && pSess->rate == 1.0 )
-                     {
-                        g_print("Unmuting audio decoder...\n");
-                        g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", FALSE, NULL );
-                     }
+static gint cgmi_monitor_compare( gconstpointer a, gconstpointer b, gpointer data )
+{
+   const tSession *pA = (const tSession*)a;
+   const tSession *pB = (const tSession*)b;
 
-                     cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PTS_DECODED, pSess->diagIndex, pSess->playbackURI, 0);
-                     pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_FIRST_PTS_DECODED, 0 );
-                  }
-                  else
-                     pSess->pendingSeek = FALSE;
-               }
-            }
-            else if (0 == strcmp(ntype, "stream_attrib_changed"))
-            {
-               gint width, height;
-               gint numerator, denominator;
-               uint64_t eventVal;
-               if (gst_structure_get_int(structure, "src_width", &width) == FALSE)
-               {
-                  GST_WARNING("Failed to get video source widht, returning 0");
-                  width = 0;
-               }
-               if (gst_structure_get_int(structure, "src_height", &height) == FALSE)
-               {
-                  GST_WARNING("Failed to get video source height, returning 0");
-                  height = 0;
-               }
-               if (gst_structure_get_int(structure, "numerator", &numerator) == FALSE)
-               {
-                   GST_WARNING("Failed to get numerator, returning 1,1");
-                   numerator = denominator = 1;
-               }
-               else
-               {
-                   if (gst_structure_get_int(structure, "denominator", &denominator) == FALSE)
-                   {
-                       GST_WARNING("Failed to get denominator, returning 1,1");
-                       denominator = numerator = 1;
-                   }
-               }
-               eventVal = (((uint64_t)width) << 48) | (((uint64_t)height) << 32) | (((uint64_t)numerator) << 16) | denominator;
-               pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_VIDEO_RESOLUTION_CHANGED, eventVal);
-            }
-            else if (0 == strcmp(ntype, "rate_changed"))
-            {
-                gint rate;
-                GST_INFO("RECEIVED rate_changed\n");
-                if (gst_structure_get_int(structure, "rate", &rate) == FALSE)
-                {
-                    GST_WARNING("Failed to get new rate, returning 0");
-                    rate = 0;
-                }
-                if(!((TRUE == pSess->maskRateChangedEvent) && (rate != pSess->rateAfterPause)))
-                {
-                   pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_CHANGED_RATE, (uint64_t)rate );
-                }
-                pSess->maskRateChangedEvent = FALSE;
-                pSess->rateAfterPause = 0.0;
-            }
-            else if (0 == strcmp(ntype, "tsb_start_near_pause_position"))
-            {
-               GST_INFO("RECEIVED tsb_start_near_pause_position - sending EOS to app");
-               pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_END_OF_STREAM, 0);
-            }
-            /* BOF/BOS/EOF should be treated as EOS since gstreamer treats all these conditions EOS */
-#if 0
-            else if (0 == strcmp(ntype, "BOF"))
-            {
-               pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_START_OF_STREAM, 0);
-               cgmi_SetRate(pSess, 0.0);
-            }
-#endif
-            else if (0 == strcmp(ntype, "network_error"))
-            {
-               pSess->eventCB(pSess->usrParam, (void*)pSess , NOTIFY_NETWORK_ERROR, 0);
-            }
-            else
-            {
-               GST_ERROR("Do not know how to handle %s notification\n",ntype);
-            }
-         }
-         break;
-      case GST_MESSAGE_ERROR:
+   if ( pA->monitorNextRun < pB->monitorNextRun )
+      return -1;
+   return ( pA->monitorNextRun > pB->monitorNextRun ) ? 1 : 0;
+}
+
+static gpointer cgmi_monitor( gpointer data )
+{
+   tSession *pSess = NULL;
+   gint64 nextRun;
+
+   g_mutex_lock( &gMonitorMutex );
+   while ( gMonitorRun )
+   {
+      pSess = (tSession*)g_queue_peek_head( &gMonitorQueue );
+      if ( NULL == pSess )
       {
-         gchar  *debug;
-         GError *error;
+         g_cond_wait( &gMonitorCond, &gMonitorMutex );
+         continue;
+      }
 
-         gst_message_parse_error( msg, &error, &debug );
-         g_free( debug );
+      // sleep until the earliest session is due, a register/unregister
+      // signals the cond so we re-evaluate the head of the queue
+      if ( g_get_monotonic_time() < pSess->monitorNextRun )
+      {
+         g_cond_wait_until( &gMonitorCond, &gMonitorMutex, pSess->monitorNextRun );
+         continue;
+      }
 
-         GST_WARNING("Error:%d:%d: %s - domain:%d\n",error->code, error->domain,  error->message, GST_RESOURCE_ERROR);
-         // the error could come from multiple domains.
-         if(error->domain == GST_CORE_ERROR)
-         {
-         }
-         else if (error->domain ==  GST_LIBRARY_ERROR)
+      g_queue_pop_head( &gMonitorQueue );
+      gMonitorCurrent = pSess;
+      g_mutex_unlock( &gMonitorMutex );
+
+      nextRun = cgmi_monitor_sample( pSess );
+
+      g_mutex_lock( &gMonitorMutex );
+      gMonitorCurrent = NULL;
+      if ( TRUE == pSess->runMonitor )
+      {
+         pSess->monitorNextRun = nextRun;
+         g_queue_insert_sorted( &gMonitorQueue, pSess, cgmi_monitor_compare, NULL );
+      }
+      // wake anyone in cgmi_monitor_unregister waiting for this session
+      g_cond_broadcast( &gMonitorCond );
+   }
+   g_mutex_unlock( &gMonitorMutex );
+
+   return NULL;
+}
+
+static void cgmi_monitor_register( tSession *pSess )
+{
+   g_mutex_lock( &gMonitorMutex );
+   pSess->runMonitor = TRUE;
+   pSess->monitorNextRun = g_get_monotonic_time() + (gint64)pSess->monitorIntervalMs * 1000;
+   g_queue_insert_sorted( &gMonitorQueue, pSess, cgmi_monitor_compare, NULL );
+   g_cond_broadcast( &gMonitorCond );
+   g_mutex_unlock( &gMonitorMutex );
+}
+
+static void cgmi_monitor_unregister( tSession *pSess )
+{
+   g_mutex_lock( &gMonitorMutex );
+   pSess->runMonitor = FALSE;
+   g_queue_remove( &gMonitorQueue, pSess );
+   // the session may be being sampled right now, wait for that to finish
+   while ( gMonitorCurrent == pSess )
+   {
+      g_cond_wait( &gMonitorCond, &gMonitorMutex );
+   }
+   g_mutex_unlock( &gMonitorMutex );
+}
+
+static void cgmi_monitor_set_interval( tSession *pSess, guint intervalMs )
+{
+   if ( intervalMs < MIN_MONITOR_INTERVAL_MS )
+      intervalMs = MIN_MONITOR_INTERVAL_MS;
+
+   g_mutex_lock( &gMonitorMutex );
+   pSess->monitorIntervalMs = intervalMs;
+   // reschedule from now if the session is waiting in the queue
+   if ( TRUE == g_queue_remove(&gMonitorQueue, pSess) )
+   {
+      pSess->monitorNextRun = g_get_monotonic_time() + (gint64)intervalMs * 1000;
+      g_queue_insert_sorted( &gMonitorQueue, pSess, cgmi_monitor_compare, NULL );
+      g_cond_broadcast( &gMonitorCond );
+   }
+   g_mutex_unlock( &gMonitorMutex );
+}
+
+static void cgmi_monitor_start( void )
+{
+   g_mutex_lock( &gMonitorMutex );
+   gMonitorRun = TRUE;
+   g_mutex_unlock( &gMonitorMutex );
+
+   gMonitorThread = g_thread_new( "monitoring_thread", cgmi_monitor, NULL );
+   if ( NULL == gMonitorThread )
+   {
+      GST_WARNING("Error launching thread for monitoring timestamp errors\n");
+   }
+}
+
+static void cgmi_monitor_stop( void )
+{
+   g_mutex_lock( &gMonitorMutex );
+   gMonitorRun = FALSE;
+   g_cond_broadcast( &gMonitorCond );
+   g_mutex_unlock( &gMonitorMutex );
+
+   if ( NULL != gMonitorThread )
+   {
+      GST_INFO("about to join monitoring thread\n");
+      g_thread_join( gMonitorThread );
+      gMonitorThread = NULL;
+   }
+}
+#endif
+static void cgmi_gst_delayed_seek( tSession *pSess )
+{
+   GST_INFO("Executing delayed seek...\n");
+
+   pSess->steadyState = FALSE;
+   pSess->steadyStateWindow = 0;
+
+   if( !gst_element_seek( pSess->pipeline,
+            1.0,
+            GST_FORMAT_TIME,
+            GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT,
+            GST_SEEK_TYPE_SET,
+            (gint64)(pSess->pendingSeekPosition * GST_SECOND),
+            GST_SEEK_TYPE_NONE,
+            GST_CLOCK_TIME_NONE ))
+   {
+      GST_WARNING("Seek to Resume Position Failed\n");
+   }
+   else
+   {
+      // runs on the shared bus dispatcher, so don't wait for the seek here,
+      // its ASYNC_DONE is handled like any other
+      GST_INFO("Seek to Resume Position issued\n");
+   }
+}
+
+static void cgmi_async_load_done( tSession *pSess )
+{
+   if(FALSE == pSess->suppressLoadDone)
+   {
+      cgmi_event_emit(pSess, NOTIFY_LOAD_DONE, 0);
+   }
+   else
+   {
+      pSess->suppressLoadDone = FALSE;
+   }
+
+   cgmi_GetHwDecHandles(pSess);
+   pSess->hasFullGstPipeline = TRUE;
+}
+
+//
+// Stop tracking an asynchronous load.  Returns TRUE if one was pending, the
+// caller is then the one responsible for reporting its outcome (if any).
+//
+static gboolean cgmi_async_load_stop( tSession *pSess )
+{
+   gboolean wasPending;
+
+   g_mutex_lock(&pSess->asyncLoadMutex);
+   wasPending = pSess->asyncLoadPending;
+   pSess->asyncLoadPending = FALSE;
+   if ( NULL != pSess->asyncLoadTimeout )
+   {
+      g_source_destroy( pSess->asyncLoadTimeout );
+      g_source_unref( pSess->asyncLoadTimeout );
+      pSess->asyncLoadTimeout = NULL;
+   }
+   g_mutex_unlock(&pSess->asyncLoadMutex);
+
+   return wasPending;
+}
+
+static gboolean cgmi_async_load_timeout( gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+
+   if ( TRUE == cgmi_async_load_stop(pSess) )
+   {
+      GST_ERROR("State change to PAUSED timed out\n");
+      cgmi_event_emit(pSess, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+   }
+
+   return FALSE;
+}
+
+static void cgmi_async_load_start( tSession *pSess )
+{
+   g_mutex_lock(&pSess->asyncLoadMutex);
+   pSess->asyncLoadPending = TRUE;
+   pSess->asyncLoadTimeout = g_timeout_source_new_seconds( ASYNC_LOAD_TIMEOUT_SEC );
+   g_source_set_callback( pSess->asyncLoadTimeout, cgmi_async_load_timeout, pSess, NULL );
+   g_source_attach( pSess->asyncLoadTimeout, pSess->thread_ctx );
+   g_mutex_unlock(&pSess->asyncLoadMutex);
+}
+
+//
+// Unmutes the decoders and reports NOTIFY_FIRST_PTS_DECODED once the first
+// frame is out.  audioOnly is set when the first audio frame stands in for
+// the video one on streams without video.
+//
+static void cgmi_gst_first_frame_decoded( tSession *pSess, gboolean audioOnly )
+{
+   // stamped before unmuting, the unmute cost belongs to the next stage
+   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PTS_DECODED, pSess->diagIndex, pSess->playbackURI, 0);
+
+   if( FALSE == audioOnly && NULL != pSess->videoDecoder )
+   {
+      g_print("Unmuting video decoder...\n");
+      g_object_set( G_OBJECT(pSess->videoDecoder), "decoder_mute", FALSE, NULL );
+   }
+
+   if( NULL != pSess->audioDecoder && pSess->rate == 1.0 )
+   {
+      g_print("Unmuting audio decoder...\n");
+      g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", FALSE, NULL );
+   }
+
+   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_DECODER_UNMUTED, pSess->diagIndex, pSess->playbackURI, 0);
+   cgmi_event_emit(pSess, NOTIFY_FIRST_PTS_DECODED, 0 );
+}
+
+//
+// Bus sync handler, runs on whichever thread posted the message.  The
+// latency critical notifications are handled right here instead of waiting
+// behind everything else queued on the session context, messages that
+// cgmi_gst_handle_msg would ignore are dropped and only the remainder is
+// passed on to the bus watch.
+//
+static GstBusSyncReply cgmi_gst_bus_sync_handler( GstBus *bus, GstMessage *msg, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+   GstStructure *structure;
+   const gchar *ntype;
+
+   // a pipeline handed to the reaper can still post on its old bus
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE || bus != pSess->bus )
+   {
+      return GST_BUS_DROP;
+   }
+
+   switch( GST_MESSAGE_TYPE(msg) )
+   {
+      case GST_MESSAGE_EOS:
+      case GST_MESSAGE_ERROR:
+         cgmi_gst_handle_msg( bus, msg, pSess );
+         return GST_BUS_DROP;
+
+      case GST_MESSAGE_ELEMENT:
+#if GST_CHECK_VERSION(1,0,0)
+         structure = (GstStructure *)gst_message_get_structure(msg);
+#else
+         structure = msg->structure;
+#endif
+         if ( NULL == structure || !gst_structure_has_name(structure, "extended_notification") )
          {
+            return GST_BUS_DROP;
          }
-         else if (error->domain == GST_RESOURCE_ERROR)
+         ntype = gst_structure_get_string(structure, "notification");
+         if ( NULL == ntype )
          {
-            if (error->code == GST_RESOURCE_ERROR_NOT_FOUND)
+            GST_ERROR("Null notification!\n");
+            return GST_BUS_DROP;
+         }
+         if ( 0 == strcmp(ntype, "first_pts_received") )
+         {
+            cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_FIRST_PTS_RECEIVED, pSess->diagIndex, pSess->playbackURI, 0);
+            return GST_BUS_DROP;
+         }
+         // a pending seek has to be issued from the session context
+         if ( TRUE == pSess->pendingSeek )
+         {
+            return GST_BUS_PASS;
+         }
+         if ( 0 == strcmp(ntype, "first_pts_decoded") )
+         {
+            GST_INFO("RECEIVED first_pts_decoded\n");
+            cgmi_gst_first_frame_decoded( pSess, FALSE );
+            return GST_BUS_DROP;
+         }
+         if ( 0 == strcmp(ntype, "first_audio_frame_found") )
+         {
+            if ( TRUE == pSess->noVideo )
             {
-               pSess->eventCB(pSess->usrParam, (void*)pSess,NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+               GST_INFO("RECEIVED first_audio_frame_found\n");
+               cgmi_gst_first_frame_decoded( pSess, TRUE );
             }
+            return GST_BUS_DROP;
          }
-         else if (error->domain == GST_STREAM_ERROR)
+         return GST_BUS_PASS;
+
+      case GST_MESSAGE_STATE_CHANGED:
+         // only the pipeline's own state changes are tracked
+         if ( GST_MESSAGE_SRC(msg) != GST_OBJECT(pSess->pipeline) )
          {
-            if (error->code == GST_STREAM_ERROR_FAILED)
+            return GST_BUS_DROP;
+         }
+         return GST_BUS_PASS;
+
+      case GST_MESSAGE_ASYNC_DONE:
+         return GST_BUS_PASS;
+
+      default:
+         return GST_BUS_DROP;
+   }
+}
+
+static gboolean cgmi_gst_handle_msg( GstBus *bus, GstMessage *msg, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+   GstStructure *structure;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      return FALSE;
+   }
+
+   switch( GST_MESSAGE_TYPE(msg) )
+   {
+      GST_INFO("Got bus message of type: %s\n", GST_MESSAGE_SRC_NAME(msg));
+
+      case GST_MESSAGE_ASYNC_DONE:
+         GST_INFO("Async Done message\n");
+         //cgmi_event_emit(pSess, NOTIFY_SEEK_DONE, 0);
+         cgmi_cache_state( pSess, cgmi_cached_state(pSess, NULL), GST_STATE_VOID_PENDING );
+         if ( TRUE == cgmi_async_load_stop(pSess) )
+         {
+            cgmi_async_load_done(pSess);
+         }
+         cgmi_queryDiscreteAudioInfo(pSess);
+         break;
+
+      case GST_MESSAGE_EOS:
+         GST_INFO("End of Stream\n");
+         cgmi_event_emit(pSess, NOTIFY_END_OF_STREAM, 0);
+         break;
+
+      case GST_MESSAGE_ELEMENT:
+      // these are cisco added events.
+#if GST_CHECK_VERSION(1,0,0)
+         structure = (GstStructure *)gst_message_get_structure(msg);
+#else
+         structure = msg->structure;
+#endif
+         if( structure && gst_structure_has_name(structure, "extended_notification"))
+         {
+            //const GValue *ntype;
+            const gchar *ntype;
+            //figure out which extended notification that we have recieved.
+            GST_INFO("RECEIVED extended notification message\n");
+            ntype = gst_structure_get_string(structure, "notification");
+            if (NULL == ntype)
             {
-               pSess->eventCB(pSess->usrParam, (void*)pSess,NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+               GST_ERROR("Null notification!\n");
+               break;
             }
-         }
+            if (0 == strcmp(ntype, "first_pts_received"))
+            {
+               GST_INFO("RECEIVED first_pts_received\n");
+               cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_FIRST_PTS_RECEIVED, pSess->diagIndex, pSess->playbackURI, 0);
+            }
+            else if (0 == strcmp(ntype, "first_pts_decoded"))
+            {
+               GST_INFO("RECEIVED first_pts_decoded\n");
+               if ( TRUE == pSess->pendingSeek )
+               {
+                  cgmi_gst_delayed_seek( pSess );
+               }
+
+               if ( FALSE == pSess->pendingSeek )
+                  cgmi_gst_first_frame_decoded( pSess, FALSE );
+               else
+                  pSess->pendingSeek = FALSE;
+            }
+            else if (0 == strcmp(ntype, "first_audio_frame_found"))
+            {
+               GST_INFO("RECEIVED first_audio_frame_found\n");
+               if ( TRUE == pSess->noVideo )
+               {
+                  if ( TRUE == pSess->pendingSeek )
+                  {
+                     cgmi_gst_delayed_seek( pSess );
+                  }
+
+                  if ( FALSE == pSess->pendingSeek )
+                     cgmi_gst_first_frame_decoded( pSess, TRUE );
+                  else
+                     pSess->pendingSeek = FALSE;
+               }
+            }
+            else if (0 == strcmp(ntype, "stream_attrib_changed"))
+            {
+               gint width, height;
+               gint numerator, denominator;
+               uint64_t eventVal;
+               if (gst_structure_get_int(structure, "src_width", &width) == FALSE)
+               {
+                  GST_WARNING("Failed to get video source widht, returning 0");
+                  width = 0;
+               }
+               if (gst_structure_get_int(structure, "src_height", &height) == FALSE)
+               {
+                  GST_WARNING("Failed to get video source height, returning 0");
+                  height = 0;
+               }
+               if (gst_structure_get_int(structure, "numerator", &numerator) == FALSE)
+               {
+                   GST_WARNING("Failed to get numerator, returning 1,1");
+                   numerator = denominator = 1;
+               }
+               else
+               {
+                   if (gst_structure_get_int(structure, "denominator", &denominator) == FALSE)
+                   {
+                       GST_WARNING("Failed to get denominator, returning 1,1");
+                       denominator = numerator = 1;
+                   }
+               }
+               eventVal = (((uint64_t)width) << 48) | (((uint64_t)height) << 32) | (((uint64_t)numerator) << 16) | denominator;
+               cgmi_event_emit(pSess, NOTIFY_VIDEO_RESOLUTION_CHANGED, eventVal);
+            }
+            else if (0 == strcmp(ntype, "rate_changed"))
+            {
+                gint rate;
+                GST_INFO("RECEIVED rate_changed\n");
+                if (gst_structure_get_int(structure, "rate", &rate) == FALSE)
+                {
+                    GST_WARNING("Failed to get new rate, returning 0");
+                    rate = 0;
+                }
+                if(!((TRUE == pSess->maskRateChangedEvent) && (rate != pSess->rateAfterPause)))
+                {
+                   cgmi_event_emit(pSess, NOTIFY_CHANGED_RATE, (uint64_t)rate );
+                }
+                pSess->maskRateChangedEvent = FALSE;
+                pSess->rateAfterPause = 0.0;
+            }
+            else if (0 == strcmp(ntype, "tsb_start_near_pause_position"))
+            {
+               GST_INFO("RECEIVED tsb_start_near_pause_position - sending EOS to app");
+               cgmi_event_emit(pSess, NOTIFY_END_OF_STREAM, 0);
+            }
+            /* BOF/BOS/EOF should be treated as EOS since gstreamer treats all these conditions EOS */
+#if 0
+            else if (0 == strcmp(ntype, "BOF"))
+            {
+               cgmi_event_emit(pSess, NOTIFY_START_OF_STREAM, 0);
+               cgmi_SetRate(pSess->handle, 0.0);
+            }
+#endif
+            else if (0 == strcmp(ntype, "network_error"))
+            {
+               cgmi_event_emit(pSess, NOTIFY_NETWORK_ERROR, 0);
+            }
+            else
+            {
+               GST_ERROR("Do not know how to handle %s notification\n",ntype);
+            }
+         }
+         break;
+      case GST_MESSAGE_ERROR:
+      {
+         gchar  *debug;
+         GError *error;
+         gboolean bNotified = FALSE;
+         gboolean bLoadPending;
+
+         gst_message_parse_error( msg, &error, &debug );
+         g_free( debug );
+
+         bLoadPending = cgmi_async_load_stop(pSess);
+
+         GST_WARNING("Error:%d:%d: %s - domain:%d\n",error->code, error->domain,  error->message, GST_RESOURCE_ERROR);
+         // the error could come from multiple domains.
+         if(error->domain == GST_CORE_ERROR)
+         {
+         }
+         else if (error->domain ==  GST_LIBRARY_ERROR)
+         {
+         }
+         else if (error->domain == GST_RESOURCE_ERROR)
+         {
+            if (error->code == GST_RESOURCE_ERROR_NOT_FOUND)
+            {
+               cgmi_event_emit(pSess, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+               bNotified = TRUE;
+            }
+         }
+         else if (error->domain == GST_STREAM_ERROR)
+         {
+            if (error->code == GST_STREAM_ERROR_FAILED)
+            {
+               cgmi_event_emit(pSess, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+               bNotified = TRUE;
+            }
+         }
+
+         // an asynchronous load waiting for preroll always has to hear about the failure
+         if ( TRUE == bLoadPending && FALSE == bNotified )
+         {
+            cgmi_event_emit(pSess, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+         }
+
+         g_error_free( error );
+
+         break;
+      }
+      case GST_MESSAGE_STATE_CHANGED:
+      {
+         /* only check message from the pipeline */
+         if( GST_MESSAGE_SRC(msg) == GST_OBJECT(pSess->pipeline) )
+         {
+            GstState old_state, new_state, pending_state;
+
+            gst_message_parse_state_changed( msg, &old_state, &new_state, &pending_state );
+            g_print("Pipeline state change from %s to %s\n", gst_element_state_get_name(old_state), gst_element_state_get_name(new_state));
+            cgmi_cache_state( pSess, new_state, pending_state );
+
+            if( GST_STATE_READY == old_state && GST_STATE_PAUSED == new_state )
+            {
+               cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PAUSED, pSess->diagIndex, pSess->playbackURI, 0);
+            }
+
+            /* Print position and duration when in playing state */
+            if( GST_STATE_PLAYING == new_state )
+            {
+               //debug_cisco_gst_streamDurPos(pSess);
+               if ( NULL == pSess->videoSink )
+               {
+                  GstElement *videoSink = NULL;
+                  GstElement *innerSink = NULL;
+                  g_object_get( pSess->pipeline, "video-sink", &videoSink, NULL );
+                  if ( NULL != videoSink )
+                  {
+                     g_print("Found element class (%s), handle = %p\n", G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(videoSink)), videoSink);
+                     if ( GST_IS_BIN(videoSink) )
+                     {
+                        innerSink = cgmi_gst_find_element( GST_BIN(videoSink), "videosink" );
+                        if ( NULL != innerSink )
+                        {
+                           pSess->videoSink = innerSink;
+                        }
+                     }
+                     else
+                     {
+                        pSess->videoSink = videoSink;
+                     }
+                     gst_object_unref( videoSink );
+                  }
+               }
+               if ( NULL != pSess->videoSink )
+               {
+                  gchar dim[64];
+                  snprintf( dim, sizeof(dim), "%d,%d,%d,%d,%d,%d,%d,%d",
+                            pSess->vidSrcRect.x, pSess->vidSrcRect.y, pSess->vidSrcRect.w, pSess->vidSrcRect.h,
+                            pSess->vidDestRect.x, pSess->vidDestRect.y, pSess->vidDestRect.w, pSess->vidDestRect.h);
+                  g_object_set( G_OBJECT(pSess->videoSink), "window_set", dim, NULL );
+               }
+               if((NULL == pSess->hwVideoDecHandle) && (NULL == pSess->hwAudioDecHandle))
+               {
+                  cgmi_GetHwDecHandles(pSess);
+               }
+               /* For RTP live content, the full gst pipeline is only created when set to playing state */
+               pSess->hasFullGstPipeline = TRUE;
+            }
+         }
+      }
+      break;
+
+      default:
+      /* unhandled message */
+      break;
+   } //end of switch
+   return TRUE;
+}
+
+//
+// Fingerprint of the PSI content cgmi uses.  The demux hands out parsed
+// PAT/PMT objects rather than the sections, so their CRC_32 is not available
+// and the fields are hashed (FNV-1a) instead.
+//
+#define PSI_HASH_INIT 2166136261u
+
+static guint32 cgmi_psi_hash( guint32 hash, const void *data, gsize len )
+{
+   const guchar *p = (const guchar *)data;
+
+   while ( len-- > 0 )
+   {
+      hash ^= *p++;
+      hash *= 16777619u;
+   }
+   return hash;
+}
+
+static guint32 cgmi_psi_hash_uint( guint32 hash, guint value )
+{
+   return cgmi_psi_hash( hash, &value, sizeof(value) );
+}
+
+//
+// Picks the audio and subtitle streams matching the requested or default
+// language, unless one is selected already.  Called with psiMutex held.
+//
+static void cgmi_psi_select_languages( tSession *pSess, const tPsiTables *psi )
+{
+   gint i;
+
+   for ( i = 0; i < pSess->psiNumPmtAudio && pSess->audioLanguageIndex == INVALID_INDEX; i++ )
+   {
+      const tAudioLang *lang = &psi->audioLanguages[i];
+
+      if ( strlen(pSess->newAudioLanguage) > 0 )
+      {
+         if ( strncmp(lang->isoCode, pSess->newAudioLanguage, 3) == 0 )
+         {
+            g_print("Stream (%d) audio language matched to selected audio lang %s\n", lang->index, pSess->newAudioLanguage);
+            pSess->audioLanguageIndex = lang->index;
+            g_strlcpy(pSess->currAudioLanguage, lang->isoCode, sizeof(pSess->currAudioLanguage));
+         }
+      }
+      else if ( strlen(pSess->defaultAudioLanguage) > 0 )
+      {
+         if ( strncasecmp(lang->isoCode, pSess->defaultAudioLanguage, 3) == 0 )
+         {
+            g_print("Stream (%d) audio language matched to default audio lang %s\n", lang->index, pSess->defaultAudioLanguage);
+            pSess->audioLanguageIndex = lang->index;
+            g_strlcpy(pSess->currAudioLanguage, lang->isoCode, sizeof(pSess->currAudioLanguage));
+         }
+      }
+   }
+
+   if ( strlen(pSess->defaultSubtitleLanguage) == 0 )
+      return;
+
+   // like audioLanguageIndex this is the index of the elementary stream
+   for ( i = 0; i < psi->numStreams && pSess->subtitleLanguageIndex == INVALID_INDEX; i++ )
+   {
+      gint k;
+
+      for ( k = 0; k < psi->numSubtitleLanguages; k++ )
+      {
+         if ( psi->subtitleInfo[k].pid == psi->streams[i].pid &&
+              strncmp(psi->subtitleInfo[k].isoCode, pSess->defaultSubtitleLanguage, 3) == 0 )
+         {
+            g_print("Stream (%d) subtitle language matched to default subtitle lang %s\n", i, pSess->defaultSubtitleLanguage);
+            pSess->subtitleLanguageIndex = i;
+            break;
+         }
+      }
+   }
+}
+
+//
+// Publishes a snapshot with the tables of psi that differ from the current
+// one and returns the CGMI_PSI_CHANGED_ bits for them.  The audio or
+// subtitle selection is dropped and picked again when its table changed.
+//
+static guint cgmi_psi_apply( tSession *pSess, const tPsiTables *psi )
+{
+   tPsiSnapshot *snap;
+   const tPsiTables *cur;
+   guint changed = 0;
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+
+   cur = (NULL != pSess->psiSnapshot) ? &pSess->psiSnapshot->tables : &gPsiEmpty.tables;
+   snap = cgmi_psi_snapshot_copy( pSess );
+
+   if ( psi->numStreams != cur->numStreams ||
+        memcmp(psi->streams, cur->streams, psi->numStreams * sizeof(tCgmiStream)) != 0 )
+   {
+      memcpy( snap->tables.streams, psi->streams, sizeof(psi->streams) );
+      snap->tables.numStreams = psi->numStreams;
+      changed |= CGMI_PSI_CHANGED_STREAMS;
+   }
+
+   // discrete audio entries appended by cgmi_queryDiscreteAudioInfo are not compared
+   if ( psi->numAudioLanguages != pSess->psiNumPmtAudio ||
+        memcmp(psi->audioLanguages, cur->audioLanguages, psi->numAudioLanguages * sizeof(tAudioLang)) != 0 )
+   {
+      memcpy( snap->tables.audioLanguages, psi->audioLanguages, sizeof(psi->audioLanguages) );
+      snap->tables.numAudioLanguages = psi->numAudioLanguages;
+      pSess->psiNumPmtAudio = psi->numAudioLanguages;
+      pSess->bQueryDiscreteAudioInfo = TRUE;
+      // before preroll the query waits for ASYNC_DONE
+      if ( TRUE == pSess->hasFullGstPipeline )
+         cgmi_psi_audio_schedule( pSess );
+      pSess->audioLanguageIndex = INVALID_INDEX;
+      changed |= CGMI_PSI_CHANGED_AUDIO;
+   }
+
+   if ( psi->numSubtitleLanguages != cur->numSubtitleLanguages ||
+        memcmp(psi->subtitleInfo, cur->subtitleInfo, psi->numSubtitleLanguages * sizeof(tSubtitleInfo)) != 0 )
+   {
+      memcpy( snap->tables.subtitleInfo, psi->subtitleInfo, sizeof(psi->subtitleInfo) );
+      snap->tables.numSubtitleLanguages = psi->numSubtitleLanguages;
+      pSess->subtitleLanguageIndex = INVALID_INDEX;
+      changed |= CGMI_PSI_CHANGED_SUBTITLE;
+   }
+
+   if ( psi->numClosedCaptionServices != cur->numClosedCaptionServices ||
+        memcmp(psi->closedCaptionServices, cur->closedCaptionServices,
+               psi->numClosedCaptionServices * sizeof(tCCLang)) != 0 )
+   {
+      memcpy( snap->tables.closedCaptionServices, psi->closedCaptionServices, sizeof(psi->closedCaptionServices) );
+      snap->tables.numClosedCaptionServices = psi->numClosedCaptionServices;
+      changed |= CGMI_PSI_CHANGED_CLOSED_CAPTION;
+   }
+
+   if ( 0 != changed )
+   {
+      if ( changed & (CGMI_PSI_CHANGED_AUDIO | CGMI_PSI_CHANGED_SUBTITLE) )
+         cgmi_psi_select_languages( pSess, &snap->tables );
+      cgmi_psi_snapshot_publish( pSess, snap );
+   }
+   else
+   {
+      cgmi_psi_snapshot_put( snap );
+   }
+
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   return changed;
+}
+
+//
+// Tail of PSI processing shared by the psi-info handler and the raw PMT
+// filter.  Re-selects the audio stream and re-checks for video when the
+// streams changed, then reports the result.
+//
+static void cgmi_psi_report( tSession *pSess, GObject *demux, guint changed, gboolean firstPsi )
+{
+   unsigned int videoStream;
+
+   if ( TRUE == firstPsi || (changed & (CGMI_PSI_CHANGED_STREAMS | CGMI_PSI_CHANGED_AUDIO)) )
+   {
+      if ( pSess->audioLanguageIndex != INVALID_INDEX )
+      {
+         g_print("Selecting audio language index %d...\n", pSess->audioLanguageIndex);
+         g_object_set( demux, "audio-stream", pSess->audioLanguageIndex, NULL );
+      }
+      else
+        g_object_get( demux, "audio-stream", &pSess->audioLanguageIndex, NULL );
+   }
+
+   // with cached PSI, NOTIFY_PSI_READY went out when the demux was added
+   if ( TRUE == firstPsi && FALSE == pSess->psiFromCache )
+      cgmi_event_emit(pSess, NOTIFY_PSI_READY, 0);
+   else if ( 0 != changed )
+      cgmi_event_emit(pSess, NOTIFY_PSI_CHANGED, changed);
+
+   if ( TRUE == firstPsi || (changed & CGMI_PSI_CHANGED_STREAMS) )
+   {
+      g_object_get( demux, "video-stream", &videoStream, NULL );
+      if ( -1 == videoStream )
+      {
+         g_print("Stream has no video!\n");
+         pSess->noVideo = TRUE;
+      }
+      else
+      {
+         pSess->noVideo = FALSE;
+      }
+   }
+}
+
+//
+// Program cache.  Every program of the PAT has an entry in psiPrograms, in
+// PAT order.  Demuxes that support section filters get an internal filter
+// on each PMT PID, the sections are decoded by cgmi-psi.c into the entry, so
+// a repeated PMT costs a CRC_32 compare.  The selected program's tables are
+// applied to the session as they change, the others are kept for
+// cgmi_SelectProgram.  Entries are guarded by psiMutex, their filters by
+// psiFilterMutex (taken in that order), and filters are only opened and
+// closed on the session context, never from the demux callbacks.
+//
+static tPsiProgramEntry *cgmi_psi_program_find( tSession *pSess, guint program, gint *pIndex )
+{
+   tPsiProgramEntry *prog;
+   gint i;
+
+   for ( i = 0; NULL != pSess->psiPrograms && i < pSess->psiPrograms->len; i++ )
+   {
+      prog = g_ptr_array_index( pSess->psiPrograms, i );
+      if ( prog->programNumber == program )
+      {
+         if ( NULL != pIndex )
+            *pIndex = i;
+         return prog;
+      }
+   }
+
+   return NULL;
+}
+
+static gboolean cgmi_psi_program_cached( tSession *pSess, guint program )
+{
+   tPsiProgramEntry *prog;
+   gboolean cached;
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+   prog = cgmi_psi_program_find( pSess, program, NULL );
+   cached = (NULL != prog && TRUE == prog->valid);
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   return cached;
+}
+
+//
+// Makes psiPrograms follow the PAT.  Entries whose program and PMT PID are
+// unchanged are kept along with their PMT and filter, the ones that left
+// are queued for cgmi_psi_filter_open to close.
+//
+static void cgmi_psi_programs_update( tSession *pSess, GValueArray *patInfo )
+{
+   GPtrArray *programs;
+   tPsiProgramEntry *prog;
+   GObject *entry;
+   guint program, pid;
+   gint i, j;
+
+   programs = g_ptr_array_sized_new( patInfo->n_values );
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+
+   for ( i = 0; i < patInfo->n_values; i++ )
+   {
+      entry = (GObject*)g_value_get_object( g_value_array_get_nth(patInfo, i) );
+      g_object_get( entry, "program-number", &program, "pid", &pid, NULL );
+
+      prog = NULL;
+      for ( j = 0; NULL != pSess->psiPrograms && j < pSess->psiPrograms->len; j++ )
+      {
+         tPsiProgramEntry *old = g_ptr_array_index( pSess->psiPrograms, j );
+         if ( old->programNumber == program && old->pmtPid == pid )
+         {
+            prog = g_ptr_array_remove_index( pSess->psiPrograms, j );
+            break;
+         }
+      }
+
+      if ( NULL == prog )
+      {
+         prog = g_new0( tPsiProgramEntry, 1 );
+         prog->pSess = pSess;
+         prog->programNumber = program;
+         prog->pmtPid = pid;
+      }
+
+      g_ptr_array_add( programs, prog );
+   }
+
+   if ( NULL != pSess->psiPrograms )
+   {
+      if ( NULL == pSess->psiStalePrograms )
+         pSess->psiStalePrograms = g_ptr_array_new();
+      for ( j = 0; j < pSess->psiPrograms->len; j++ )
+         g_ptr_array_add( pSess->psiStalePrograms, g_ptr_array_index(pSess->psiPrograms, j) );
+      g_ptr_array_free( pSess->psiPrograms, TRUE );
+   }
+   pSess->psiPrograms = programs;
+
+   g_rec_mutex_unlock(&pSess->psiMutex);
+}
+
+static cgmi_Status cgmi_psi_section_buffer( void *pUserData, void *pFilterPriv, void *pFilterId,
+                                            char **ppBuffer, int *pBufferSize )
+{
+   tPsiProgramEntry *prog = (tPsiProgramEntry*)pFilterPriv;
+
+   if ( *pBufferSize > MAX_PSI_SECTION_SIZE )
+      return CGMI_ERROR_BAD_PARAM;
+
+   *ppBuffer = (char *)prog->section;
+   *pBufferSize = sizeof(prog->section);
+
+   return CGMI_ERROR_SUCCESS;
+}
+
+static cgmi_Status cgmi_psi_section_ready( void *pUserData, void *pFilterPriv, void *pFilterId,
+                                           cgmi_Status sectionStatus, char *pSection, int sectionSize )
+{
+   tPsiProgramEntry *prog = (tPsiProgramEntry*)pFilterPriv;
+   tSession *pSess = prog->pSess;
+   tPsiPmtHeader pmt;
+   cgmi_Status stat = CGMI_ERROR_SUCCESS;
+   guint changed = 0;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE || NULL == pSess->demux )
+      return CGMI_ERROR_INVALID_HANDLE;
+
+   if ( CGMI_ERROR_SUCCESS != sectionStatus )
+      return sectionStatus;
+
+   // Never block the streaming thread here: cgmi_SetAudioStream holds psiMutex
+   // across cgmi_Unload, which destroys this filter and waits for the thread.
+   // The PMT repeats, a section skipped now is decoded from the next one.
+   if ( FALSE == g_rec_mutex_trylock(&pSess->psiMutex) )
+      return CGMI_ERROR_SUCCESS;
+
+   do
+   {
+      // a repeat of the PMT cached last
+      if ( TRUE == prog->valid &&
+           cgmi_psi_section_crc((const guchar *)pSection, sectionSize) == prog->pmtCrc )
+         break;
+
+      stat = cgmi_psi_parse_pmt( (const guchar *)pSection, sectionSize, &pmt, &pSess->psiRaw );
+      if ( CGMI_ERROR_SUCCESS != stat )
+         break;
+
+      if ( pmt.programNumber != prog->programNumber )
+         break;
+
+      memcpy( &prog->pmt, &pSess->psiRaw, sizeof(tPsiTables) );
+      prog->pmtVersion = pmt.version;
+      prog->pmtCrc = pmt.crc;
+      prog->valid = TRUE;
+
+      // the first PSI is taken from psi-info, reconciled there against the PSI cache
+      if ( prog->programNumber != pSess->psiPmtProgram || FALSE == pSess->psiValid )
+         break;
+
+      changed = cgmi_psi_apply( pSess, &prog->pmt );
+      pSess->psiPmtVersion = pmt.version;
+      // psi-info's hash is of the PMT it applied last, not this one
+      pSess->psiPmtHash = PSI_HASH_INIT;
+      if ( TRUE == pSess->psiSwitchPending )
+      {
+         changed |= CGMI_PSI_CHANGED_SELECTED_PROGRAM;
+         pSess->psiSwitchPending = FALSE;
+      }
+      if ( 0 != changed )
+      {
+         cgmi_psi_cache_remember( pSess, prog->programNumber, &prog->pmt );
+         g_print("PMT: Program: %04x Version: %d pcr: %04x Streams: %d changed: 0x%x\n",
+                 (guint16)pmt.programNumber, pmt.version, (guint16)pmt.pcrPid, prog->pmt.numStreams, changed);
+      }
+   }while(0);
+
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   if ( 0 != changed )
+      cgmi_psi_report( pSess, G_OBJECT(pSess->demux), changed, FALSE );
+
+   return stat;
+}
+
+// psiFilterMutex held, psiMutex not, the filters may still be delivering
+static void cgmi_psi_programs_free( tSession *pSess, GPtrArray *programs )
+{
+   tPsiProgramEntry *prog;
+   gint i;
+
+   if ( NULL == programs )
+      return;
+
+   for ( i = 0; i < programs->len; i++ )
+   {
+      prog = g_ptr_array_index( programs, i );
+      if ( NULL != prog->filterId )
+      {
+         cgmi_StopSectionFilter( pSess->handle, prog->filterId );
+         cgmi_DestroySectionFilter( pSess->handle, prog->filterId );
+      }
+      g_free( prog );
+   }
+
+   g_ptr_array_free( programs, TRUE );
+}
+
+// psiFilterMutex held
+static void cgmi_psi_program_filter( tSession *pSess, tPsiProgramEntry *prog )
+{
+   tcgmi_FilterData filterData;
+   guchar value = PSI_TABLE_ID_PMT;
+   guchar mask = 0xFF;
+   void *filterId = NULL;
+
+   if ( CGMI_ERROR_SUCCESS != cgmi_CreateSectionFilter(pSess->handle, prog->pmtPid, prog, &filterId) )
+   {
+      g_print("%s:Could not open a section filter for PMT pid 0x%04x\n", __FUNCTION__, prog->pmtPid);
+      return;
+   }
+
+   filterData.value = &value;
+   filterData.mask = &mask;
+   filterData.length = 1;
+   filterData.comparitor = FILTER_COMP_EQUAL;
+
+   if ( CGMI_ERROR_SUCCESS != cgmi_SetSectionFilter(pSess->handle, filterId, &filterData) ||
+        CGMI_ERROR_SUCCESS != cgmi_StartSectionFilter(pSess->handle, filterId, 0, FALSE, TRUE,
+                                                      cgmi_psi_section_buffer, cgmi_psi_section_ready) )
+   {
+      g_print("%s:Could not start the PMT section filter\n", __FUNCTION__);
+      cgmi_DestroySectionFilter( pSess->handle, filterId );
+      return;
+   }
+
+   g_print("Following program %d PMT pid 0x%04x through a section filter\n", prog->programNumber, prog->pmtPid);
+   prog->filterId = filterId;
+}
+
+// runs on the session context, not in the demux callback that asked for it
+static gboolean cgmi_psi_filter_open( gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+   GPtrArray *stale = NULL;
+   GPtrArray *pending;
+   tPsiProgramEntry *prog;
+   gint i;
+
+   // psiMutex first, cgmi_SetAudioStream holds it across cgmi_Unload
+   g_rec_mutex_lock(&pSess->psiMutex);
+   g_mutex_lock( &pSess->psiFilterMutex );
+
+   do
+   {
+      // cgmi_psi_filter_close got here first
+      if ( TRUE == g_source_is_destroyed(g_main_current_source()) )
+      {
+         g_rec_mutex_unlock(&pSess->psiMutex);
+         break;
+      }
+
+      g_source_unref( pSess->psiFilterSource );
+      pSess->psiFilterSource = NULL;
+
+      pending = g_ptr_array_new();
+
+      // entries stay allocated until a filter pass or cgmi_psi_filter_close frees them
+      stale = pSess->psiStalePrograms;
+      pSess->psiStalePrograms = NULL;
+      for ( i = 0; NULL != pSess->psiPrograms && i < pSess->psiPrograms->len; i++ )
+      {
+         prog = g_ptr_array_index( pSess->psiPrograms, i );
+         // program 0 points at the network PID
+         if ( NULL == prog->filterId && 0 != prog->programNumber )
+            g_ptr_array_add( pending, prog );
+      }
+      g_rec_mutex_unlock(&pSess->psiMutex);
+
+      cgmi_psi_programs_free( pSess, stale );
+
+      for ( i = 0; i < pending->len; i++ )
+      {
+         cgmi_psi_program_filter( pSess, g_ptr_array_index(pending, i) );
+      }
+
+      g_ptr_array_free( pending, TRUE );
+
+   }while(0);
+
+   g_mutex_unlock( &pSess->psiFilterMutex );
+
+   return FALSE;
+}
+
+static void cgmi_psi_filter_schedule( tSession *pSess )
+{
+   g_mutex_lock( &pSess->psiFilterMutex );
+
+   if ( NULL == pSess->psiFilterSource )
+   {
+      pSess->psiFilterSource = g_idle_source_new();
+      g_source_set_callback( pSess->psiFilterSource, cgmi_psi_filter_open, pSess, NULL );
+      g_source_attach( pSess->psiFilterSource, pSess->thread_ctx );
+   }
+
+   g_mutex_unlock( &pSess->psiFilterMutex );
+}
+
+static void cgmi_psi_filter_close( tSession *pSess )
+{
+   GPtrArray *programs, *stale;
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+   g_mutex_lock( &pSess->psiFilterMutex );
+
+   if ( NULL != pSess->psiFilterSource )
+   {
+      g_source_destroy( pSess->psiFilterSource );
+      g_source_unref( pSess->psiFilterSource );
+      pSess->psiFilterSource = NULL;
+   }
+
+   programs = pSess->psiPrograms;
+   stale = pSess->psiStalePrograms;
+   pSess->psiPrograms = NULL;
+   pSess->psiStalePrograms = NULL;
+   pSess->psiPmtProgram = 0;
+   pSess->psiSwitchPending = FALSE;
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   cgmi_psi_programs_free( pSess, programs );
+   cgmi_psi_programs_free( pSess, stale );
+
+   g_mutex_unlock( &pSess->psiFilterMutex );
+}
+
+//
+// PSI cache.  The selected program's tables are remembered per load URI by
+// cgmi-psi.c.  Loading a known URI publishes them at once, the demux is
+// pointed at the cached program and audio stream as soon as it shows up,
+// and NOTIFY_PSI_READY goes out without waiting for PAT/PMT.  The first
+// live PSI is reconciled against the cached tables in cgmi_gst_psi_info,
+// any difference is reported with NOTIFY_PSI_CHANGED.
+//
+static void cgmi_psi_cache_seed( tSession *pSess, const gchar *uri )
+{
+   tPsiTables *psi = g_malloc( sizeof(tPsiTables) );
+
+   g_strlcpy( pSess->psiCacheKey, uri, sizeof(pSess->psiCacheKey) );
+   pSess->psiFromCache = cgmi_psi_cache_lookup( uri, &pSess->psiCacheProgram,
+                                                &pSess->psiCacheProgramIndex, psi );
+   if ( TRUE == pSess->psiFromCache )
+   {
+      g_print("Using cached PSI for program %d, %d streams\n", pSess->psiCacheProgram, psi->numStreams);
+      cgmi_psi_apply( pSess, psi );
+   }
+
+   g_free( psi );
+}
+
+static void cgmi_psi_cache_preset( tSession *pSess, GstElement *demux )
+{
+   g_object_set( G_OBJECT(demux), "program-number", pSess->psiCacheProgramIndex, NULL );
+   if ( pSess->audioLanguageIndex != INVALID_INDEX )
+   {
+      g_print("Selecting cached audio language index %d...\n", pSess->audioLanguageIndex);
+      g_object_set( G_OBJECT(demux), "audio-stream", pSess->audioLanguageIndex, NULL );
+   }
+
+   cgmi_event_emit( pSess, NOTIFY_PSI_READY, 0 );
+}
+
+// psi holds the PMT tables of program, the selected one
+static void cgmi_psi_cache_remember( tSession *pSess, guint program, const tPsiTables *psi )
+{
+   gint index;
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+   if ( NULL != cgmi_psi_program_find(pSess, program, &index) )
+   {
+      cgmi_psi_cache_store( pSess->psiCacheKey, program, index + 1, psi );
+   }
+   g_rec_mutex_unlock(&pSess->psiMutex);
+}
+
+//
+// psi-info handler.  The demux repeats PAT/PMT for as long as it plays, so
+// the content is fingerprinted first and only a PAT or PMT that differs from
+// the last one applied is decoded.  The first one is reported with
+// NOTIFY_PSI_READY, later changes with NOTIFY_PSI_CHANGED.
+//
+static void cgmi_gst_psi_info( GObject *obj, guint size, void *context, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+   GValueArray *patInfo = NULL;
+   GValueArray *streamInfos = NULL;
+   GValueArray *descriptors = NULL;
+   GObject *entry = NULL;
+   GObject *pmtInfo = NULL, *streamInfo = NULL;
+   GString *string;
+   guint program, pid, version, pcrPid, esPid, esType;
+   guint entryProgram, cachedIndex = 1;
+   guint32 patHash = PSI_HASH_INIT, pmtHash = PSI_HASH_INIT;
+   guint changed = 0;
+   gboolean firstPsi;
+   tPsiTables *psi = NULL;
+   gint i, j, z;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return;
+   }
+
+   if ( NULL == pSess->demux )
+   {
+      g_print("%s:Invalid demux handle\n", __FUNCTION__);
+      return;
+   }
+
+   firstPsi = (FALSE == pSess->psiValid);
+
+   if ( TRUE == firstPsi )
+   {
+      cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PAT_PMT_ACQUIRED, pSess->diagIndex, pSess->playbackURI, 0);
+
+      g_print("Enabling server side trick mode...\n");
+      g_object_set( obj, "server-side-trick-mode", TRUE, NULL );
+
+      /* Set the Program Index you want.
+         Note that this is not the same as program number. It is the 1-based index from the
+         beginning of list of available PMTs in the PAT. Therefore, for instance, if there
+         are 3 programs in the PAT with program numbers 11, 12, and 13 in order, to select
+         program number 12, program needs to be set to 2 (i.e., second program from the beginning) */
+
+      /* We select the first program by default, or the one the PSI cache is for */
+      g_object_set( obj, "program-number", (TRUE == pSess->psiFromCache) ? pSess->psiCacheProgramIndex : 1, NULL );
+   }
+
+   do
+   {
+      g_object_get( obj, "pat-info", &patInfo, NULL );
+      g_object_get( obj, "pmt-info", &pmtInfo, NULL );
+      if ( NULL == patInfo || NULL == pmtInfo )
+      {
+         g_print("%s:PAT/PMT not available yet\n", __FUNCTION__);
+         break;
+      }
+
+      g_object_get( pmtInfo, "program-number", &program, NULL );
+
+      for ( i = 0; i < patInfo->n_values; i++ )
+      {
+         entry = (GObject*)g_value_get_object( g_value_array_get_nth(patInfo, i) );
+         g_object_get( entry, "program-number", &entryProgram, "pid", &pid, NULL );
+         patHash = cgmi_psi_hash_uint( patHash, entryProgram );
+         patHash = cgmi_psi_hash_uint( patHash, pid );
+         if ( TRUE == pSess->psiFromCache && entryProgram == pSess->psiCacheProgram )
+            cachedIndex = i + 1;
+      }
+
+      // the multiplex changed since the PSI was cached, follow the program or fall back to the first
+      if ( TRUE == firstPsi && TRUE == pSess->psiFromCache && cachedIndex != pSess->psiCacheProgramIndex )
+      {
+         g_print("Cached program %d moved to PAT position %d\n", pSess->psiCacheProgram, cachedIndex);
+         pSess->psiCacheProgramIndex = cachedIndex;
+         g_object_set( obj, "program-number", cachedIndex, NULL );
+         break;
+      }
+
+      if ( TRUE == firstPsi || patHash != pSess->psiPatHash )
+      {
+         cgmi_psi_programs_update( pSess, patInfo );
+
+         // from here on the PMTs come straight from the demux
+         if ( NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(obj), "section-filter") )
+            cgmi_psi_filter_schedule( pSess );
+      }
+
+      if ( TRUE == firstPsi )
+      {
+         pSess->psiPmtProgram = program;
+      }
+      else if ( program != pSess->psiPmtProgram )
+      {
+         // still the program cgmi_SelectProgram switched away from
+         break;
+      }
+
+      // the PMT itself is followed through the section filter
+      if ( FALSE == firstPsi && patHash == pSess->psiPatHash && TRUE == cgmi_psi_program_cached(pSess, program) )
+      {
+         break;
+      }
+
+      // a repeat of the PMT applied here last, the version number says so
+      // without copying the stream-info and descriptor arrays out
+      g_object_get( pmtInfo, "version-number", &version, NULL );
+      if ( FALSE == firstPsi && patHash == pSess->psiPatHash &&
+           version == pSess->psiPmtVersion && PSI_HASH_INIT != pSess->psiPmtHash )
+      {
+         break;
+      }
+
+      g_object_get( pmtInfo, "pcr-pid", &pcrPid, "stream-info", &streamInfos, NULL );
+      if ( NULL == streamInfos )
+         break;
+
+      pmtHash = cgmi_psi_hash_uint( pmtHash, pcrPid );
+      for ( j = 0; j < streamInfos->n_values; j++ )
+      {
+         streamInfo = (GObject*) g_value_get_object( g_value_array_get_nth(streamInfos, j) );
+         g_object_get( streamInfo, "pid", &esPid, "stream-type", &esType, "descriptors", &descriptors, NULL );
+         pmtHash = cgmi_psi_hash_uint( pmtHash, esPid );
+         pmtHash = cgmi_psi_hash_uint( pmtHash, esType );
+         for ( z = 0; NULL != descriptors && z < descriptors->n_values; z++ )
+         {
+            string = (GString *)g_value_get_boxed( g_value_array_get_nth(descriptors, z) );
+            pmtHash = cgmi_psi_hash( pmtHash, string->str, string->len );
+         }
+         if ( NULL != descriptors )
+         {
+            g_value_array_free( descriptors );
+            descriptors = NULL;
+         }
+      }
+
+      // a new version number with the same content
+      if ( FALSE == firstPsi && patHash == pSess->psiPatHash && pmtHash == pSess->psiPmtHash )
+      {
+         pSess->psiPmtVersion = version;
+         break;
+      }
+
+      if ( FALSE == firstPsi && patHash != pSess->psiPatHash )
+         changed |= CGMI_PSI_CHANGED_PROGRAMS;
+
+      // first PMT of a program cgmi_SelectProgram had no cached PMT for,
+      // unless the section filter applied it already
+      g_rec_mutex_lock(&pSess->psiMutex);
+      if ( TRUE == pSess->psiSwitchPending )
+      {
+         changed |= CGMI_PSI_CHANGED_SELECTED_PROGRAM;
+         pSess->psiSwitchPending = FALSE;
+      }
+      g_rec_mutex_unlock(&pSess->psiMutex);
+
+      g_print("PAT: Total Entries: %d \n", patInfo->n_values);
+      g_print("Default Audio Language: %s\n", pSess->defaultAudioLanguage);
+      g_print("PMT: Program: %04x Version: %d pcr: %04x Streams: %d\n",
+              (guint16)program, version, (guint16)pcrPid, streamInfos->n_values);
+
+      psi = g_malloc0( sizeof(tPsiTables) );
+      psi->numStreams = MIN( streamInfos->n_values, MAX_STREAMS );
+
+      for ( j = 0; j < psi->numStreams; j++ )
+      {
+         streamInfo = (GObject*) g_value_get_object( g_value_array_get_nth(streamInfos, j) );
+         g_object_get( streamInfo, "pid", &esPid, "stream-type", &esType, "descriptors", &descriptors, NULL );
+         g_print("Pid: %04x type: %x Descriptors: %d\n",(guint16)esPid, (guint8) esType,
+                 descriptors ? descriptors->n_values : 0);
+
+         psi->streams[j].pid = esPid;
+         psi->streams[j].streamType = esType;
+
+         for ( z = 0; NULL != descriptors && z < descriptors->n_values; z++ )
+         {
+            string = (GString *)g_value_get_boxed( g_value_array_get_nth(descriptors, z) );
+            cgmi_psi_parse_descriptors( psi, j, esPid, esType, (const guchar *)string->str, string->len );
+         }
+         if ( NULL != descriptors )
+         {
+            g_value_array_free( descriptors );
+            descriptors = NULL;
+         }
+      }
+      g_print ("------------------------------------------------------------------------- \n");
+
+      changed |= cgmi_psi_apply( pSess, psi );
+      cgmi_psi_cache_remember( pSess, program, psi );
+      g_free( psi );
+
+      // the cached PSI was stale, pick the streams again from the live one
+      if ( TRUE == pSess->psiFromCache &&
+           (changed & (CGMI_PSI_CHANGED_STREAMS | CGMI_PSI_CHANGED_AUDIO | CGMI_PSI_CHANGED_SUBTITLE)) )
+      {
+         tPsiSnapshot *snap;
+
+         g_rec_mutex_lock(&pSess->psiMutex);
+         pSess->audioLanguageIndex = INVALID_INDEX;
+         pSess->subtitleLanguageIndex = INVALID_INDEX;
+         snap = cgmi_psi_snapshot_get( pSess );
+         cgmi_psi_select_languages( pSess, &snap->tables );
+         cgmi_psi_snapshot_put( snap );
+         g_rec_mutex_unlock(&pSess->psiMutex);
+      }
+
+      pSess->psiPatHash = patHash;
+      pSess->psiPmtVersion = version;
+      pSess->psiPmtHash = pmtHash;
+      pSess->psiValid = TRUE;
+
+      cgmi_psi_report( pSess, obj, changed, firstPsi );
+      pSess->psiFromCache = FALSE;
+   }while(0);
+
+   if ( NULL != streamInfos )
+      g_value_array_free( streamInfos );
+   if ( NULL != pmtInfo )
+      g_object_unref( pmtInfo );
+   if ( NULL != patInfo )
+      g_value_array_free( patInfo );
+
+   /*
+   if ( FALSE == pSess->autoPlay )
+   {
+      g_mutex_lock (pSess->autoPlayMutex);
+      if ( pSess->videoStreamIndex == INVALID_INDEX && pSess->audioStreamIndex == INVALID_INDEX )
+      {
+         pSess->waitingOnPids = TRUE;
+         g_cond_wait (pSess->autoPlayCond, pSess->autoPlayMutex);
+      }
+      g_mutex_unlock (pSess->autoPlayMutex);
+   }
+   */
+}
+
+static GstElement *cgmi_gst_find_element( GstBin *bin, gchar *ename )
+{
+   GstElement *element = NULL;
+   GstElement *handle = NULL;
+   GstIterator *iter = NULL;
+#if GST_CHECK_VERSION(1,0,0)
+   GValue item = G_VALUE_INIT;
+#else
+   void *item;
+#endif
+   gchar *name = NULL;
+   gboolean done = FALSE;
+
+   iter = gst_bin_iterate_elements( bin );
+   while ( FALSE == done )
+   {
+      switch ( gst_iterator_next(iter, &item) )
+      {
+         case GST_ITERATOR_OK:
+#if GST_CHECK_VERSION(1,0,0)
+            element = (GstElement *)g_value_get_object(&item);
+#else
+            element = (GstElement *)item;
+#endif
+            if ( NULL != element )
+            {
+               name = gst_element_get_name( element );
+               if ( NULL != name )
+               {
+                  if ( NULL != strstr(name, ename) )
+                  {
+                     handle = element;
+                     g_print("Found element (%s) handle = %p\n", ename, handle);
+                     done = TRUE;
+                  }
+                  g_free( name );
+               }
+#if !GST_CHECK_VERSION(1,0,0)
+               gst_object_unref( item );
+#endif
+            }
+#if GST_CHECK_VERSION(1,0,0)
+            g_value_reset( &item );
+#endif
+            break;
+         case GST_ITERATOR_RESYNC:
+            gst_iterator_resync( iter );
+            break;
+         case GST_ITERATOR_ERROR:
+            done = TRUE;
+            break;
+         case GST_ITERATOR_DONE:
+            done = TRUE;
+            break;
+      }
+   }
+#if GST_CHECK_VERSION(1,0,0)
+   g_value_unset( &item );
+#endif
+   gst_iterator_free( iter );
+
+   return handle;
+}
+static void cgmi_gst_tune_source( GstElement *source )
+{
+   GstElement *souphttpsrc = NULL;
+   const gchar *name;
+
+   name = G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(source));
+
+   if ( NULL != name )
+   {
+      g_print("Source element class: %s\n", name);
+      if ( NULL != strstr(name, "GstUDPSrc") )
+      {
+         if ( NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(source), "buffer-size") )
+         {
+            g_print("Setting socket receiver buffer size to %d\n", SOCKET_RECEIVE_BUFFER_SIZE);
+            g_object_set( source, "buffer-size", SOCKET_RECEIVE_BUFFER_SIZE, NULL );
+         }
+         if ( NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(source), "chunk-size") )
+         {
+            g_print("Setting UDP chunk size to %d\n", UDP_CHUNK_SIZE);
+            g_object_set( source, "chunk-size", UDP_CHUNK_SIZE, NULL );
+         }
+      }
+      else if ( NULL != strstr(name, "GstSoupHTTPSrc") )
+      {
+         souphttpsrc = source;
+         // if we have just souphttpsrc let's set the blocksize to something larger than the default 4k
+         g_print("souphttpsrc has been detected, increasing the blocksize to: %u bytes\n", DEFAULT_BLOCKSIZE );
+         g_object_set (souphttpsrc, "blocksize", DEFAULT_BLOCKSIZE, NULL);
+      }
+   }
+}
+
+void cgmi_gst_notify_source( GObject *obj, GParamSpec *param, gpointer data )
+{
+   GstElement *source = NULL;
+   tSession *pSess = (tSession*)data;
+
+   g_print("notify-source\n");
+
+   g_object_get( obj, "source", &source, NULL );
+   if ( NULL == source )
+      return;
+
+   pSess->source = source;
+
+   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_SOURCE_CREATED, pSess->diagIndex, pSess->playbackURI, 0);
+
+   cgmi_gst_tune_source( source );
+
+   gst_object_unref( source );
+}
+
+//
+// Roles cgmi cares about in an autoplugged pipeline.  Elements are classified
+// once, when they are added, from their own name (or factory name if the
+// application renamed them) instead of re-scanning the parent bin for every
+// role on each element-added callback.
+//
+typedef enum
+{
+   ELEMENT_ROLE_NONE = 0,
+   ELEMENT_ROLE_HLS_DEMUX,
+   ELEMENT_ROLE_DEMUX,
+   ELEMENT_ROLE_VIDEO_SINK,
+   ELEMENT_ROLE_VIDEO_DECODER,
+   ELEMENT_ROLE_AUDIO_DECODER
+}tElementRole;
+
+static const struct
+{
+   const gchar    *match;
+   tElementRole   role;
+} gElementRoleTable[] =
+{
+   { "ciscdemux",    ELEMENT_ROLE_HLS_DEMUX },
+   { "tsdemux",      ELEMENT_ROLE_DEMUX },
+   { "videosink",    ELEMENT_ROLE_VIDEO_SINK },
+   { "videodecoder", ELEMENT_ROLE_VIDEO_DECODER },
+   { "audiodecoder", ELEMENT_ROLE_AUDIO_DECODER },
+};
+
+static tElementRole cgmi_gst_classify_element( GstElement *element )
+{
+   GstElementFactory *factory = NULL;
+   const gchar *name = GST_ELEMENT_NAME( element );
+   const gchar *factoryName = NULL;
+   guint i;
+
+   factory = gst_element_get_factory( element );
+   if ( NULL != factory )
+   {
+      factoryName = GST_OBJECT_NAME( factory );
+   }
+
+   for ( i = 0; i < G_N_ELEMENTS(gElementRoleTable); i++ )
+   {
+      if ( (NULL != name && NULL != strstr(name, gElementRoleTable[i].match)) ||
+           (NULL != factoryName && NULL != strstr(factoryName, gElementRoleTable[i].match)) )
+      {
+         return gElementRoleTable[i].role;
+      }
+   }
+
+   return ELEMENT_ROLE_NONE;
+}
+
+static void cgmi_gst_element_added( GstBin *bin, GstElement *element, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
+
+   g_print("Element added: %s\n", GST_ELEMENT_NAME(element));
+
+   switch ( cgmi_gst_classify_element(element) )
+   {
+      case ELEMENT_ROLE_HLS_DEMUX:
+         if ( NULL != pSess->hlsDemux )
+            break;
+         pSess->hlsDemux = element;
+         g_print("Found element (ciscdemux) handle = %p\n", element);
+         GST_WARNING("setting audio language: %s\n", pSess->newAudioLanguage);
+         if(strlen(pSess->newAudioLanguage) > 0)
+         {
+            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", pSess->newAudioLanguage, NULL );
+         }
+         else if(strlen(pSess->defaultAudioLanguage) > 0)
+         {
+            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", pSess->defaultAudioLanguage, NULL );
+         }
+         break;
+
+      case ELEMENT_ROLE_DEMUX:
+         if ( NULL != pSess->demux )
+            break;
+         pSess->demux = element;
+         g_print("Found element (tsdemux) handle = %p\n", element);
+         cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_DEMUX_ADDED, pSess->diagIndex, pSess->playbackURI, 0);
+         g_signal_connect( element, "psi-info", G_CALLBACK(cgmi_gst_psi_info), data );
+         g_signal_connect( element, "no-more-pads", G_CALLBACK (cgmi_gst_no_more_pads), data );
+         if ( TRUE == pSess->psiFromCache )
+         {
+            cgmi_psi_cache_preset( pSess, element );
+         }
+         break;
+
+      case ELEMENT_ROLE_VIDEO_SINK:
+         if ( NULL != pSess->videoSink )
+            break;
+         pSess->videoSink = element;
+         g_print("Found element (videosink) handle = %p\n", element);
+         break;
+
+      case ELEMENT_ROLE_VIDEO_DECODER:
+         if ( NULL != pSess->videoDecoder )
+            break;
+         pSess->videoDecoder = element;
+         g_print("Muting video decoder...\n");
+         g_object_set( G_OBJECT(pSess->videoDecoder), "decoder_mute", TRUE, NULL );
+#if !defined (DISABLE_MONITORING)
+         cgmi_monitor_watch_decoder( pSess, element );
+#endif
+         break;
+
+      case ELEMENT_ROLE_AUDIO_DECODER:
+         if ( NULL != pSess->audioDecoder )
+            break;
+         pSess->audioDecoder = element;
+         g_print("Muting audio decoder...\n");
+         g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", TRUE, NULL );
+#if !defined (DISABLE_MONITORING)
+         cgmi_monitor_watch_decoder( pSess, element );
+#endif
+         break;
+
+      default:
+         break;
+   }
+
+#if !GST_CHECK_VERSION(1,10,0)
+   // Without deep-element-added we need to hook every bin ourselves so this
+   // callback is called when elements are added further down.
+   if ( GST_IS_BIN(element) )
+   {
+      g_print("Element (%s) is a bin", GST_ELEMENT_NAME(element));
+      g_signal_connect( element, "element-added", G_CALLBACK(cgmi_gst_element_added), pSess );
+   }
+#endif
+}
+
+#if GST_CHECK_VERSION(1,10,0)
+static void cgmi_gst_deep_element_added( GstBin *bin, GstBin *subBin, GstElement *element, gpointer data )
+{
+   cgmi_gst_element_added( subBin, element, data );
+}
+#endif
+
+//
+// Watch for elements added anywhere below the pipeline.  deep-element-added
+// is emitted on the top level bin for the whole hierarchy so one connection
+// is enough; older GStreamer falls back to hooking each bin as it appears.
+//
+static void cgmi_gst_connect_element_added( tSession *pSess, GstElement *pipeline )
+{
+#if GST_CHECK_VERSION(1,10,0)
+   g_signal_connect( pipeline, "deep-element-added",
+      G_CALLBACK(cgmi_gst_deep_element_added), pSess );
+#else
+   g_signal_connect( pipeline, "element-added",
+      G_CALLBACK(cgmi_gst_element_added), pSess );
+#endif
+}
+
+//
+// Resolve the uri the caller gave us into the one handed to playbin.  DLNA
+// content needs dlna+ prepended to the protocol for the pipeline to autoplug.
+//
+static cgmi_Status cgmi_resolve_playback_uri( const char *uri, gchar *playbackURI, gboolean *bisDLNAContent )
+{
+   cgmi_Status stat = CGMI_ERROR_SUCCESS;
+
+   *bisDLNAContent = FALSE;
+
+   //
+   // check to see if this is a DLNA url.
+   //
+   if (0 == strncmp(uri, "http", 4))
+   {
+      stat = cgmi_utils_is_content_dlna(uri, bisDLNAContent);
+      if(CGMI_ERROR_SUCCESS != stat)
+      {
+         printf("Not able to determine whether the content is DLNA\n");
+         return stat;
+      }
+   }
+
+   if (*bisDLNAContent == TRUE)
+   {
+      //for the gstreamer pipeline to autoplug we have to add
+      //dlna+ to the protocol.
+      g_snprintf(playbackURI, MAX_URI_SIZE, "%s%s","dlna+", uri);
+   }
+   else
+   {
+      g_strlcpy(playbackURI, uri, MAX_URI_SIZE);
+   }
+
+   return stat;
+}
+
+//
+// Probe the platform once and keep the element factories and settings playbin
+// is built from.  Looking plugins and factories up takes the registry lock,
+// this used to be done (through the parser) on every cgmi_Load.
+//
+static void cgmi_gst_init_launch_template( tLaunchTemplate *pTemplate )
+{
+   GstPlugin *plugin;
+
+   memset(pTemplate, 0, sizeof(tLaunchTemplate));
+
+   pTemplate->playbinFactory = gst_element_factory_find( PLAYBIN_ELEMENT );
+   if ( NULL == pTemplate->playbinFactory )
+   {
+      GST_ERROR("No %s element factory, pipelines can not be created\n", PLAYBIN_ELEMENT);
+   }
+
+#if RDK_EMULATOR
+
+   // The  comcast emulator doesn't set priority correctly for the video sink to autoplug
+   // until a patch is put in for this, just set the video-sink to be
+   // the below
+   // RMS
+   pTemplate->videoSinkFactory = gst_element_factory_find( "fbdevsink" );
+   if ( NULL == pTemplate->videoSinkFactory )
+   {
+      GST_ERROR("No fbdevsink element factory\n");
+   }
+#endif
+   // let's see if we are running on broadcom hardware if we are let's see if we can find there
+   // video sink.  If it's there we need to set the flags variable so the pipeline knows to do
+   // color transformation and scaling in hardware
+#if GST_CHECK_VERSION(1,0,0)
+   plugin = gst_registry_find_plugin( gst_registry_get() , "brcmvideosink");
+#else
+   plugin = gst_registry_find_plugin( gst_registry_get_default() , "brcmvideosink");
+#endif
+   if ( NULL != plugin )
+   {
+      pTemplate->bisBroadcomHw = TRUE;
+      g_print("Autoplugging on real broadcom hardware\n");
+      pTemplate->flags = 0x63;
+      gst_object_unref( plugin );
+   }
+
+   pTemplate->bInitialized = TRUE;
+}
+
+static void cgmi_gst_clear_launch_template( tLaunchTemplate *pTemplate )
+{
+   if ( NULL != pTemplate->playbinFactory )
+   {
+      gst_object_unref( pTemplate->playbinFactory );
+   }
+   if ( NULL != pTemplate->videoSinkFactory )
+   {
+      gst_object_unref( pTemplate->videoSinkFactory );
+   }
+   memset(pTemplate, 0, sizeof(tLaunchTemplate));
+}
+
+//
+// Instantiate playbin straight from the cached factories.  Without a uri it
+// has to be set on playbin before going to PAUSED.
+//
+static GstElement *cgmi_gst_create_playbin( const gchar *playbackURI )
+{
+   GstElement *pipeline;
+   GstElement *videoSink;
+
+   if ( FALSE == gLaunchTemplate.bInitialized )
+   {
+      GST_WARNING("Launch template not initialized, was cgmi_Init called?\n");
+      cgmi_gst_init_launch_template( &gLaunchTemplate );
+   }
+
+   if ( NULL == gLaunchTemplate.playbinFactory )
+   {
+      GST_WARNING("PipeLine was not able to be created\n");
+      g_print("Missing these plugins:\n%s\n", PLAYBIN_ELEMENT);
+      return NULL;
+   }
 
-         g_error_free( error );
+   pipeline = gst_element_factory_create( gLaunchTemplate.playbinFactory, NULL );
+   if ( NULL == pipeline )
+   {
+      GST_WARNING("PipeLine was not able to be created\n");
+      return NULL;
+   }
 
-         break;
-      }
-      case GST_MESSAGE_STATE_CHANGED:
-      {
-         /* only check message from the pipeline */
-         if( GST_MESSAGE_SRC(msg) == GST_OBJECT(pSess->pipeline) )
-         {
-            GstState old_state, new_state, pending_state;
+   if ( NULL != playbackURI )
+   {
+      g_object_set( G_OBJECT(pipeline), "uri", playbackURI, NULL );
+   }
 
-            gst_message_parse_state_changed( msg, &old_state, &new_state, &pending_state );
-            g_print("Pipeline state change from %s to %s\n", gst_element_state_get_name(old_state), gst_element_state_get_name(new_state));
+   if ( 0 != gLaunchTemplate.flags )
+   {
+      g_object_set( G_OBJECT(pipeline), "flags", gLaunchTemplate.flags, NULL );
+   }
 
-            /* Print position and duration when in playing state */
-            if( GST_STATE_PLAYING == new_state )
-            {
-               //debug_cisco_gst_streamDurPos(pSess);
-               if ( NULL == pSess->videoSink )
-               {
-                  GstElement *videoSink = NULL;
-                  GstElement *innerSink = NULL;
-                  g_object_get( pSess->pipeline, "video-sink", &videoSink, NULL );
-                  if ( NULL != videoSink )
-                  {
-                     g_print("Found element class (%s), handle = %p\n", G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(videoSink)), videoSink);
-                     if ( GST_IS_BIN(videoSink) )
-                     {
-                        innerSink = cgmi_gst_find_element( GST_BIN(videoSink), "videosink" );
-                        if ( NULL != innerSink )
-                        {
-                           pSess->videoSink = innerSink;
-                        }
-                     }
-                     else
-                     {
-                        pSess->videoSink = videoSink;
-                     }
-                     gst_object_unref( videoSink );
-                  }
-               }
-               if ( NULL != pSess->videoSink )
-               {
-                  gchar dim[64];
-                  snprintf( dim, sizeof(dim), "%d,%d,%d,%d,%d,%d,%d,%d",
-                            pSess->vidSrcRect.x, pSess->vidSrcRect.y, pSess->vidSrcRect.w, pSess->vidSrcRect.h,
-                            pSess->vidDestRect.x, pSess->vidDestRect.y, pSess->vidDestRect.w, pSess->vidDestRect.h);
-                  g_object_set( G_OBJECT(pSess->videoSink), "window_set", dim, NULL );
-               }
-               if((NULL == pSess->hwVideoDecHandle) && (NULL == pSess->hwAudioDecHandle))
-               {
-                  cgmi_GetHwDecHandles(pSess);
-               }
-               /* For RTP live content, the full gst pipeline is only created when set to playing state */
-               pSess->hasFullGstPipeline = TRUE;
-            }
-         }
+#if RDK_EMULATOR
+   if ( NULL == gLaunchTemplate.videoSinkFactory )
+   {
+      GST_WARNING("PipeLine was not able to be created\n");
+      g_print("Missing these plugins:\n%s\n", "fbdevsink");
+      gst_object_unref( pipeline );
+      return NULL;
+   }
+#endif
+   if ( NULL != gLaunchTemplate.videoSinkFactory )
+   {
+      videoSink = gst_element_factory_create( gLaunchTemplate.videoSinkFactory, NULL );
+      if ( NULL == videoSink )
+      {
+         GST_WARNING("Video sink was not able to be created\n");
+         gst_object_unref( pipeline );
+         return NULL;
       }
-      break;
+      g_object_set( G_OBJECT(pipeline), "video-sink", videoSink, NULL );
+   }
 
-      default:
-      /* unhandled message */
-      break;
-   } //end of switch
-   return TRUE;
+   return pipeline;
 }
 
-static void cgmi_gst_psi_info( GObject *obj, guint size, void *context, gpointer data )
+//
+// The HEAD request deciding between dlna+ and plain http can take up to the
+// curl timeouts, run it while the pipeline is created instead of before.
+//
+static gpointer cgmi_dlna_probe_thread( gpointer data )
 {
-   tSession *pSess = (tSession*)data;
-   unsigned int videoStream;
+   tDlnaProbe *pProbe = (tDlnaProbe*)data;
 
-   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   pProbe->stat = cgmi_resolve_playback_uri(pProbe->uri, pProbe->playbackURI, &pProbe->bisDLNAContent);
+   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_DLNA_PROBE_END, pProbe->diagIndex, pProbe->uri, 0);
+
+   return pProbe;
+}
+
+static tDlnaProbe *cgmi_dlna_probe_start( tSession *pSess, const char *uri )
+{
+   tDlnaProbe *pProbe;
+   GError *error = NULL;
+
+   // answered without a request, the caller resolves the uri in line
+   if ( TRUE == cgmi_utils_is_dlna_detect_cached(uri) )
    {
-      g_print("%s:Invalid session handle\n", __FUNCTION__);
-      return;
+      return NULL;
    }
 
-   g_print("on_psi_info:\n");
+   pProbe = g_malloc0(sizeof(tDlnaProbe));
+   if ( NULL == pProbe )
+   {
+      return NULL;
+   }
 
-   GValueArray *patInfo = NULL;
-   GObject *entry = NULL;
-   guint pid;
+   g_strlcpy(pProbe->uri, uri, MAX_URI_SIZE);
+   pProbe->diagIndex = pSess->diagIndex;
 
-   GObject *pmtInfo = NULL, *streamInfo = NULL;
-   GValueArray *streamInfos = NULL;
-   GValueArray *descriptors = NULL;
-   gint i, j, z;
-   GValue *value;
-   guint program, version, pcrPid, esPid, esType;
+   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_DLNA_PROBE_START, pProbe->diagIndex, pProbe->uri, 0);
 
-   if ( NULL == pSess->demux )
+   pProbe->thread = g_thread_try_new("cgmi-dlna-probe", cgmi_dlna_probe_thread, pProbe, &error);
+   if ( NULL == pProbe->thread )
    {
-      g_print("%s:Invalid demux handle\n", __FUNCTION__);
-      return;
+      GST_WARNING("Could not start probe thread (%s), probing in line\n",
+                  (NULL != error) ? error->message : "unknown error");
+      if ( NULL != error )
+      {
+         g_error_free(error);
+      }
+      cgmi_dlna_probe_thread(pProbe);
    }
 
-   cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PAT_PMT_ACQUIRED, pSess->diagIndex, pSess->playbackURI, 0);
+   return pProbe;
+}
 
-   g_print("Enabling server side trick mode...\n");
-   g_object_set( obj, "server-side-trick-mode", TRUE, NULL );
+static cgmi_Status cgmi_dlna_probe_finish( tSession *pSess, tDlnaProbe *pProbe )
+{
+   cgmi_Status stat;
 
-   g_rec_mutex_lock(&pSess->psiMutex);
-   pSess->bQueryDiscreteAudioInfo = TRUE;
-   pSess->numAudioLanguages = 0;
+   if ( NULL != pProbe->thread )
+   {
+      g_thread_join(pProbe->thread);
+   }
 
-   /* Get PAT Info */
-   g_object_get( obj, "pat-info", &patInfo, NULL );
+   stat = pProbe->stat;
+   if ( CGMI_ERROR_SUCCESS == stat )
+   {
+      pSess->bisDLNAContent = pProbe->bisDLNAContent;
+      g_strlcpy(pSess->playbackURI, pProbe->playbackURI, MAX_URI_SIZE);
+   }
 
-   g_print("PAT: Total Entries: %d \n", patInfo->n_values);
-   g_print("------------------------------------------------------------------------- \n");
+   g_free(pProbe);
 
-   for ( i = 0; i < patInfo->n_values; i++ )
-   {
-      value = g_value_array_get_nth( patInfo, i );
-      entry = (GObject*)g_value_get_object( value );
-      g_object_get( entry, "program-number", &program, NULL );
-      g_object_get( entry, "pid", &pid, NULL );
-      g_print("Program: %04x pid: %04x\n", program, pid);
+   return stat;
+}
 
-      /* Set the Program Index you want.
-         Note that this is not the same as program number. It is the 1-based index from the
-         beginning of list of available PMTs in the PAT. Therefore, for instance, if there
-         are 3 programs in the PAT with program numbers 11, 12, and 13 in order, to select
-         program number 12, program needs to be set to 2 (i.e., second program from the beginning) */
+//
+// Preload (shadow pipeline) support.  While a pipeline sits in the preload
+// slot it must not touch the session's element handles or PSI tables, those
+// still belong to whatever is currently loaded.  The preload callbacks below
+// only keep the decoders muted and remember whether PSI has been seen; the
+// session takes the elements over in cgmi_preload_adopt when cgmi_Load swaps
+// the pipeline in.
+//
+static void cgmi_gst_preload_psi_info( GObject *obj, guint size, void *context, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
 
-      /* We select the first program by default */
-      g_object_set( obj, "program-number", 1, NULL );
+   g_print("Preload: PSI acquired for %s\n", pSess->preloadURI);
+   g_atomic_int_set( &pSess->preloadPsiReady, TRUE );
+}
 
-      g_object_get( obj, "pmt-info", &pmtInfo, NULL );
+static void cgmi_gst_preload_notify_source( GObject *obj, GParamSpec *param, gpointer data )
+{
+   GstElement *source = NULL;
 
-      g_object_get( pmtInfo, "program-number", &program, NULL );
-      g_object_get( pmtInfo, "version-number", &version, NULL );
-      g_object_get( pmtInfo, "pcr-pid", &pcrPid, NULL );
-      g_object_get( pmtInfo, "stream-info", &streamInfos, NULL );
-      g_object_get( pmtInfo, "descriptors", &descriptors, NULL );
+   g_object_get( obj, "source", &source, NULL );
+   if ( NULL == source )
+      return;
 
-      g_print("Default Audio Language: %s\n", pSess->defaultAudioLanguage);
+   cgmi_gst_tune_source( source );
 
-      g_print("PMT: Program: %04x Version: %d pcr: %04x Streams: %d " "Descriptors: %d\n",
-              (guint16)program, version, (guint16)pcrPid, streamInfos->n_values, descriptors->n_values);
+   gst_object_unref( source );
+}
 
-      pSess->numStreams = streamInfos->n_values;
+static void cgmi_gst_preload_element_added( GstBin *bin, GstElement *element, gpointer data )
+{
+   tSession *pSess = (tSession*)data;
 
-      for ( j = 0; j < streamInfos->n_values; j++ )
-      {
-         value = g_value_array_get_nth( streamInfos, j );
-         streamInfo = (GObject*) g_value_get_object( value );
-         g_object_get( streamInfo, "pid", &esPid, NULL );
-         g_object_get( streamInfo, "stream-type", &esType, NULL);
-         g_object_get( streamInfo, "descriptors", &descriptors, NULL);
-         g_print("Pid: %04x type: %x Descriptors: %d\n",(guint16)esPid, (guint8) esType, descriptors->n_values);
-
-         pSess->streams[j].pid = esPid;
-         pSess->streams[j].streamType = esType;
-
-         for ( z = 0; z < descriptors->n_values; z++ )
-         {
-            GString *string;
-            value = g_value_array_get_nth( descriptors, z );
-            string = (GString *)g_value_get_boxed( value );
-            gint len, pos;
-            gint totalLen = string->len;
-            pos = 0;
-            while ( totalLen > 2 )
-            {
-               len = (guint8)string->str[pos + 1];
-               g_print("descriptor # %d tag %02x len %d\n", z, (guint8)string->str[pos], len);
-               switch ( (guint8)string->str[pos] )
-               {
-                  case 0x0A: /* ISO_639_language_descriptor */
-                  {
-                     g_print("Found audio language descriptor for stream %d\n", j);
-                     if ( pSess->numAudioLanguages < MAX_AUDIO_LANGUAGE_DESCRIPTORS && len >= 4 )
-                     {
-                        pSess->audioLanguages[pSess->numAudioLanguages].pid = esPid;
-                        pSess->audioLanguages[pSess->numAudioLanguages].streamType = esType;
-                        pSess->audioLanguages[pSess->numAudioLanguages].index = j;
-                        strncpy( pSess->audioLanguages[pSess->numAudioLanguages].isoCode, &string->str[pos+2], 3 );
-                        pSess->audioLanguages[pSess->numAudioLanguages].isoCode[3] = 0;
-                        pSess->audioLanguages[pSess->numAudioLanguages].bDiscrete = FALSE;
-
-                        if ( pSess->audioLanguageIndex == INVALID_INDEX && strlen(pSess->newAudioLanguage) > 0)
-                        {
-                           if ( strncmp(pSess->audioLanguages[pSess->numAudioLanguages].isoCode, pSess->newAudioLanguage, 3) == 0 )
-                           {
-                              g_print("Stream (%d) audio language matched to selected audio lang %s\n", j, pSess->newAudioLanguage);
-                              pSess->audioLanguageIndex = j;
-                              g_strlcpy(pSess->currAudioLanguage, pSess->audioLanguages[pSess->numAudioLanguages].isoCode,
-                                    sizeof(pSess->currAudioLanguage));
-                           }
-                        }
+   switch ( cgmi_gst_classify_element(element) )
+   {
+      case ELEMENT_ROLE_VIDEO_DECODER:
+      case ELEMENT_ROLE_AUDIO_DECODER:
+         g_print("Preload: muting decoder %s...\n", GST_ELEMENT_NAME(element));
+         g_object_set( G_OBJECT(element), "decoder_mute", TRUE, NULL );
+         break;
 
-                        if ( pSess->audioLanguageIndex == INVALID_INDEX && strlen(pSess->newAudioLanguage) == 0 &&
-                              strlen(pSess->defaultAudioLanguage) > 0 )
-                        {
-                           if ( strncasecmp(pSess->audioLanguages[pSess->numAudioLanguages].isoCode, pSess->defaultAudioLanguage, 3) == 0 )
-                           {
-                              g_print("Stream (%d) audio language matched to default audio lang %s\n", j, pSess->defaultAudioLanguage);
-                              pSess->audioLanguageIndex = j;
-                              g_strlcpy(pSess->currAudioLanguage, pSess->audioLanguages[pSess->numAudioLanguages].isoCode,
-                                    sizeof(pSess->currAudioLanguage));
-                           }
-                        }
-                        pSess->numAudioLanguages++;
-                     }
-                     else
-                     {
-                        g_print("Maximum number of audio language descriptors %d has been reached!!!\n",
-                                MAX_AUDIO_LANGUAGE_DESCRIPTORS);
-                     }
-                  }
-                  break;
+      case ELEMENT_ROLE_DEMUX:
+         g_signal_connect( element, "psi-info", G_CALLBACK(cgmi_gst_preload_psi_info), pSess );
+         break;
 
-                  case 0x59: /* Subtitling descriptor */
-                  {
-                     g_print("Found subtitle language descriptor for stream %d\n", j);
-                     if ( pSess->numSubtitleLanguages < MAX_SUBTITLE_LANGUAGES && len >= 8 )
-                     {
-                        pSess->subtitleInfo[pSess->numSubtitleLanguages].pid = esPid;
-                        strncpy(pSess->subtitleInfo[pSess->numSubtitleLanguages].isoCode, &string->str[pos + 2], 3);
-                        pSess->subtitleInfo[pSess->numSubtitleLanguages].isoCode[3] = 0;
-                        pSess->subtitleInfo[pSess->numSubtitleLanguages].type = string->str[pos + 5];
-                        pSess->subtitleInfo[pSess->numSubtitleLanguages].compPageId = (gushort)(((gushort)string->str[pos + 6] << 8) | string->str[pos + 7]);
-                        pSess->subtitleInfo[pSess->numSubtitleLanguages].ancPageId = (gushort)(((gushort)string->str[pos + 8] << 8) | string->str[pos + 9]);
-                        if ( strlen(pSess->defaultSubtitleLanguage) > 0 && pSess->subtitleLanguageIndex == INVALID_INDEX )
-                        {
-                           if ( strncmp(pSess->subtitleInfo[pSess->numSubtitleLanguages].isoCode, pSess->defaultSubtitleLanguage, 3) == 0 )
-                           {
-                              g_print("Stream (%d) subtitle language matched to default subtitle lang %s\n", j, pSess->defaultSubtitleLanguage);
-                              pSess->subtitleLanguageIndex = j;
-                           }
-                        }
+      default:
+         break;
+   }
 
-                        pSess->numSubtitleLanguages++;
-                     }
-                  }
-                  break;
+#if !GST_CHECK_VERSION(1,10,0)
+   if ( GST_IS_BIN(element) )
+   {
+      g_signal_connect( element, "element-added", G_CALLBACK(cgmi_gst_preload_element_added), pSess );
+   }
+#endif
+}
 
-                  case 0x86: /* Closed Caption Service Descriptor */
-                  {
-                     gint i;
-                     gchar *data;
-                     g_print("Found closed caption service descriptor for stream %d\n", j);
+#if GST_CHECK_VERSION(1,10,0)
+static void cgmi_gst_preload_deep_element_added( GstBin *bin, GstBin *subBin, GstElement *element, gpointer data )
+{
+   cgmi_gst_preload_element_added( subBin, element, data );
+}
+#endif
 
-                     pSess->numClosedCaptionServices = string->str[pos+2] & 0x1F;
+static void cgmi_preload_discard( tSession *pSess )
+{
+   if ( NULL == pSess->preloadPipeline )
+      return;
 
-                     if ( pSess->numClosedCaptionServices > MAX_CLOSED_CAPTION_SERVICES )
-                     {
-                        g_print("Maximum number of closed caption descriptors %d has been reached!!!\n",
-                                MAX_CLOSED_CAPTION_SERVICES);
-                        pSess->numClosedCaptionServices = MAX_CLOSED_CAPTION_SERVICES;
-                     }
+   g_print("Discarding preloaded pipeline for %s\n", pSess->preloadURI);
+   // the reaper takes it to NULL, a load about to use the decoders waits for it
+   cgmi_reaper_queue( pSess, pSess->preloadPipeline, NULL );
 
-                     data = &string->str[pos + 3];
+   pSess->preloadPipeline = NULL;
+   pSess->preloadURI[0] = '\0';
+   pSess->preloadPlaybackURI[0] = '\0';
+   pSess->preloadIsDLNAContent = FALSE;
+   g_atomic_int_set( &pSess->preloadPsiReady, FALSE );
+}
 
-                     g_print("Found %d closed caption languages\n", pSess->numClosedCaptionServices);
+//
+// cgmi_Preload takes no cpBlob or session settings, so its pipeline only
+// stands in for a load that passes none either.  The AudioLanguage setting,
+// for one, has to be in place before the demux picks its audio stream.
+//
+static gboolean cgmi_preload_matches( tSession *pSess, const char *uri, cpBlobStruct *cpblob,
+                                      const char *sessionSettings )
+{
+   if ( NULL == pSess->preloadPipeline || 0 != g_strcmp0(uri, pSess->preloadURI) )
+      return FALSE;
 
-                     for ( i = 0; i < pSess->numClosedCaptionServices; i++ )
-                     {
-                        memset( pSess->closedCaptionServices[i].isoCode, 0, 4 );
-                        memcpy( pSess->closedCaptionServices[i].isoCode, data, 3 );
+   if ( NULL != cpblob || (NULL != sessionSettings && '\0' != sessionSettings[0]) )
+   {
+      g_print("Preloaded pipeline for %s was built without this load's cpBlob/settings\n", uri);
+      return FALSE;
+   }
 
-                        data += 3;
+   return TRUE;
+}
 
-                        if ( *data & 0x80 )
-                        {
-                           pSess->closedCaptionServices[i].isDigital = TRUE;
-                           pSess->closedCaptionServices[i].serviceNum = *data & 0x3F;
-                        }
-                        else
-                        {
-                           pSess->closedCaptionServices[i].isDigital = FALSE;
-                           //Code field number into service number
-                           pSess->closedCaptionServices[i].serviceNum = *data & 0x01;
-                        }
+//
+// Hand every element of a (now active) preloaded pipeline over to the regular
+// session callbacks, exactly as if they had been added during cgmi_Load.
+//
+static void cgmi_preload_adopt( tSession *pSess )
+{
+   GstElement *element = NULL;
+   GstObject *parent = NULL;
+   GstIterator *iter = NULL;
+#if GST_CHECK_VERSION(1,0,0)
+   GValue item = G_VALUE_INIT;
+#else
+   void *item;
+#endif
+   gboolean done = FALSE;
 
-                        data += 3;
+#if GST_CHECK_VERSION(1,10,0)
+   g_signal_handlers_disconnect_by_func( pSess->pipeline, cgmi_gst_preload_deep_element_added, pSess );
+#else
+   g_signal_handlers_disconnect_by_func( pSess->pipeline, cgmi_gst_preload_element_added, pSess );
+#endif
+   g_signal_handlers_disconnect_by_func( pSess->pipeline, cgmi_gst_preload_notify_source, pSess );
 
-                        g_print("Caption[%d]: lang: %s, Digital: %d, Service num: %d\n", i,
-                           pSess->closedCaptionServices[i].isoCode,
-                           pSess->closedCaptionServices[i].isDigital,
-                           pSess->closedCaptionServices[i].serviceNum);
-                     }
-                  }
-                  break;
+   cgmi_gst_connect_element_added( pSess, pSess->pipeline );
 
-                  default:
-                     break;
+   g_signal_connect( pSess->pipeline, "notify::source",
+      G_CALLBACK(cgmi_gst_notify_source), pSess );
 
+   iter = gst_bin_iterate_recurse( GST_BIN(pSess->pipeline) );
+   while ( FALSE == done )
+   {
+      switch ( gst_iterator_next(iter, &item) )
+      {
+         case GST_ITERATOR_OK:
+#if GST_CHECK_VERSION(1,0,0)
+            element = (GstElement *)g_value_get_object(&item);
+#else
+            element = (GstElement *)item;
+#endif
+            if ( NULL != element )
+            {
+               parent = gst_object_get_parent( GST_OBJECT(element) );
+               if ( NULL != parent )
+               {
+                  cgmi_gst_element_added( GST_BIN(parent), element, pSess );
+                  gst_object_unref( parent );
                }
 
-               pos += len + 2;
-               totalLen = totalLen - len - 2;
+               g_signal_handlers_disconnect_by_func( element, cgmi_gst_preload_element_added, pSess );
+               g_signal_handlers_disconnect_by_func( element, cgmi_gst_preload_psi_info, pSess );
+#if !GST_CHECK_VERSION(1,0,0)
+               gst_object_unref( item );
+#endif
             }
-         }
+#if GST_CHECK_VERSION(1,0,0)
+            g_value_reset( &item );
+#endif
+            break;
+         case GST_ITERATOR_RESYNC:
+            gst_iterator_resync( iter );
+            break;
+         case GST_ITERATOR_ERROR:
+            done = TRUE;
+            break;
+         case GST_ITERATOR_DONE:
+            done = TRUE;
+            break;
       }
-      g_print ("------------------------------------------------------------------------- \n");
    }
+#if GST_CHECK_VERSION(1,0,0)
+   g_value_unset( &item );
+#endif
+   gst_iterator_free( iter );
 
-   g_rec_mutex_unlock(&pSess->psiMutex);
+   // pick up the source element, it was created before we were listening
+   cgmi_gst_notify_source( G_OBJECT(pSess->pipeline), NULL, pSess );
 
-   if ( pSess->audioLanguageIndex != INVALID_INDEX )
+   // the demux already reported PSI while we were in the preload slot, replay it
+   if ( TRUE == g_atomic_int_get(&pSess->preloadPsiReady) && NULL != pSess->demux )
    {
-      g_print("Selecting audio language index %d...\n", pSess->audioLanguageIndex);
-      g_object_set( obj, "audio-stream", pSess->audioLanguageIndex, NULL );
+      cgmi_gst_psi_info( G_OBJECT(pSess->demux), 0, NULL, pSess );
    }
-   else
-     g_object_get( obj, "audio-stream", &pSess->audioLanguageIndex, NULL );
 
-   if ( NULL != pSess->eventCB )
-      pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_PSI_READY, 0);
+   pSess->preloadURI[0] = '\0';
+   pSess->preloadPlaybackURI[0] = '\0';
+   pSess->preloadIsDLNAContent = FALSE;
+   g_atomic_int_set( &pSess->preloadPsiReady, FALSE );
+}
+
+//
+// Pipeline teardown.  Taking a hardware backed pipeline to NULL is slow, so
+// cgmi_Unload detaches the pipeline from the session and hands it to the
+// reaper pool instead of waiting for the state change itself.
+//
+static void cgmi_gst_teardown_pipeline( GstElement *pipeline, GstBus *bus )
+{
+   int refcount;
 
-   g_object_get( obj, "video-stream", &videoStream, NULL );
-   if ( -1 == videoStream )
+   if ( NULL != pipeline )
    {
-      g_print("Stream has no video!\n");
-      pSess->noVideo = TRUE;
+      g_print ("Changing state of pipeline to NULL \n");
+      gst_element_set_state (pipeline, GST_STATE_NULL);
+
+      g_print ("Deleting pipeline\n");
+      refcount = GST_OBJECT_REFCOUNT(pipeline);
+      g_print ("Pipeline ref count on tear down is %d (should be 1)\n", refcount);
+      gst_object_unref( GST_OBJECT(pipeline) );
    }
-   else
+   if ( NULL != bus )
    {
-      pSess->noVideo = FALSE;
+      gst_object_unref( GST_OBJECT(bus) );
    }
+}
 
-   /*
-   if ( FALSE == pSess->autoPlay )
-   {
-      g_mutex_lock (pSess->autoPlayMutex);
-      if ( pSess->videoStreamIndex == INVALID_INDEX && pSess->audioStreamIndex == INVALID_INDEX )
-      {
-         pSess->waitingOnPids = TRUE;
-         g_cond_wait (pSess->autoPlayCond, pSess->autoPlayMutex);
-      }
-      g_mutex_unlock (pSess->autoPlayMutex);
-   }
-   */
+static void cgmi_reaper_func( gpointer data, gpointer userData )
+{
+   tReapJob *pJob = (tReapJob*)data;
+   tSession *pSess = pJob->pSess;
+   gint64 startTime = g_get_monotonic_time();
+
+   cgmi_gst_teardown_pipeline( pJob->pipeline, pJob->bus );
+
+   g_print("Reaper: pipeline %p torn down in %lld ms (%lld ms after unload)\n", pJob->pipeline,
+           (long long)(g_get_monotonic_time() - startTime) / 1000,
+           (long long)(g_get_monotonic_time() - pJob->queuedTime) / 1000);
+
+   g_mutex_lock( &pSess->reapMutex );
+   pSess->reapPending--;
+   g_cond_broadcast( &pSess->reapCond );
+   g_mutex_unlock( &pSess->reapMutex );
+
+   g_free( pJob );
 }
 
-static GstElement *cgmi_gst_find_element( GstBin *bin, gchar *ename )
+//
+// Drop every signal handler and appsink callback that points back at the
+// session so the old pipeline can wind down without touching it.
+//
+static void cgmi_gst_detach_pipeline( tSession *pSess, GstElement *pipeline )
 {
    GstElement *element = NULL;
-   GstElement *handle = NULL;
    GstIterator *iter = NULL;
 #if GST_CHECK_VERSION(1,0,0)
    GValue item = G_VALUE_INIT;
 #else
    void *item;
 #endif
-   gchar *name = NULL;
    gboolean done = FALSE;
 
-   iter = gst_bin_iterate_elements( bin );
+   g_signal_handlers_disconnect_matched( pipeline, G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, pSess );
+
+   iter = gst_bin_iterate_recurse( GST_BIN(pipeline) );
    while ( FALSE == done )
    {
       switch ( gst_iterator_next(iter, &item) )
@@ -1066,17 +3431,7 @@ static GstElement *cgmi_gst_find_element( GstBin *bin, gchar *ename )
 #endif
             if ( NULL != element )
             {
-               name = gst_element_get_name( element );
-               if ( NULL != name )
-               {
-                  if ( NULL != strstr(name, ename) )
-                  {
-                     handle = element;
-                     g_print("Found element (%s) handle = %p\n", ename, handle);
-                     done = TRUE;
-                  }
-                  g_free( name );
-               }
+               g_signal_handlers_disconnect_matched( element, G_SIGNAL_MATCH_DATA, 0, 0, NULL, NULL, pSess );
 #if !GST_CHECK_VERSION(1,0,0)
                gst_object_unref( item );
 #endif
@@ -1101,143 +3456,595 @@ static GstElement *cgmi_gst_find_element( GstBin *bin, gchar *ename )
 #endif
    gst_iterator_free( iter );
 
-   return handle;
+   if ( NULL != pSess->userDataAppsink )
+   {
+      GstAppSinkCallbacks noCbs;
+      memset( &noCbs, 0, sizeof(noCbs) );
+      gst_app_sink_set_callbacks( GST_APP_SINK(pSess->userDataAppsink), &noCbs, NULL, NULL );
+   }
 }
-void cgmi_gst_notify_source( GObject *obj, GParamSpec *param, gpointer data )
+
+static void cgmi_reaper_queue( tSession *pSess, GstElement *pipeline, GstBus *bus )
 {
-   GstElement *source = NULL;
-   GstElement *souphttpsrc = NULL;
-   const gchar *name;
-   tSession *pSess = (tSession*)data;
+   tReapJob *pJob = NULL;
 
-   g_print("notify-source\n");
+   if ( NULL != gReaperPool )
+   {
+      pJob = g_malloc0( sizeof(tReapJob) );
+   }
 
-   g_object_get( obj, "source", &source, NULL );
-   if ( NULL == source )
+   if ( NULL == pJob )
+   {
+      cgmi_gst_teardown_pipeline( pipeline, bus );
       return;
+   }
 
-   pSess->source = source;
+   if ( NULL != pipeline )
+   {
+      cgmi_gst_detach_pipeline( pSess, pipeline );
+   }
 
-   name = G_OBJECT_CLASS_NAME(G_OBJECT_GET_CLASS(source));
+   pJob->pSess = pSess;
+   pJob->pipeline = pipeline;
+   pJob->bus = bus;
+   pJob->queuedTime = g_get_monotonic_time();
 
-   if ( NULL != name )
+   g_mutex_lock( &pSess->reapMutex );
+   pSess->reapPending++;
+   g_mutex_unlock( &pSess->reapMutex );
+
+   g_thread_pool_push( gReaperPool, pJob, NULL );
+}
+
+//
+// Block until the session's previous pipelines are gone.  Called before a
+// new pipeline starts using the decoders and before the session is freed.
+//
+static void cgmi_reaper_wait( tSession *pSess )
+{
+   gint64 startTime = 0;
+
+   g_mutex_lock( &pSess->reapMutex );
+   if ( 0 < pSess->reapPending )
    {
-      g_print("Source element class: %s\n", name);
-      if ( NULL != strstr(name, "GstUDPSrc") )
-      {
-         if ( NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(source), "buffer-size") )
-         {
-            g_print("Setting socket receiver buffer size to %d\n", SOCKET_RECEIVE_BUFFER_SIZE);
-            g_object_set( source, "buffer-size", SOCKET_RECEIVE_BUFFER_SIZE, NULL );
-         }
-         if ( NULL != g_object_class_find_property(G_OBJECT_GET_CLASS(source), "chunk-size") )
-         {
-            g_print("Setting UDP chunk size to %d\n", UDP_CHUNK_SIZE);
-            g_object_set( source, "chunk-size", UDP_CHUNK_SIZE, NULL );
-         }
-      }
-      else if ( NULL != strstr(name, "GstSoupHTTPSrc") )
+      startTime = g_get_monotonic_time();
+      while ( 0 < pSess->reapPending )
       {
-         souphttpsrc = source;
-         // if we have just souphttpsrc let's set the blocksize to something larger than the default 4k
-         g_print("souphttpsrc has been detected, increasing the blocksize to: %u bytes\n", DEFAULT_BLOCKSIZE );
-         g_object_set (souphttpsrc, "blocksize", DEFAULT_BLOCKSIZE, NULL);
+         g_cond_wait( &pSess->reapCond, &pSess->reapMutex );
       }
+      g_print("Waited %lld ms for the previous pipeline teardown\n",
+              (long long)(g_get_monotonic_time() - startTime) / 1000);
    }
-
-   gst_object_unref( source );
+   g_mutex_unlock( &pSess->reapMutex );
 }
 
-static void cgmi_gst_element_added( GstBin *bin, GstElement *element, gpointer data )
+//
+// Bus dispatch.  Sessions share a small pool of dispatcher threads, each
+// running its own main context.  A session is pinned to one dispatcher for
+// its lifetime so its bus messages are still handled in order on one thread.
+//
+static void cgmi_dispatcher_pool_start( void )
 {
-   GstElement *hlsDemux = NULL;
-   GstElement *demux = NULL;
-   GstElement *videoSink = NULL;
-   GstElement *videoDecoder = NULL;
-   GstElement *audioDecoder = NULL;
-   tSession *pSess = (tSession*)data;
+   const gchar *envThreads = getenv( "CGMI_DISPATCHER_THREADS" );
+   gchar threadName[16];
+   guint numThreads;
+   guint i;
 
-   gchar *name = gst_element_get_name( element );
-   g_print("Element added: %s\n", name);
+   numThreads = ( NULL != envThreads ) ? (guint)strtoul( envThreads, NULL, 10 ) : 0;
+   if ( 0 == numThreads )
+      numThreads = g_get_num_processors();
 
-   if ( NULL == pSess->hlsDemux )
+   gDispatchers = g_new0( tDispatcher, numThreads );
+   for ( i = 0; i < numThreads; i++ )
    {
-      hlsDemux = cgmi_gst_find_element( bin, "ciscdemux" );
+      gDispatchers[i].ctx = g_main_context_new();
+      gDispatchers[i].loop = g_main_loop_new( gDispatchers[i].ctx, FALSE );
 
-      if( NULL != hlsDemux )
+      g_snprintf( threadName, sizeof(threadName), "signal_thread%u", i );
+      gDispatchers[i].thread = g_thread_new( threadName, (GThreadFunc)g_main_loop_run, gDispatchers[i].loop );
+      if ( NULL == gDispatchers[i].thread )
       {
-         pSess->hlsDemux = hlsDemux;
-         GST_WARNING("setting audio language: %s\n", pSess->newAudioLanguage);
-         if(strlen(pSess->newAudioLanguage) > 0)
-         {
-            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", pSess->newAudioLanguage, NULL );
-         }
-         else if(strlen(pSess->defaultAudioLanguage) > 0)
-         {
-            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", pSess->defaultAudioLanguage, NULL );
-         }
+         GST_WARNING("Error launching thread for gmainloop\n");
+         g_main_loop_unref( gDispatchers[i].loop );
+         g_main_context_unref( gDispatchers[i].ctx );
+         break;
       }
    }
+   gNumDispatchers = i;
 
-   // If we haven't found the demux investigate this bin
-   if ( NULL == pSess->demux )
-   {
-      demux = cgmi_gst_find_element( bin, "tsdemux" );
+   // sources can be attached before the loops spin up, they are dispatched
+   // as soon as g_main_loop_run acquires the context
+   g_print("Started %u bus dispatcher threads\n", gNumDispatchers);
+}
 
-      if( NULL != demux )
+static void cgmi_dispatcher_pool_stop( void )
+{
+   guint i;
+
+   for ( i = 0; i < gNumDispatchers; i++ )
+   {
+      if ( 0 != gDispatchers[i].numSessions )
       {
-         pSess->demux = demux;
-         g_signal_connect( demux, "psi-info", G_CALLBACK(cgmi_gst_psi_info), data );
-         g_signal_connect( demux, "no-more-pads", G_CALLBACK (cgmi_gst_no_more_pads), data );
+         GST_WARNING("Dispatcher %u still serves %d sessions\n", i, gDispatchers[i].numSessions);
       }
+      g_main_loop_quit( gDispatchers[i].loop );
+      g_thread_join( gDispatchers[i].thread );
+      g_main_loop_unref( gDispatchers[i].loop );
+      g_main_context_unref( gDispatchers[i].ctx );
    }
 
-   if ( NULL == pSess->videoSink )
+   g_free( gDispatchers );
+   gDispatchers = NULL;
+   gNumDispatchers = 0;
+}
+
+static tDispatcher *cgmi_dispatcher_acquire( void )
+{
+   tDispatcher *pDispatcher = NULL;
+   guint i;
+
+   g_mutex_lock( &gDispatcherMutex );
+   for ( i = 0; i < gNumDispatchers; i++ )
    {
-      videoSink = cgmi_gst_find_element( bin, "videosink" );
+      if ( NULL == pDispatcher || gDispatchers[i].numSessions < pDispatcher->numSessions )
+         pDispatcher = &gDispatchers[i];
+   }
+   if ( NULL != pDispatcher )
+      pDispatcher->numSessions++;
+   g_mutex_unlock( &gDispatcherMutex );
 
-      if( NULL != videoSink )
-      {
-         pSess->videoSink = videoSink;
-      }
+   return pDispatcher;
+}
+
+static void cgmi_dispatcher_release( tDispatcher *pDispatcher )
+{
+   g_mutex_lock( &gDispatcherMutex );
+   pDispatcher->numSessions--;
+   g_mutex_unlock( &gDispatcherMutex );
+}
+
+typedef struct
+{
+   GMutex   mutex;
+   GCond    cond;
+   gboolean done;
+}tDispatchBarrier;
+
+static gboolean cgmi_dispatcher_barrier_cb( gpointer data )
+{
+   tDispatchBarrier *pBarrier = (tDispatchBarrier*)data;
+
+   g_mutex_lock( &pBarrier->mutex );
+   pBarrier->done = TRUE;
+   g_cond_signal( &pBarrier->cond );
+   g_mutex_unlock( &pBarrier->mutex );
+
+   return FALSE;
+}
+
+//
+// Wait until whatever the session's dispatcher is running right now has
+// returned.  Once its sources are destroyed this guarantees none of the
+// session's callbacks is still in flight, as joining its own thread used to.
+//
+static void cgmi_dispatcher_sync( tDispatcher *pDispatcher )
+{
+   tDispatchBarrier barrier;
+   GSource *idle;
+
+   // called from one of our own callbacks, nothing else can be running
+   if ( TRUE == g_main_context_is_owner(pDispatcher->ctx) )
+      return;
+
+   g_mutex_init( &barrier.mutex );
+   g_cond_init( &barrier.cond );
+   barrier.done = FALSE;
+
+   idle = g_idle_source_new();
+   g_source_set_priority( idle, G_PRIORITY_HIGH );
+   g_source_set_callback( idle, cgmi_dispatcher_barrier_cb, &barrier, NULL );
+   g_source_attach( idle, pDispatcher->ctx );
+   g_source_unref( idle );
+
+   g_mutex_lock( &barrier.mutex );
+   while ( FALSE == barrier.done )
+      g_cond_wait( &barrier.cond, &barrier.mutex );
+   g_mutex_unlock( &barrier.mutex );
+
+   g_cond_clear( &barrier.cond );
+   g_mutex_clear( &barrier.mutex );
+}
+
+//
+// Event delivery.  eventCB used to be called straight from the bus
+// dispatcher, the monitor, streaming threads and cgmi_Load, so a slow
+// application stalled them.  Events are now pushed on a lock free list and
+// one event pool thread at a time drains a session's list in emit order.
+//
+static tEventQueue *cgmi_event_queue_new( void )
+{
+   tEventQueue *pQueue = g_malloc0( sizeof(tEventQueue) );
+
+   if ( NULL != pQueue )
+   {
+      pQueue->refCount = 1;
+      g_mutex_init( &pQueue->mutex );
+      g_cond_init( &pQueue->idleCond );
    }
+   return pQueue;
+}
 
-   if ( NULL == pSess->videoDecoder )
+static void cgmi_event_queue_ref( tEventQueue *pQueue )
+{
+   g_atomic_int_inc( &pQueue->refCount );
+}
+
+static void cgmi_event_queue_unref( tEventQueue *pQueue )
+{
+   if ( NULL == pQueue || FALSE == g_atomic_int_dec_and_test(&pQueue->refCount) )
+      return;
+
+   g_cond_clear( &pQueue->idleCond );
+   g_mutex_clear( &pQueue->mutex );
+   g_free( pQueue );
+}
+
+static void cgmi_event_dispatch_func( gpointer data, gpointer userData )
+{
+   tEventQueue *pQueue = (tEventQueue *)data;
+   tEventRecord *pList, *pOrdered, *pRec;
+   gint64 latency;
+
+   g_mutex_lock( &pQueue->mutex );
+   pQueue->dispatchThread = g_thread_self();
+   g_mutex_unlock( &pQueue->mutex );
+
+   while ( 1 )
    {
-      videoDecoder = cgmi_gst_find_element( bin, "videodecoder" );
+      do
+      {
+         pList = g_atomic_pointer_get( &pQueue->pending );
+      } while ( NULL != pList && !g_atomic_pointer_compare_and_exchange(&pQueue->pending, pList, NULL) );
 
-      if( NULL != videoDecoder )
+      if ( NULL == pList )
       {
-         pSess->videoDecoder = videoDecoder;
-         g_print("Muting video decoder...\n");
-         g_object_set( G_OBJECT(pSess->videoDecoder), "decoder_mute", TRUE, NULL );
+         g_mutex_lock( &pQueue->mutex );
+         g_atomic_int_set( &pQueue->scheduled, 0 );
+         pQueue->dispatchThread = NULL;
+         g_cond_broadcast( &pQueue->idleCond );
+         g_mutex_unlock( &pQueue->mutex );
+
+         // an emit that raced the flag being cleared may have left its event to us
+         if ( NULL == g_atomic_pointer_get(&pQueue->pending) ||
+              !g_atomic_int_compare_and_exchange(&pQueue->scheduled, 0, 1) )
+            break;
+
+         g_mutex_lock( &pQueue->mutex );
+         pQueue->dispatchThread = g_thread_self();
+         g_mutex_unlock( &pQueue->mutex );
+         continue;
+      }
+
+      // the list is newest first
+      pOrdered = NULL;
+      while ( NULL != pList )
+      {
+         pRec = pList;
+         pList = pList->next;
+         pRec->next = pOrdered;
+         pOrdered = pRec;
+      }
+
+      while ( NULL != pOrdered )
+      {
+         pRec = pOrdered;
+         pOrdered = pRec->next;
+
+         latency = g_get_monotonic_time() - pRec->queuedTime;
+         pRec->eventCB( pRec->usrParam, pRec->handle, pRec->event, pRec->code );
+         g_atomic_int_add( &pQueue->depth, -1 );
+
+         g_mutex_lock( &pQueue->mutex );
+         pQueue->numDispatched++;
+         pQueue->totalLatencyUs += latency;
+         if ( latency > pQueue->maxLatencyUs )
+            pQueue->maxLatencyUs = latency;
+         g_mutex_unlock( &pQueue->mutex );
+
+         g_slice_free( tEventRecord, pRec );
       }
    }
 
-   if ( NULL == pSess->audioDecoder )
+   // the session may have been destroyed from one of the callbacks above
+   cgmi_event_queue_unref( pQueue );
+}
+
+//
+// Never blocks on the application: the event is linked in with a CAS and
+// the first event of a burst hands the queue to the event pool.
+//
+static void cgmi_event_emit( tSession *pSess, tcgmi_Event event, uint64_t code )
+{
+   tEventQueue *pQueue = pSess->eventQueue;
+   tEventRecord *pRec;
+   gint depth, maxDepth;
+
+   if ( NULL == pSess->eventCB || NULL == pQueue )
+      return;
+
+   pRec = g_slice_new( tEventRecord );
+   pRec->eventCB = pSess->eventCB;
+   pRec->usrParam = pSess->usrParam;
+   pRec->handle = pSess->handle;
+   pRec->event = event;
+   pRec->code = code;
+   pRec->queuedTime = g_get_monotonic_time();
+
+   do
+   {
+      pRec->next = g_atomic_pointer_get( &pQueue->pending );
+   } while ( !g_atomic_pointer_compare_and_exchange(&pQueue->pending, pRec->next, pRec) );
+
+   depth = g_atomic_int_add( &pQueue->depth, 1 ) + 1;
+   do
+   {
+      maxDepth = g_atomic_int_get( &pQueue->maxDepth );
+   } while ( depth > maxDepth && !g_atomic_int_compare_and_exchange(&pQueue->maxDepth, maxDepth, depth) );
+
+   if ( g_atomic_int_compare_and_exchange(&pQueue->scheduled, 0, 1) )
+   {
+      // dropped by the dispatcher once the queue runs dry
+      cgmi_event_queue_ref( pQueue );
+      if ( NULL != gEventPool )
+         g_thread_pool_push( gEventPool, pQueue, NULL );
+      else
+         cgmi_event_dispatch_func( pQueue, NULL );
+   }
+}
+
+//
+// Wait for every event emitted so far to be delivered.  A session destroyed
+// from its own callback can't wait on itself; the dispatcher holds its own
+// reference on the queue, so the queue outlives the session until the
+// callback returns and the remaining events, which carry their own callback
+// and handle, are delivered.
+//
+static void cgmi_event_drain( tEventQueue *pQueue )
+{
+   if ( NULL == pQueue )
+      return;
+
+   g_mutex_lock( &pQueue->mutex );
+   if ( pQueue->dispatchThread != g_thread_self() )
+   {
+      while ( 0 != g_atomic_int_get(&pQueue->scheduled) )
+         g_cond_wait( &pQueue->idleCond, &pQueue->mutex );
+   }
+   g_mutex_unlock( &pQueue->mutex );
+}
+
+static void cgmi_event_queue_reset_stats( tEventQueue *pQueue )
+{
+   g_mutex_lock( &pQueue->mutex );
+   g_atomic_int_set( &pQueue->maxDepth, g_atomic_int_get(&pQueue->depth) );
+   pQueue->numDispatched = 0;
+   pQueue->totalLatencyUs = 0;
+   pQueue->maxLatencyUs = 0;
+   g_mutex_unlock( &pQueue->mutex );
+}
+
+static void cgmi_event_queue_free( tEventQueue *pQueue )
+{
+   if ( NULL == pQueue )
+      return;
+
+   cgmi_event_drain( pQueue );
+   cgmi_event_queue_unref( pQueue );
+}
+
+//
+// Session pool.  A session comes with its locks initialized and a bus
+// dispatcher assigned; a few are kept warm so cgmi_CreateSession is a pop,
+// destroyed sessions are scrubbed and put back, and the pool is topped up
+// from a background thread.
+//
+static void cgmi_session_init_locks( tSession *pSess )
+{
+   g_rec_mutex_init(&pSess->psiMutex);
+   g_mutex_init(&pSess->asyncLoadMutex);
+   g_cond_init(&pSess->asyncLoadCond);
+   g_mutex_init(&pSess->reapMutex);
+   g_cond_init(&pSess->reapCond);
+   g_mutex_init(&pSess->avSyncMutex);
+   g_mutex_init(&pSess->decStatsMutex);
+   g_mutex_init(&pSess->psiFilterMutex);
+}
+
+static void cgmi_session_clear_locks( tSession *pSess )
+{
+   g_rec_mutex_clear(&pSess->psiMutex);
+   g_mutex_clear(&pSess->asyncLoadMutex);
+   g_cond_clear(&pSess->asyncLoadCond);
+   g_cond_clear(&pSess->reapCond);
+   g_mutex_clear(&pSess->reapMutex);
+   g_mutex_clear(&pSess->avSyncMutex);
+   g_mutex_clear(&pSess->decStatsMutex);
+   g_mutex_clear(&pSess->psiFilterMutex);
+}
+
+static tSession *cgmi_session_new( void )
+{
+   tSession *pSess = NULL;
+   tDispatcher *pDispatcher = NULL;
+
+   pDispatcher = cgmi_dispatcher_acquire();
+   if ( NULL == pDispatcher )
+   {
+      GST_WARNING("No bus dispatcher available, was cgmi_Init called?\n");
+      return NULL;
+   }
+
+   pSess = g_malloc0( sizeof(tSession) );
+   if ( NULL == pSess )
+   {
+      cgmi_dispatcher_release( pDispatcher );
+      return NULL;
+   }
+
+   pSess->dispatcher = pDispatcher;
+   pSess->thread_ctx = g_main_context_ref( pDispatcher->ctx );
+   pSess->autoPlayMutex = g_mutex_new ();
+   pSess->autoPlayCond = g_cond_new ();
+   pSess->eventQueue = cgmi_event_queue_new();
+   cgmi_session_init_locks( pSess );
+
+   return pSess;
+}
+
+static void cgmi_session_free( tSession *pSess )
+{
+   if (pSess->autoPlayCond) {g_cond_free(pSess->autoPlayCond);}
+   if (pSess->autoPlayMutex) {g_mutex_free(pSess->autoPlayMutex);}
+   cgmi_session_clear_locks( pSess );
+   if(NULL != pSess->thread_ctx)
+   {
+      g_main_context_unref(pSess->thread_ctx);
+      pSess->thread_ctx = NULL;
+   }
+   cgmi_dispatcher_release( pSess->dispatcher );
+   cgmi_event_queue_free( pSess->eventQueue );
+   cgmi_psi_snapshot_release_retired( pSess );
+   cgmi_psi_snapshot_put( pSess->psiSnapshot );
+   g_free( pSess );
+}
+
+// back to the state cgmi_session_new left it in, the cookie goes with it
+static void cgmi_session_scrub( tSession *pSess )
+{
+   tDispatcher *pDispatcher = pSess->dispatcher;
+   GMainContext *ctx = pSess->thread_ctx;
+   GMutex *autoPlayMutex = pSess->autoPlayMutex;
+   GCond *autoPlayCond = pSess->autoPlayCond;
+   tEventQueue *eventQueue = pSess->eventQueue;
+
+   cgmi_psi_snapshot_release_retired( pSess );
+   cgmi_psi_snapshot_put( pSess->psiSnapshot );
+   cgmi_session_clear_locks( pSess );
+   memset( pSess, 0, sizeof(tSession) );
+
+   pSess->dispatcher = pDispatcher;
+   pSess->thread_ctx = ctx;
+   pSess->autoPlayMutex = autoPlayMutex;
+   pSess->autoPlayCond = autoPlayCond;
+   pSess->eventQueue = eventQueue;
+   cgmi_session_init_locks( pSess );
+}
+
+static void cgmi_session_pool_refill( gpointer data, gpointer userData )
+{
+   tSession *pSess = NULL;
+   gboolean full;
+
+   while ( 1 )
    {
-      audioDecoder = cgmi_gst_find_element( bin, "audiodecoder" );
+      g_mutex_lock( &gSessionPoolMutex );
+      full = ( g_queue_get_length(&gSessionPool) >= gSessionPoolSize );
+      g_mutex_unlock( &gSessionPoolMutex );
+      if ( TRUE == full )
+         break;
 
-      if( NULL != audioDecoder )
+      pSess = cgmi_session_new();
+      if ( NULL == pSess )
+         break;
+
+      g_mutex_lock( &gSessionPoolMutex );
+      if ( g_queue_get_length(&gSessionPool) < gSessionPoolSize )
       {
-         pSess->audioDecoder = audioDecoder;
-         g_print("Muting audio decoder...\n");
-         g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", TRUE, NULL );
+         g_queue_push_tail( &gSessionPool, pSess );
+         pSess = NULL;
       }
+      g_mutex_unlock( &gSessionPoolMutex );
+
+      if ( NULL != pSess )
+      {
+         cgmi_session_free( pSess );
+         break;
+      }
+   }
+}
+
+static tSession *cgmi_session_pool_get( void )
+{
+   tSession *pSess = NULL;
+
+   g_mutex_lock( &gSessionPoolMutex );
+   pSess = (tSession*)g_queue_pop_head( &gSessionPool );
+   g_mutex_unlock( &gSessionPoolMutex );
+
+   if ( NULL == pSess )
+   {
+      GST_INFO("Session pool is empty, creating a session\n");
+      pSess = cgmi_session_new();
+   }
+
+   if ( NULL != gSessionPoolRefill )
+   {
+      g_thread_pool_push( gSessionPoolRefill, GINT_TO_POINTER(1), NULL );
    }
 
-   // If this element is a bin ensure this callback is called when elements
-   // are added.
-   if ( GST_IS_BIN(element) )
+   return pSess;
+}
+
+static void cgmi_session_pool_put( tSession *pSess )
+{
+   cgmi_session_scrub( pSess );
+
+   g_mutex_lock( &gSessionPoolMutex );
+   if ( g_queue_get_length(&gSessionPool) < gSessionPoolSize )
+   {
+      g_queue_push_tail( &gSessionPool, pSess );
+      pSess = NULL;
+   }
+   g_mutex_unlock( &gSessionPoolMutex );
+
+   if ( NULL != pSess )
+   {
+      cgmi_session_free( pSess );
+   }
+}
+
+static void cgmi_session_pool_start( void )
+{
+   const gchar *envSize = getenv( "CGMI_SESSION_POOL_SIZE" );
+
+   gSessionPoolSize = ( NULL != envSize ) ? (guint)strtoul( envSize, NULL, 10 ) : DEFAULT_SESSION_POOL_SIZE;
+   if ( 0 == gSessionPoolSize )
+      return;
+
+   gSessionPoolRefill = g_thread_pool_new( cgmi_session_pool_refill, NULL, 1, FALSE, NULL );
+
+   // the first sessions are ready by the time cgmi_Init returns
+   cgmi_session_pool_refill( NULL, NULL );
+   g_print("Session pool holds %u sessions\n", g_queue_get_length(&gSessionPool));
+}
+
+static void cgmi_session_pool_stop( void )
+{
+   tSession *pSess = NULL;
+
+   if ( NULL != gSessionPoolRefill )
    {
-      g_print("Element (%s) is a bin", name);
-      g_signal_connect( element, "element-added", G_CALLBACK(cgmi_gst_element_added), pSess );
+      g_thread_pool_free( gSessionPoolRefill, TRUE, TRUE );
+      gSessionPoolRefill = NULL;
    }
 
-   if ( NULL != name )
+   g_mutex_lock( &gSessionPoolMutex );
+   gSessionPoolSize = 0;
+   while ( NULL != (pSess = (tSession*)g_queue_pop_head(&gSessionPool)) )
    {
-      g_free( name );
+      cgmi_session_free( pSess );
    }
+   g_mutex_unlock( &gSessionPoolMutex );
 }
 
 static GstFlowReturn cgmi_gst_new_user_data_buffer_available (GstAppSink *sink, gpointer data)
@@ -1366,6 +4173,46 @@ cgmi_Status cgmi_Init(void)
          cgmi_SetLogging("cgmi:2,dlnasrc:2,ciscdemux:3");
       }
 
+      //probe the platform for how to build playbin
+      {
+         gint64 probeStart = g_get_monotonic_time();
+         cgmi_gst_init_launch_template( &gLaunchTemplate );
+         g_print("Launch template: %s flags=0x%x (probed in %lld us)\n", PLAYBIN_ELEMENT,
+                 gLaunchTemplate.flags, (long long)(g_get_monotonic_time() - probeStart));
+      }
+
+      //bus messages of all sessions are dispatched from a shared pool
+      cgmi_dispatcher_pool_start();
+
+      //keep a few sessions ready for cgmi_CreateSession
+      cgmi_session_pool_start();
+
+      //application callbacks are delivered from here, never from gstreamer threads
+      gEventPool = g_thread_pool_new( cgmi_event_dispatch_func, NULL, EVENT_MAX_THREADS, FALSE, NULL );
+      if ( NULL == gEventPool )
+      {
+         GST_WARNING("Error creating the event pool, events will be delivered synchronously\n");
+      }
+
+      //cgmi_LoadAsync hands its blocking steps to this pool
+      gLoadPool = g_thread_pool_new( cgmi_load_finish_func, NULL, LOAD_MAX_THREADS, FALSE, NULL );
+      if ( NULL == gLoadPool )
+      {
+         GST_WARNING("Error creating the load pool, cgmi_LoadAsync will block\n");
+      }
+
+      //pipelines are torn down in the background after cgmi_Unload
+      gReaperPool = g_thread_pool_new( cgmi_reaper_func, NULL, REAPER_MAX_THREADS, FALSE, NULL );
+      if ( NULL == gReaperPool )
+      {
+         GST_WARNING("Error creating the reaper pool, pipelines will be torn down synchronously\n");
+      }
+
+#if !defined (DISABLE_MONITORING)
+      //one thread samples the decoders of every session
+      cgmi_monitor_start();
+#endif
+
       //intialize the diag subsytem
       cgmiDiags_Init();
 
@@ -1376,6 +4223,31 @@ cgmi_Status cgmi_Init(void)
 
 cgmi_Status cgmi_Term (void)
 {
+   // loads still completing reference the reaper
+   if ( NULL != gLoadPool )
+   {
+      g_thread_pool_free( gLoadPool, FALSE, TRUE );
+      gLoadPool = NULL;
+   }
+   // finish every pending teardown before gstreamer goes away
+   if ( NULL != gReaperPool )
+   {
+      g_thread_pool_free( gReaperPool, FALSE, TRUE );
+      gReaperPool = NULL;
+   }
+#if !defined (DISABLE_MONITORING)
+   cgmi_monitor_stop();
+#endif
+   // deliver what is still queued before the queues go with the sessions
+   if ( NULL != gEventPool )
+   {
+      g_thread_pool_free( gEventPool, FALSE, TRUE );
+      gEventPool = NULL;
+   }
+   cgmi_session_pool_stop();
+   cgmi_dispatcher_pool_stop();
+   cgmi_gst_clear_launch_template( &gLaunchTemplate );
+   cgmi_psi_cache_clear();
    gst_deinit();
    cgmi_utils_finalize();
    cgmiDiags_Term();
@@ -1387,17 +4259,25 @@ cgmi_Status cgmi_Term (void)
 cgmi_Status cgmi_CreateSession (cgmi_EventCallback eventCB, void* pUserData, void **pSession ) {
    tSession *pSess = NULL;
 
-   pSess = g_malloc0(sizeof(tSession));
+   // locks and dispatcher are already set up on pooled sessions
+   pSess = cgmi_session_pool_get();
    if (pSess == NULL)
    {
+      return CGMI_ERROR_NOT_INITIALIZED;
+   }
+
+   pSess->handle = cgmi_handle_alloc( &gSessionHandles, pSess );
+   if (pSess->handle == NULL)
+   {
+      cgmi_session_pool_put(pSess);
       return CGMI_ERROR_OUT_OF_MEMORY;
    }
-   memset(pSess, 0, sizeof(tSession));
 
-   *pSession = pSess;
+   *pSession = pSess->handle;
    pSess->cookie = (void*)MAGIC_COOKIE;
    pSess->usrParam = pUserData;
    pSess->eventCB = eventCB;
+   cgmi_event_queue_reset_stats( pSess->eventQueue );
    pSess->demux = NULL;
    pSess->udpsrc = NULL;
    pSess->videoSink = NULL;
@@ -1424,55 +4304,19 @@ cgmi_Status cgmi_CreateSession (cgmi_EventCallback eventCB, void* pUserData, voi
    pSess->defaultSubtitleLanguage[sizeof(pSess->defaultSubtitleLanguage) - 1] = 0;
    pSess->subtitleLanguageIndex = INVALID_INDEX;
 
-   pSess->thread_ctx = g_main_context_new();
-
-   pSess->autoPlayMutex = g_mutex_new ();
-   pSess->autoPlayCond = g_cond_new ();
 
-   g_mutex_init(&pSess->monThreadMutex);
-   g_cond_init(&pSess->monThreadCond);
-   g_rec_mutex_init(&pSess->psiMutex);
 #if !defined (DISABLE_MONITORING)
-
-   pSess->runMonitor = TRUE;
-   pSess->monitor = g_thread_new("monitoring_thread", cgmi_monitor, pSess);
-   if (!pSess->monitor)
-   {
-      GST_WARNING("Error launching thread for monitoring timestamp errors\n");
-   }
+   pSess->monitorIntervalMs = DEFAULT_MONITOR_INTERVAL_MS;
+   cgmi_monitor_register( pSess );
 #endif
 
-   pSess->loop = g_main_loop_new (pSess->thread_ctx, FALSE);
-   if (pSess->loop == NULL)
-   {
-      GST_WARNING("Error creating a new Loop\n");
-   }
-
-   pSess->thread = g_thread_new("signal_thread", (GThreadFunc)g_main_loop_run, (void*)pSess->loop);
-   if (!pSess->thread)
-   {
-      GST_WARNING("Error launching thread for gmainloop\n");
-   }
-   //need a blocking semaphore here
-   // but instead I will spin until the
-   // gmainloop is running
-   while (FALSE == g_main_loop_is_running(pSess->loop))
-   {
-      g_usleep(100);
-   }
-   GST_INFO("ok the gmainloop for the thread ctx is running\n");
-
-   g_mutex_lock(&gSessionListMutex);
-   gSessionList = g_list_append(gSessionList, pSess);
-   g_mutex_unlock(&gSessionListMutex);
-
    return CGMI_ERROR_SUCCESS;
 }
 
 cgmi_Status cgmi_DestroySession (void *pSession)
 {
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -1480,59 +4324,48 @@ cgmi_Status cgmi_DestroySession (void *pSession)
       return CGMI_ERROR_INVALID_HANDLE;
    }
 
-   GST_INFO("Entered Destroy\n");
-   if (g_main_loop_is_running(pSess->loop))
-   {
-      if ( NULL != pSess->sourceWatch )
-      {
-         GST_INFO("removing source from main loop context\n");
-         g_source_destroy( pSess->sourceWatch );
-         g_source_unref( pSess->sourceWatch );
-         pSess->sourceWatch = NULL;
-      }
-
-      GST_INFO("about to quit the main loop\n");
-      g_main_loop_quit (pSess->loop);
-   }
-
-   g_mutex_lock(&pSess->monThreadMutex);
-   pSess->runMonitor = FALSE;
-   g_mutex_unlock(&pSess->monThreadMutex);
-
-   if (pSess->monitor)
-   {
-      g_cond_signal(&pSess->monThreadCond);
+   // needs the handle to reach the section filter API
+   cgmi_psi_filter_close( pSess );
+   cgmi_psi_audio_cancel( pSess );
 
-      GST_INFO("about to join monitoring thread\n");
-      g_thread_join (pSess->monitor);
-   }
-   else
+   // retire the handle first, calls racing with the destroy now fail the lookup
+   if ( cgmi_handle_free(&gSessionHandles, pSession) == FALSE )
    {
-      g_print("No monitoring thread to join\n");
+      g_print("%s:Session is already being destroyed\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
    }
 
-   if (pSess->thread)
+   GST_INFO("Entered Destroy\n");
+   if ( NULL != pSess->sourceWatch )
    {
-      GST_INFO("about to join threads\n");
-      g_thread_join (pSess->thread);
+      GST_INFO("removing source from main loop context\n");
+      g_source_destroy( pSess->sourceWatch );
+      g_source_unref( pSess->sourceWatch );
+      pSess->sourceWatch = NULL;
    }
-   else
+   if ( NULL != pSess->bus )
    {
-      g_print("No thread to free... odd\n");
+#if GST_CHECK_VERSION(1,0,0)
+      gst_bus_set_sync_handler( pSess->bus, NULL, NULL, NULL );
+#else
+      gst_bus_set_sync_handler( pSess->bus, NULL, NULL );
+#endif
    }
+   cgmi_async_load_stop( pSess );
+   cgmi_load_finish_wait( pSess );
+
+#if !defined (DISABLE_MONITORING)
+   cgmi_monitor_unregister( pSess );
+#endif
+
+   // the dispatcher is shared, make sure it is not in one of our callbacks
+   GST_INFO("about to sync with the bus dispatcher\n");
+   cgmi_dispatcher_sync( pSess->dispatcher );
+
+   cgmi_preload_discard( pSess );
+   cgmi_reaper_wait( pSess );
 
    if (pSess->pipeline) {gst_object_unref (GST_OBJECT (pSess->pipeline));}
-   if (pSess->autoPlayCond) {g_cond_free(pSess->autoPlayCond);}
-   if (pSess->autoPlayMutex) {g_mutex_free(pSess->autoPlayMutex);}
-   if (pSess->loop) {g_main_loop_unref(pSess->loop);}
-   g_rec_mutex_clear(&pSess->psiMutex);
-   g_cond_clear(&pSess->monThreadCond);
-   g_mutex_clear(&pSess->monThreadMutex);
-   if(NULL != pSess->thread_ctx)
-   {
-      g_main_context_unref(pSess->thread_ctx);
-      pSess->thread_ctx = NULL;
-   }
 
 #ifdef USE_DRMPROXY
    if (0 != pSess->drmProxyHandle) 
@@ -1544,14 +4377,16 @@ cgmi_Status cgmi_DestroySession (void *pSession)
           GST_ERROR ("DRMPROXY_DestroySession error %lu \n", proxy_err.errCode);
           GST_ERROR ("%s \n", proxy_err.errString);
           if (pSess != NULL)
-             pSess->eventCB(pSess->usrParam, (void *)pSess, 0, proxy_err.errCode);
+             cgmi_event_emit(pSess, 0, proxy_err.errCode);
        }
    }
 #endif
-   g_mutex_lock(&gSessionListMutex);
-   gSessionList = g_list_remove(gSessionList, pSess);
-   g_mutex_unlock(&gSessionListMutex);
-   g_free(pSess);
+
+   // everything emitted so far reaches the application before destroy returns
+   cgmi_event_drain( pSess->eventQueue );
+
+   // scrubbed and kept for the next cgmi_CreateSession
+   cgmi_session_pool_put(pSess);
 
    return stat;
 }
@@ -1567,7 +4402,7 @@ static void cgmi_gst_no_more_pads(GstElement *element, gpointer data)
    {
       if(FALSE == pSess->suppressLoadDone)
       {
-         pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_LOAD_DONE, 0);
+         cgmi_event_emit(pSess, NOTIFY_LOAD_DONE, 0);
       }
       else
       {
@@ -1582,38 +4417,138 @@ static void cgmi_gst_no_more_pads(GstElement *element, gpointer data)
    }
 }
 
-cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+//
+// What cgmi_LoadAsync used to block its caller on: joining the DLNA probe,
+// waiting for the previous pipeline to release the decoders and the
+// transition to PAUSED.  Runs on the load pool; the outcome is reported
+// from here or the bus handler, through the same notifications as before.
+//
+static void cgmi_load_finish_func( gpointer data, gpointer userData )
+{
+   tLoadJob *pJob = (tLoadJob*)data;
+   tSession *pSess = pJob->pSess;
+   cgmi_Status stat = CGMI_ERROR_SUCCESS;
+   GstStateChangeReturn sret = GST_STATE_CHANGE_FAILURE;
+
+   do
+   {
+      if ( NULL != pJob->pProbe )
+      {
+         stat = cgmi_dlna_probe_finish( pSess, pJob->pProbe );
+         pJob->pProbe = NULL;
+         if ( CGMI_ERROR_SUCCESS != stat )
+            break;
+
+         g_print("URI: %s\n", pSess->playbackURI);
+         g_object_set( G_OBJECT(pSess->pipeline), "uri", pSess->playbackURI, NULL );
+      }
+
+      // the previous pipeline must have released the decoders
+      cgmi_reaper_wait( pSess );
+
+      // cancelled (or timed out) meanwhile, leave the pipeline to cgmi_Unload
+      if ( FALSE == pSess->asyncLoadPending )
+         break;
+
+      sret = cisco_gst_setState( pSess, GST_STATE_PAUSED );
+      if ( GST_STATE_CHANGE_FAILURE == sret )
+      {
+         GST_ERROR("State change to PAUSED failed\n");
+         stat = CGMI_ERROR_FAILED;
+      }
+   }while(0);
+
+   if ( CGMI_ERROR_SUCCESS != stat )
+   {
+      if ( TRUE == cgmi_async_load_stop(pSess) )
+         cgmi_event_emit(pSess, NOTIFY_MEDIAPLAYER_URL_OPEN_FAILURE, 0);
+   }
+   else if ( GST_STATE_CHANGE_SUCCESS == sret && TRUE == cgmi_async_load_stop(pSess) )
+   {
+      // a preloaded pipeline that had already prerolled, no ASYNC_DONE follows
+      cgmi_async_load_done(pSess);
+   }
+   else if ( GST_STATE_CHANGE_NO_PREROLL == sret && TRUE == cgmi_async_load_stop(pSess) )
+   {
+      if(FALSE == pSess->suppressLoadDone)
+      {
+         cgmi_event_emit(pSess, NOTIFY_LOAD_DONE, 0);
+      }
+      else
+      {
+         pSess->suppressLoadDone = FALSE;
+      }
+   }
+   /* otherwise ASYNC_DONE (or an error) on the bus completes the load */
+
+   g_mutex_lock(&pSess->asyncLoadMutex);
+   pSess->asyncLoadJob = FALSE;
+   g_cond_broadcast(&pSess->asyncLoadCond);
+   g_mutex_unlock(&pSess->asyncLoadMutex);
+
+   g_free( pJob );
+}
+
+static void cgmi_load_finish_queue( tSession *pSess, tDlnaProbe *pProbe )
+{
+   tLoadJob *pJob = g_malloc0( sizeof(tLoadJob) );
+
+   pJob->pSess = pSess;
+   pJob->pProbe = pProbe;
+
+   g_mutex_lock(&pSess->asyncLoadMutex);
+   pSess->asyncLoadJob = TRUE;
+   g_mutex_unlock(&pSess->asyncLoadMutex);
+
+   if ( NULL != gLoadPool )
+      g_thread_pool_push( gLoadPool, pJob, NULL );
+   else
+      cgmi_load_finish_func( pJob, NULL );
+}
+
+//
+// Wait for a queued cgmi_load_finish_func to be done with the session.
+// cgmi_async_load_stop first so it stops short of the state change.
+//
+static void cgmi_load_finish_wait( tSession *pSess )
+{
+   g_mutex_lock(&pSess->asyncLoadMutex);
+   while ( TRUE == pSess->asyncLoadJob )
+      g_cond_wait(&pSess->asyncLoadCond, &pSess->asyncLoadMutex);
+   g_mutex_unlock(&pSess->asyncLoadMutex);
+}
+
+static cgmi_Status cgmi_load_pipeline (void *pSession, const char *uri, cpBlobStruct * cpblob,
+                                        const char *sessionSettings, gboolean bAsync)
 {
-   GError               *g_error_str =NULL;
-   GstParseContext      *ctx;
-   GstPlugin            *plugin;
-   gchar                **arr;
-   gchar                *pPipeline;
    cgmi_Status          stat = CGMI_ERROR_SUCCESS;
-   uint32_t             bisBroadcomHw = FALSE;
    int                  drmStatus = 1;
+   gboolean             bUsePreload = FALSE;
+   tDlnaProbe           *pProbe = NULL;
    GstStateChangeReturn sret;
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
       return CGMI_ERROR_INVALID_HANDLE;
    }
 
-   cgmiDiags_GetNextSessionIndex(&pSess->diagIndex);
-
-   pPipeline = g_strnfill(MAX_PIPELINE_SIZE, '\0');
-   if (pPipeline == NULL)
+   // a load still waiting for preroll is cancelled by the next one
+   if ( TRUE == pSess->asyncLoadPending || TRUE == pSess->asyncLoadJob )
    {
-      GST_WARNING("Error allocating memory\n");
-      return CGMI_ERROR_OUT_OF_MEMORY;
+      g_print("Cancelling pending asynchronous load of %s\n", pSess->playbackURI);
+      cgmi_Unload( pSession );
    }
 
-   pSess->numAudioLanguages = 0;
-   pSess->numClosedCaptionServices = 0;
-   pSess->numSubtitleLanguages = 0;
-   pSess->numStreams = 0;
+   cgmiDiags_GetNextSessionIndex(&pSess->diagIndex);
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+   cgmi_psi_snapshot_publish( pSess, NULL );
+   pSess->psiValid = FALSE;
+   pSess->psiSwitchPending = FALSE;
+   pSess->psiNumPmtAudio = 0;
+   g_rec_mutex_unlock(&pSess->psiMutex);
    pSess->videoStreamIndex = INVALID_INDEX;
    pSess->audioStreamIndex = INVALID_INDEX;
    pSess->audioLanguageIndex = INVALID_INDEX;
@@ -1627,6 +4562,9 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
    pSess->steadyState = TRUE;
    pSess->steadyStateWindow = 0;
    pSess->rateAfterPause = 0.0;
+#if !defined (DISABLE_MONITORING)
+   cgmi_avsync_reset( pSess );
+#endif
    pSess->maskRateChangedEvent = FALSE;
    pSess->noVideo = FALSE;
    pSess->bQueryDiscreteAudioInfo = TRUE;
@@ -1635,70 +4573,43 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
    pSess->hwVideoDecHandle = NULL;
    pSess->hwAudioDecHandle = NULL;
 
+   cgmi_psi_cache_seed( pSess, uri );
+
    cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_LOAD, pSess->diagIndex, uri, 0);
 
    //
-   // check to see if this is a DLNA url.
+   // if this uri was preloaded we can swap the shadow pipeline in, anything
+   // else that sits in the preload slot is not going to be used.
    //
-   if (0 == strncmp(uri, "http", 4))
-   {
-      stat = cgmi_utils_is_content_dlna(uri, &pSess->bisDLNAContent);
-      if(CGMI_ERROR_SUCCESS != stat)
-      {
-         g_free(pPipeline);
-         printf("Not able to determine whether the content is DLNA\n");
-         return stat;
-      }
-   }
-
-   if (pSess->bisDLNAContent == TRUE)
+   if ( TRUE == cgmi_preload_matches(pSess, uri, cpblob, sessionSettings) )
    {
-      //for the gstreamer pipeline to autoplug we have to add
-      //dlna+ to the protocol.
-      g_snprintf(pSess->playbackURI, MAX_URI_SIZE, "%s%s","dlna+", uri);
+      bUsePreload = TRUE;
+      pSess->bisDLNAContent = pSess->preloadIsDLNAContent;
+      g_strlcpy(pSess->playbackURI, pSess->preloadPlaybackURI, MAX_URI_SIZE);
    }
    else
    {
-      g_strlcpy(pSess->playbackURI, uri, MAX_URI_SIZE);
-   }
-
-   g_print("URI: %s\n", pSess->playbackURI);
-   if (sessionSettings != NULL)
-      g_print("Settings: %s\n", sessionSettings);
-   /* Create playback pipeline */
+      cgmi_preload_discard( pSess );
 
-#if GST_CHECK_VERSION(1,0,0)
-   g_strlcpy(pPipeline, "playbin uri=", MAX_PIPELINE_SIZE);
-#else
-   g_strlcpy(pPipeline, "playbin2 uri=", MAX_PIPELINE_SIZE);
-#endif
-
-   g_strlcat(pPipeline, pSess->playbackURI, MAX_PIPELINE_SIZE);
-
-#if RDK_EMULATOR
+      if (0 == strncmp(uri, "http", 4))
+      {
+         pProbe = cgmi_dlna_probe_start( pSess, uri );
+      }
 
-   // The  comcast emulator doesn't set priority correctly for the video sink to autoplug
-   // until a patch is put in for this, just set the command line for the video-sink to be
-   // the below
-   // RMS
-   g_strlcat(pPipeline, " video-sink=fbdevsink", 1024);
-#endif
-   // let's see if we are running on broadcom hardware if we are let's see if we can find there
-   // video sink.  If it's there we need to set the flags variable so the pipeline knows to do
-   // color transformation and scaling in hardware
-#if GST_CHECK_VERSION(1,0,0)
-   plugin = gst_registry_find_plugin( gst_registry_get() , "brcmvideosink");
-#else
-   plugin = gst_registry_find_plugin( gst_registry_get_default() , "brcmvideosink");
-#endif
-   if ( NULL != plugin )
-   {
-      bisBroadcomHw = TRUE;
-      g_print("Autoplugging on real broadcom hardware\n");
-      g_strlcat(pPipeline, " flags= 0x63", MAX_PIPELINE_SIZE);
-      gst_object_unref( plugin );
+      if ( NULL == pProbe )
+      {
+         stat = cgmi_resolve_playback_uri(uri, pSess->playbackURI, &pSess->bisDLNAContent);
+         if(CGMI_ERROR_SUCCESS != stat)
+         {
+            return stat;
+         }
+      }
    }
 
+   if ( NULL == pProbe )
+      g_print("URI: %s\n", pSess->playbackURI);
+   if (sessionSettings != NULL)
+      g_print("Settings: %s\n", sessionSettings);
    do
    {
       if (NULL != cpblob)
@@ -1728,12 +4639,20 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
             strncpy( pSess->defaultAudioLanguage, pSess->sessionSettings.audioLanguage, sizeof(pSess->defaultAudioLanguage) );
             pSess->defaultAudioLanguage[sizeof(pSess->defaultAudioLanguage) - 1] = 0;
          }
+#if !defined (DISABLE_MONITORING)
+         {
+            gchar intervalStr[16];
+            if (cgmi_utils_get_json_value(intervalStr, sizeof(intervalStr), sessionSettings, "MonitorIntervalMs") == CGMI_ERROR_SUCCESS)
+            {
+               g_print("cgmiPlayer: monitorIntervalMs: %s\n", intervalStr);
+               cgmi_monitor_set_interval(pSess, (guint)strtoul(intervalStr, NULL, 10));
+            }
+         }
+#endif
       }
       else
          pSess->sessionSettingsStr = NULL;
 
-      ctx = gst_parse_context_new ();
-
       if (0 == drmStatus)  // Check whether DRM failed with license creation (if needed)
       {
          g_print("ERROR: DRM License Creation failed, pipeline will not launch");
@@ -1741,12 +4660,26 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
          break;
       }
 
-      GST_INFO("Launching the pipeline with :\n%s\n", pPipeline);
+      if ( TRUE == bUsePreload )
+      {
+         GST_INFO("Using the preloaded pipeline for %s\n", uri);
+         pSess->pipeline = pSess->preloadPipeline;
+         pSess->preloadPipeline = NULL;
+         {
+            GstState current = GST_STATE_NULL, pending = GST_STATE_VOID_PENDING;
+            gst_element_get_state( pSess->pipeline, &current, &pending, 0 );
+            cgmi_cache_state( pSess, current, pending );
+         }
+      }
+      else
+      {
+         /* Create playback pipeline */
+         // with a probe in flight the uri is filled in once it has resolved
+         pSess->pipeline = cgmi_gst_create_playbin( (NULL == pProbe) ? pSess->playbackURI : NULL );
+         cgmi_cache_state( pSess, GST_STATE_NULL, GST_STATE_VOID_PENDING );
 
-      pSess->pipeline = gst_parse_launch_full(pPipeline,
-                                              ctx,
-                                              GST_PARSE_FLAG_FATAL_ERRORS,
-                                              &g_error_str);
+         cgmiDiag_addTimingEntry(DIAG_TIMING_METRIC_PIPELINE_CREATED, pSess->diagIndex, (char*)uri, 0);
+      }
 
          g_object_set( G_OBJECT (pSess->source), "uri", pSess->playbackURI, NULL );
 #ifdef USE_INFINITE_SOUP_TIMEOUT
@@ -1758,28 +4691,9 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
          g_print("Muting audio decoder...\n");
          g_object_set( G_OBJECT(pSess->audioDecoder), "decoder_mute", TRUE, NULL );
 
+      // cgmi_gst_create_playbin has already reported any missing plugins
       if (pSess->pipeline == NULL)
       {
-         GST_WARNING("PipeLine was not able to be created\n");
-         if (g_error_str)
-         {
-            g_print("Error with pipeline:%s \n", g_error_str->message);
-         }
-
-         //now if there are missing elements that are needed in the pipeline, lets' dump
-         //those out.
-         if(g_error_matches(g_error_str, GST_PARSE_ERROR, GST_PARSE_ERROR_NO_SUCH_ELEMENT))
-         {
-            guint i=0;
-            g_print("Missing these plugins:\n");
-            arr = gst_parse_context_get_missing_elements(ctx);
-            while (arr[i] != NULL)
-            {
-               g_print("%s\n",arr[i]);
-               i++;
-            }
-            g_strfreev(arr);
-         }
          stat = CGMI_ERROR_NOT_IMPLEMENTED;
          break;
       }
@@ -1793,39 +4707,74 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
       }
 
       // enable the notifications.
+#if GST_CHECK_VERSION(1,0,0)
+      gst_bus_set_sync_handler(pSess->bus, cgmi_gst_bus_sync_handler, pSess, NULL);
+#else
+      gst_bus_set_sync_handler(pSess->bus, cgmi_gst_bus_sync_handler, pSess);
+#endif
       pSess->sourceWatch = gst_bus_create_watch(pSess->bus);
       g_source_set_callback(pSess->sourceWatch, (GSourceFunc)cgmi_gst_handle_msg, pSess, NULL);
       g_source_attach(pSess->sourceWatch, pSess->thread_ctx);
 
-      g_signal_connect( pSess->pipeline, "element-added",
-         G_CALLBACK(cgmi_gst_element_added), pSess );
+      if ( TRUE == bUsePreload )
+      {
+         cgmi_preload_adopt( pSess );
+      }
+      else
+      {
+         cgmi_gst_connect_element_added( pSess, pSess->pipeline );
+
+         g_signal_connect( pSess->pipeline, "notify::source",
+            G_CALLBACK(cgmi_gst_notify_source), pSess );
+      }
+
+      // the caller doesn't wait for the probe, the old pipeline or preroll
+      if(TRUE == bAsync)
+      {
+         cgmi_async_load_start(pSess);
+         cgmi_load_finish_queue( pSess, pProbe );
+         pProbe = NULL;
+         break;
+      }
+
+      if ( NULL != pProbe )
+      {
+         stat = cgmi_dlna_probe_finish( pSess, pProbe );
+         pProbe = NULL;
+         if(CGMI_ERROR_SUCCESS != stat)
+         {
+            // the pipeline is already built and watched, take it down again
+            cgmi_Unload( pSession );
+            break;
+         }
 
-      g_signal_connect( pSess->pipeline, "notify::source",
-         G_CALLBACK(cgmi_gst_notify_source), pSess );
+         g_print("URI: %s\n", pSess->playbackURI);
+         g_object_set( G_OBJECT(pSess->pipeline), "uri", pSess->playbackURI, NULL );
+      }
+
+      // the previous pipeline must have released the decoders
+      cgmi_reaper_wait( pSess );
 
       sret = cisco_gst_setState( pSess, GST_STATE_PAUSED );
-      if(GST_STATE_CHANGE_ASYNC == sret)
+      if(GST_STATE_CHANGE_FAILURE == sret)
+      {
+         GST_ERROR("State change to PAUSED failed\n");
+         stat = CGMI_ERROR_FAILED;
+      }
+      // a preloaded pipeline may already have finished prerolling
+      else if(GST_STATE_CHANGE_ASYNC == sret ||
+         (GST_STATE_CHANGE_SUCCESS == sret && TRUE == bUsePreload))
       {
          /* Wait for the async sate change to complete */
          sret = gst_element_get_state(pSess->pipeline, NULL, NULL, 10 * GST_SECOND);
          if(GST_STATE_CHANGE_SUCCESS != sret)
          {
-            GST_ERROR("State change to PAUSED failed\n");
-            stat = CGMI_ERROR_FAILED;
-         }
-         else
-         {
-            if(FALSE == pSess->suppressLoadDone)
-            {
-               pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_LOAD_DONE, 0);
-            }
-            else
-            {
-               pSess->suppressLoadDone = FALSE;
-            }
-
-            cgmi_GetHwDecHandles(pSess);
-            pSess->hasFullGstPipeline = TRUE;
+            GST_ERROR("State change to PAUSED failed\n");
+            stat = CGMI_ERROR_FAILED;
+         }
+         else
+         {
+            cgmi_async_load_done(pSess);
          }
       }
       /* This has been added for rtp live stream - it could add issues with rtsp/rtp vod playing */
@@ -1833,7 +4782,7 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
       {
          if(FALSE == pSess->suppressLoadDone)
          {
-            pSess->eventCB(pSess->usrParam, (void*)pSess, NOTIFY_LOAD_DONE, 0);
+            cgmi_event_emit(pSess, NOTIFY_LOAD_DONE, 0);
          }
          else
          {
@@ -1844,19 +4793,14 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
    }while(0);
 
    // free memory
-   gst_parse_context_free(ctx);
-   if (g_error_str)
+   if ( NULL != pProbe )
    {
-      g_error_free(g_error_str);
+      cgmi_dlna_probe_finish( pSess, pProbe );
+      pProbe = NULL;
    }
 
    if ( CGMI_ERROR_SUCCESS != stat )
    {
-      if ( NULL != pPipeline )
-      {
-         g_free(pPipeline);
-         pPipeline = NULL;
-      }
       if ( NULL != pSess->cpblob )
       {
          g_free(pSess->cpblob);
@@ -1873,10 +4817,106 @@ cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, c
 }
 
 
+cgmi_Status cgmi_Load (void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+{
+   return cgmi_load_pipeline(pSession, uri, cpblob, sessionSettings, FALSE);
+}
+
+cgmi_Status cgmi_LoadAsync (void *pSession, const char *uri, cpBlobStruct * cpblob, const char *sessionSettings)
+{
+   if ( NULL == uri )
+   {
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+   return cgmi_load_pipeline(pSession, uri, cpblob, sessionSettings, TRUE);
+}
+
+cgmi_Status cgmi_Preload (void *pSession, const char *uri)
+{
+   GstElement           *pipeline = NULL;
+   gchar                pPlaybackURI[MAX_URI_SIZE];
+   gboolean             bisDLNAContent = FALSE;
+   cgmi_Status          stat = CGMI_ERROR_SUCCESS;
+   GstStateChangeReturn sret;
+
+   tSession *pSess = cgmi_LookupSession(pSession);
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   // already sitting in the preload slot, nothing to do
+   if ( NULL != uri && NULL != pSess->preloadPipeline && 0 == g_strcmp0(uri, pSess->preloadURI) )
+   {
+      return CGMI_ERROR_SUCCESS;
+   }
+
+   cgmi_preload_discard( pSess );
+
+   // a NULL uri just releases the preload slot
+   if ( NULL == uri )
+   {
+      return CGMI_ERROR_SUCCESS;
+   }
+
+   do
+   {
+      stat = cgmi_resolve_playback_uri(uri, pPlaybackURI, &bisDLNAContent);
+      if(CGMI_ERROR_SUCCESS != stat)
+      {
+         break;
+      }
+
+      GST_INFO("Preloading the pipeline for %s\n", pPlaybackURI);
+
+      pipeline = cgmi_gst_create_playbin( pPlaybackURI );
+      if (pipeline == NULL)
+      {
+         stat = CGMI_ERROR_NOT_IMPLEMENTED;
+         break;
+      }
+
+      pSess->preloadPipeline = pipeline;
+      g_strlcpy(pSess->preloadURI, uri, MAX_URI_SIZE);
+      g_strlcpy(pSess->preloadPlaybackURI, pPlaybackURI, MAX_URI_SIZE);
+      pSess->preloadIsDLNAContent = bisDLNAContent;
+      g_atomic_int_set( &pSess->preloadPsiReady, FALSE );
+
+#if GST_CHECK_VERSION(1,10,0)
+      g_signal_connect( pipeline, "deep-element-added",
+         G_CALLBACK(cgmi_gst_preload_deep_element_added), pSess );
+#else
+      g_signal_connect( pipeline, "element-added",
+         G_CALLBACK(cgmi_gst_preload_element_added), pSess );
+#endif
+
+      g_signal_connect( pipeline, "notify::source",
+         G_CALLBACK(cgmi_gst_preload_notify_source), pSess );
+
+      // No bus watch yet, messages queue up on the bus until cgmi_Load
+      // swaps the pipeline in. Do not wait for preroll here.
+      sret = gst_element_set_state( pipeline, GST_STATE_PAUSED );
+      if ( GST_STATE_CHANGE_FAILURE == sret )
+      {
+         GST_WARNING("Preload of %s failed to start prerolling\n", uri);
+         cgmi_preload_discard( pSess );
+         stat = CGMI_ERROR_FAILED;
+         break;
+      }
+
+      g_print("Preloading %s\n", pSess->preloadPlaybackURI);
+
+   }while(0);
+
+   return stat;
+}
+
 cgmi_Status cgmi_Unload  ( void *pSession )
 {
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
    // we need to tear down the pipeline
 
@@ -1890,6 +4930,10 @@ cgmi_Status cgmi_Unload  ( void *pSession )
 
    do
    {
+      // internal PMT filter, has to go while the demux is still there
+      cgmi_psi_filter_close( pSess );
+      cgmi_psi_audio_cancel( pSess );
+
       if ( NULL != pSess->sourceWatch )
       {
          GST_INFO("removing source from main loop context\n");
@@ -1898,28 +4942,32 @@ cgmi_Status cgmi_Unload  ( void *pSession )
          pSess->sourceWatch = NULL;
       }
 
+      // cancels a cgmi_LoadAsync still waiting for preroll
+      cgmi_async_load_stop( pSess );
+      cgmi_load_finish_wait( pSess );
+
       //Signal psi callback on unload in case it is blocked on PID selection
       g_mutex_lock( pSess->autoPlayMutex );
       if ( TRUE == pSess->waitingOnPids )
          g_cond_signal( pSess->autoPlayCond );
       g_mutex_unlock( pSess->autoPlayMutex );
 
-      if (pSess->pipeline)
+      if ( NULL != pSess->bus )
       {
-         int refcount;
-         g_print ("Changing state of pipeline to NULL \n");
-         gst_element_set_state (pSess->pipeline, GST_STATE_NULL);
-
-         g_print ("Deleting pipeline\n");
-         refcount = GST_OBJECT_REFCOUNT(pSess->pipeline);
-         g_print ("Pipeline ref count on tear down is %d (should be 1)\n", refcount);
-         gst_object_unref( GST_OBJECT(pSess->pipeline) );
-         pSess->pipeline = NULL;
+#if GST_CHECK_VERSION(1,0,0)
+         gst_bus_set_sync_handler( pSess->bus, NULL, NULL, NULL );
+#else
+         gst_bus_set_sync_handler( pSess->bus, NULL, NULL );
+#endif
       }
-      if (pSess->bus)
+
+      // the reaper owns the old pipeline and bus from here on
+      if (pSess->pipeline || pSess->bus)
       {
-         gst_object_unref( GST_OBJECT(pSess->bus) );
+         cgmi_reaper_queue( pSess, pSess->pipeline, pSess->bus );
+         pSess->pipeline = NULL;
          pSess->bus = NULL;
+         cgmi_cache_state( pSess, GST_STATE_NULL, GST_STATE_VOID_PENDING );
       }
 
       if ( NULL != pSess->cpblob )
@@ -1941,7 +4989,12 @@ cgmi_Status cgmi_Unload  ( void *pSession )
       pSess->audioSink = NULL;
       pSess->videoDecoder = NULL;
       pSess->audioDecoder = NULL;
-      pSess->numAudioLanguages = 0;
+      pSess->decoderNotifies = FALSE;
+      g_rec_mutex_lock(&pSess->psiMutex);
+      cgmi_psi_snapshot_publish( pSess, NULL );
+      pSess->psiNumPmtAudio = 0;
+      pSess->psiFromCache = FALSE;
+      g_rec_mutex_unlock(&pSess->psiMutex);
       pSess->newAudioLanguage[0] = '\0';
       pSess->currAudioLanguage[0] = '\0';
       pSess->hasFullGstPipeline = FALSE;
@@ -1950,13 +5003,13 @@ cgmi_Status cgmi_Unload  ( void *pSession )
       pSess->hwVideoDecHandle = NULL;
 
    }while (0);
-   g_print("Exiting %s pipeline is now null\n",__FUNCTION__);
+   g_print("Exiting %s pipeline handed off for teardown\n",__FUNCTION__);
    return stat;
 }
 
 cgmi_Status cgmi_Play (void *pSession, int autoPlay)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
@@ -1986,7 +5039,7 @@ cgmi_Status cgmi_Play (void *pSession, int autoPlay)
 
 cgmi_Status cgmi_SetRate (void *pSession, float rate)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
    GstFormat format = GST_FORMAT_TIME;
    GstEvent *seek_event=NULL;
@@ -2014,7 +5067,8 @@ cgmi_Status cgmi_SetRate (void *pSession, float rate)
        g_print("%s: cgmi_SetRate was called with rate %f before cgmi_Play was called.No need to proceed in this function.Returning now.\n",__FUNCTION__,rate);
        return stat;
    }
-   gst_element_get_state(pSess->pipeline, &curState, NULL, GST_CLOCK_TIME_NONE);
+   // don't wait behind a pending state change, act on where it is heading
+   curState = cgmi_cached_target_state( pSess );
 
    /* Obtain the current position, needed for the seek event before a flush.
     * Position returned is sometimes incorrect after a flush
@@ -2141,7 +5195,7 @@ cgmi_Status cgmi_SetRate (void *pSession, float rate)
 cgmi_Status cgmi_SetPosition (void *pSession, float position)
 {
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
    GstState state;
 
@@ -2191,10 +5245,38 @@ cgmi_Status cgmi_SetPosition (void *pSession, float position)
    return stat;
 }
 
+cgmi_Status cgmi_GetState (void *pSession, tcgmi_PipelineState *pState, tcgmi_PipelineState *pPendingState)
+{
+   tSession *pSess = cgmi_LookupSession(pSession);
+   GstState current;
+   GstState pending;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   if ( NULL == pState )
+   {
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+   // tcgmi_PipelineState follows the GstState numbering
+   current = cgmi_cached_state( pSess, &pending );
+   *pState = (tcgmi_PipelineState)current;
+   if ( NULL != pPendingState )
+   {
+      *pPendingState = (tcgmi_PipelineState)pending;
+   }
+
+   return CGMI_ERROR_SUCCESS;
+}
+
 cgmi_Status cgmi_GetPosition (void *pSession, float *pPosition)
 {
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    gint64 curPos = 0;
    GstFormat gstFormat = GST_FORMAT_TIME;
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
@@ -2224,7 +5306,7 @@ cgmi_Status cgmi_GetPosition (void *pSession, float *pPosition)
 cgmi_Status cgmi_GetDuration (void *pSession, float *pDuration, cgmi_SessionType *type)
 {
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_SUCCESS;
    gint64 Duration = 0;
    GstFormat gstFormat = GST_FORMAT_TIME;
@@ -2268,7 +5350,7 @@ cgmi_Status cgmi_GetDuration (void *pSession, float *pDuration, cgmi_SessionType
 
 cgmi_Status cgmi_GetRates (void *pSession, float pRates[], unsigned int *pNumRates)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    cgmi_Status stat = CGMI_ERROR_FAILED ;
 
    GstStructure *structure = NULL;
@@ -2399,7 +5481,7 @@ cgmi_Status cgmi_canPlayType(const char *type, int *pbCanPlay )
 
 cgmi_Status cgmi_SetVideoRectangle( void *pSession, int srcx, int srcy, int srcw, int srch, int dstx, int dsty, int dstw, int dsth )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2468,7 +5550,7 @@ cgmi_Status cgmi_SetVideoRectangle( void *pSession, int srcx, int srcy, int srcw
 cgmi_Status cgmi_GetVideoResolution( void *pSession, int *srcw, int *srch )
 {
    gint64 res;
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2503,7 +5585,7 @@ cgmi_Status cgmi_GetVideoResolution( void *pSession, int *srcw, int *srch )
 
 cgmi_Status cgmi_GetVideoDecoderIndex(void *pSession, int *idx)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    int videoDecoderIndex = 0;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
@@ -2539,7 +5621,8 @@ cgmi_Status cgmi_GetVideoDecoderIndex(void *pSession, int *idx)
 cgmi_Status cgmi_GetNumAudioLanguages (void *pSession,  int *count)
 {
    cgmi_Status  stat = CGMI_ERROR_FAILED;
-   tSession     *pSess = (tSession*)pSession;
+   tSession     *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap = NULL;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2548,8 +5631,6 @@ cgmi_Status cgmi_GetNumAudioLanguages (void *pSession,  int *count)
       return stat;
    }
 
-   g_rec_mutex_lock(&pSess->psiMutex);
-
    do
    {
       if ( NULL == count )
@@ -2559,19 +5640,13 @@ cgmi_Status cgmi_GetNumAudioLanguages (void *pSession,  int *count)
          break;
       }
 
-      stat = cgmi_queryDiscreteAudioInfo(pSess);
-      if(CGMI_ERROR_SUCCESS != stat)
-      {
-         GST_ERROR("Discrete audio stream(s) info query failed\n");
-         break;
-      }
-
-      *count = pSess->numAudioLanguages;
+      snap = cgmi_psi_snapshot_get(pSess);
+      *count = snap->tables.numAudioLanguages;
 
       stat = CGMI_ERROR_SUCCESS;
    }while(0);
 
-   g_rec_mutex_unlock(&pSess->psiMutex);
+   cgmi_psi_snapshot_put(snap);
 
    return stat;
 }
@@ -2579,7 +5654,8 @@ cgmi_Status cgmi_GetNumAudioLanguages (void *pSession,  int *count)
 cgmi_Status cgmi_GetAudioLangInfo (void *pSession, int index, char* buf, int bufSize, char *isEnabled)
 {
    cgmi_Status  stat = CGMI_ERROR_FAILED;
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap = NULL;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2588,8 +5664,6 @@ cgmi_Status cgmi_GetAudioLangInfo (void *pSession, int index, char* buf, int buf
       return stat;
    }
 
-   g_rec_mutex_lock(&pSess->psiMutex);
-
    do
    {
       if ( NULL == buf )
@@ -2606,14 +5680,9 @@ cgmi_Status cgmi_GetAudioLangInfo (void *pSession, int index, char* buf, int buf
          break;
       }
 
-      stat = cgmi_queryDiscreteAudioInfo(pSess);
-      if(CGMI_ERROR_SUCCESS != stat)
-      {
-         GST_ERROR("Discrete audio stream(s) info query failed\n");
-         break;
-      }
+      snap = cgmi_psi_snapshot_get(pSess);
 
-      if ( index > pSess->numAudioLanguages - 1 || index < 0 )
+      if ( index > snap->tables.numAudioLanguages - 1 || index < 0 )
       {
          g_print("Bad index value passed for audio language!\n");
          stat = CGMI_ERROR_BAD_PARAM;
@@ -2621,7 +5690,7 @@ cgmi_Status cgmi_GetAudioLangInfo (void *pSession, int index, char* buf, int buf
       }
 
       if (pSess->audioLanguageIndex != INVALID_INDEX &&
-          pSess->audioLanguages[index].index == pSess->audioLanguageIndex)
+          snap->tables.audioLanguages[index].index == pSess->audioLanguageIndex)
       {
          *isEnabled = TRUE;
       }
@@ -2630,26 +5699,51 @@ cgmi_Status cgmi_GetAudioLangInfo (void *pSession, int index, char* buf, int buf
          *isEnabled = FALSE;
       }
 
-      strncpy( buf, pSess->audioLanguages[index].isoCode, bufSize );
+      strncpy( buf, snap->tables.audioLanguages[index].isoCode, bufSize );
       buf[bufSize - 1] = 0;
 
       stat = CGMI_ERROR_SUCCESS;
 
    }while(0);
 
-   g_rec_mutex_unlock(&pSess->psiMutex);
+   cgmi_psi_snapshot_put(snap);
 
    return stat;
 }
 
+// runs with the session handle table locked, the session cannot go away meanwhile
+static void cgmi_session_info_append( gpointer object, gpointer data )
+{
+   tSession    *pSess = (tSession *)object;
+   GArray      *infos = (GArray *)data;
+   sessionInfo info;
+
+   if(FALSE == pSess->hasFullGstPipeline)
+   {
+      return;
+   }
+
+   memset(&info, 0, sizeof(info));
+   if(strncmp("dlna+", pSess->playbackURI, strlen("dlna+")))
+   {
+      g_strlcpy(info.uri, pSess->playbackURI, sizeof(info.uri));
+   }
+   else
+   {
+      g_strlcpy(info.uri, &(pSess->playbackURI[strlen("dlna+")]), sizeof(info.uri));
+   }
+   info.hwAudioDecHandle = pSess->hwAudioDecHandle;
+   info.hwVideoDecHandle = pSess->hwVideoDecHandle;
+
+   g_array_append_val(infos, info);
+}
+
 cgmi_Status cgmi_GetActiveSessionsInfo(sessionInfo *sessInfoArr[], int *numSessOut)
 {
    cgmi_Status stat = CGMI_ERROR_FAILED;
-   tSession    *pSess = NULL;
-   GList       *list = NULL;
-   guint       listLen = 0;
+   GArray      *infos = NULL;
+   guint       numSess = 0;
 
-   g_mutex_lock(&gSessionListMutex);
    do
    {
       if(NULL == sessInfoArr)
@@ -2666,61 +5760,34 @@ cgmi_Status cgmi_GetActiveSessionsInfo(sessionInfo *sessInfoArr[], int *numSessO
       *sessInfoArr = NULL;
       *numSessOut = 0;
 
-      if(NULL == gSessionList)
+      // the session fields are copied out while the handle table pins the sessions
+      infos = g_array_new(FALSE, TRUE, sizeof(sessionInfo));
+      numSess = cgmi_handle_foreach(&gSessionHandles, cgmi_session_info_append, infos);
+      if(0 == numSess)
       {
          GST_WARNING("No Active CGMI sessions\n");
+         g_array_free(infos, TRUE);
          stat = CGMI_ERROR_SUCCESS;
          break;
       }
 
-      listLen = g_list_length(gSessionList);
-      GST_WARNING("Total CGMI sessions: %d\n", listLen);
-
-      *sessInfoArr = g_malloc0(sizeof(sessionInfo) * listLen);
-      if(NULL == *sessInfoArr)
-      {
-         GST_ERROR("Failed to alloc sessInfoArr array\n");
-         break;
-      }
-
-      for(list = gSessionList; list != NULL; list = list->next)
-      {
-         pSess = (tSession *)list->data;
-
-         if(FALSE == pSess->hasFullGstPipeline)
-         {
-            continue;
-         }
-         if(strncmp("dlna+", pSess->playbackURI, strlen("dlna+")))
-         {
-            g_strlcpy((*sessInfoArr)[*numSessOut].uri, pSess->playbackURI,
-                  sizeof((*sessInfoArr)[*numSessOut].uri));
-         }
-         else
-         {
-            g_strlcpy((*sessInfoArr)[*numSessOut].uri, &(pSess->playbackURI[strlen("dlna+")]),
-                  sizeof((*sessInfoArr)[*numSessOut].uri));
-         }
-         (*sessInfoArr)[*numSessOut].hwAudioDecHandle = pSess->hwAudioDecHandle;
-         (*sessInfoArr)[*numSessOut].hwVideoDecHandle = pSess->hwVideoDecHandle;
+      GST_WARNING("Total CGMI sessions: %d\n", numSess);
 
-         (*numSessOut)++;
-      }
+      *numSessOut = infos->len;
+      *sessInfoArr = (sessionInfo *)g_array_free(infos, FALSE);
 
       GST_WARNING("Total active CGMI sessions: %d\n", *numSessOut);
 
       stat = CGMI_ERROR_SUCCESS;
    }while(0);
 
-   g_mutex_unlock(&gSessionListMutex);
-
    return stat;
 }
 
 cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
 {
    cgmi_Status stat = CGMI_ERROR_FAILED;
-   tSession    *pSess = (tSession*)pSession;
+   tSession    *pSess = cgmi_LookupSession(pSession);
    gint        ii = 0;
    gchar       audioLanguage[4] = "";
    gchar       *pAudioLanguage = NULL;
@@ -2729,6 +5796,8 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
    void        *cpblob = NULL;
    float       position = 0.0;
    gint        currAudioLangArrIdx = INVALID_INDEX;
+   tPsiSnapshot *snap = NULL;
+   tAudioLang  *audioLanguages;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2748,7 +5817,11 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
          break;
       }
 
-      if ( index > pSess->numAudioLanguages - 1 || index < 0 )
+      // Unload below publishes empty tables, keep referencing these
+      snap = cgmi_psi_snapshot_get(pSess);
+      audioLanguages = snap->tables.audioLanguages;
+
+      if ( index > snap->tables.numAudioLanguages - 1 || index < 0 )
       {
          GST_ERROR("Bad index value passed for audio language!\n");
          stat = CGMI_ERROR_BAD_PARAM;
@@ -2761,10 +5834,10 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
          g_strlcpy(pSess->currAudioLanguage, pAudioLanguage, sizeof(pSess->currAudioLanguage));
       }
 
-      for(ii = 0; ii < pSess->numAudioLanguages; ii++)
+      for(ii = 0; ii < snap->tables.numAudioLanguages; ii++)
       {
-         if(!strncmp(pSess->currAudioLanguage, pSess->audioLanguages[ii].isoCode,
-                  sizeof(pSess->audioLanguages[ii].isoCode)))
+         if(!strncmp(pSess->currAudioLanguage, audioLanguages[ii].isoCode,
+                  sizeof(audioLanguages[ii].isoCode)))
          {
             currAudioLangArrIdx = ii;
             break;
@@ -2775,29 +5848,29 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
       {
          /* Log for debugging */
          GST_WARNING("Switching from %s audio language %s to %s audio language %s\n",
-               (pSess->audioLanguages[currAudioLangArrIdx].bDiscrete == TRUE)? "discrete":"muxed",
-               pSess->audioLanguages[currAudioLangArrIdx].isoCode,
-               (pSess->audioLanguages[index].bDiscrete == TRUE)? "discrete":"muxed",
-               pSess->audioLanguages[index].isoCode);
+               (audioLanguages[currAudioLangArrIdx].bDiscrete == TRUE)? "discrete":"muxed",
+               audioLanguages[currAudioLangArrIdx].isoCode,
+               (audioLanguages[index].bDiscrete == TRUE)? "discrete":"muxed",
+               audioLanguages[index].isoCode);
       }
 
-      if((INVALID_INDEX != currAudioLangArrIdx) && (pSess->audioLanguages[index].bDiscrete !=
-               pSess->audioLanguages[currAudioLangArrIdx].bDiscrete))
+      if((INVALID_INDEX != currAudioLangArrIdx) && (audioLanguages[index].bDiscrete !=
+               audioLanguages[currAudioLangArrIdx].bDiscrete))
       {
          /* Muxed <-> Discrete */
          autoPlay = pSess->autoPlay;
          cpblob = pSess->cpblob;
          uri = g_strdup(pSess->playbackURI);
-         g_strlcpy(audioLanguage, pSess->audioLanguages[index].isoCode, sizeof(audioLanguage));
+         g_strlcpy(audioLanguage, audioLanguages[index].isoCode, sizeof(audioLanguage));
 
-         stat = cgmi_GetPosition(pSess, &position);
+         stat = cgmi_GetPosition(pSess->handle, &position);
          if(CGMI_ERROR_SUCCESS != stat)
          {
             GST_ERROR("cgmi_GetPosition() failed\n");
             break;
          }
 
-         stat = cgmi_Unload(pSess);
+         stat = cgmi_Unload(pSess->handle);
          if(CGMI_ERROR_SUCCESS != stat)
          {
             GST_ERROR("cgmi_Unload() failed\n");
@@ -2809,7 +5882,7 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
 
          g_rec_mutex_unlock(&pSess->psiMutex);
 
-         stat = cgmi_Load(pSess, uri, cpblob, pSess->sessionSettingsStr);
+         stat = cgmi_Load(pSess->handle, uri, cpblob, pSess->sessionSettingsStr);
          if(CGMI_ERROR_SUCCESS != stat)
          {
             GST_ERROR("cgmi_Load() failed\n");
@@ -2817,7 +5890,7 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
             break;
          }
 
-         stat = cgmi_SetPosition(pSess, position);
+         stat = cgmi_SetPosition(pSess->handle, position);
          if(CGMI_ERROR_SUCCESS != stat)
          {
             GST_ERROR("cgmi_SetPosition() failed\n");
@@ -2825,7 +5898,7 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
             break;
          }
 
-         stat = cgmi_Play(pSess, autoPlay);
+         stat = cgmi_Play(pSess->handle, autoPlay);
          if(CGMI_ERROR_SUCCESS != stat)
          {
             GST_ERROR("cgmi_Play() failed\n");
@@ -2839,26 +5912,26 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
          stat = CGMI_ERROR_SUCCESS;
       }
       else if((INVALID_INDEX != currAudioLangArrIdx) &&
-              (TRUE == pSess->audioLanguages[index].bDiscrete) &&
-              (TRUE == pSess->audioLanguages[currAudioLangArrIdx].bDiscrete))
+              (TRUE == audioLanguages[index].bDiscrete) &&
+              (TRUE == audioLanguages[currAudioLangArrIdx].bDiscrete))
       {
          /* Discrete <-> Discrete */
          if(NULL != pSess->hlsDemux)
          {
-            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", pSess->audioLanguages[index].isoCode, NULL);
-            g_strlcpy(pSess->currAudioLanguage, pSess->audioLanguages[index].isoCode, sizeof(pSess->currAudioLanguage));
-            pSess->audioLanguageIndex = pSess->audioLanguages[index].index;
+            g_object_set( G_OBJECT(pSess->hlsDemux), "audio-language", audioLanguages[index].isoCode, NULL);
+            g_strlcpy(pSess->currAudioLanguage, audioLanguages[index].isoCode, sizeof(pSess->currAudioLanguage));
+            pSess->audioLanguageIndex = audioLanguages[index].index;
             stat = CGMI_ERROR_SUCCESS;
          }
       }
-      else if(FALSE == pSess->audioLanguages[index].bDiscrete)
+      else if(FALSE == audioLanguages[index].bDiscrete)
       {
-         if(INVALID_INDEX != pSess->audioLanguages[index].index)
+         if(INVALID_INDEX != audioLanguages[index].index)
          {
             GST_WARNING("Setting audio stream index to %d for language %s\n",
-                  pSess->audioLanguages[index].index, pSess->audioLanguages[index].isoCode);
+                  audioLanguages[index].index, audioLanguages[index].isoCode);
 
-            pSess->audioLanguageIndex = pSess->audioLanguages[index].index;
+            pSess->audioLanguageIndex = audioLanguages[index].index;
 
             if ( NULL == pSess->demux )
             {
@@ -2868,7 +5941,7 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
             }
 
             g_object_set( G_OBJECT(pSess->demux), "audio-stream", pSess->audioLanguageIndex, NULL );
-            g_strlcpy(pSess->currAudioLanguage, pSess->audioLanguages[index].isoCode, sizeof(pSess->currAudioLanguage));
+            g_strlcpy(pSess->currAudioLanguage, audioLanguages[index].isoCode, sizeof(pSess->currAudioLanguage));
             stat = CGMI_ERROR_SUCCESS;
          }
          else
@@ -2883,6 +5956,8 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
 
    g_rec_mutex_unlock(&pSess->psiMutex);
 
+   cgmi_psi_snapshot_put(snap);
+
    if(NULL != uri)
    {
       g_free(uri);
@@ -2905,7 +5980,7 @@ cgmi_Status cgmi_SetAudioStream ( void *pSession, int index )
 
 cgmi_Status cgmi_SetDefaultAudioLang ( void *pSession, const char *language )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( NULL == language )
    {
@@ -2929,7 +6004,8 @@ cgmi_Status cgmi_SetDefaultAudioLang ( void *pSession, const char *language )
 
 cgmi_Status cgmi_GetNumClosedCaptionServices (void *pSession,  int *count)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2943,14 +6019,17 @@ cgmi_Status cgmi_GetNumClosedCaptionServices (void *pSession,  int *count)
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   *count = pSess->numClosedCaptionServices;
+   snap = cgmi_psi_snapshot_get(pSess);
+   *count = snap->tables.numClosedCaptionServices;
+   cgmi_psi_snapshot_put(snap);
 
    return CGMI_ERROR_SUCCESS;
 }
 
 cgmi_Status cgmi_GetClosedCaptionServiceInfo (void *pSession, int index, char* isoCode, int isoCodeSize, int *serviceNum, char *isDigital)
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -2964,18 +6043,23 @@ cgmi_Status cgmi_GetClosedCaptionServiceInfo (void *pSession, int index, char* i
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   if ( index > pSess->numClosedCaptionServices - 1 || index < 0 )
+   snap = cgmi_psi_snapshot_get(pSess);
+
+   if ( index > snap->tables.numClosedCaptionServices - 1 || index < 0 )
    {
       g_print("Bad index value passed for closed caption language!\n");
+      cgmi_psi_snapshot_put(snap);
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   strncpy( isoCode, pSess->closedCaptionServices[index].isoCode, isoCodeSize );
+   strncpy( isoCode, snap->tables.closedCaptionServices[index].isoCode, isoCodeSize );
    isoCode[isoCodeSize - 1] = 0;
 
-   *serviceNum = pSess->closedCaptionServices[index].serviceNum;
+   *serviceNum = snap->tables.closedCaptionServices[index].serviceNum;
+
+   *isDigital = snap->tables.closedCaptionServices[index].isDigital;
 
-   *isDigital = pSess->closedCaptionServices[index].isDigital;
+   cgmi_psi_snapshot_put(snap);
 
    return CGMI_ERROR_SUCCESS;
 }
@@ -2985,7 +6069,7 @@ cgmi_Status cgmi_startUserDataFilter( void *pSession, userDataBufferCB bufferCB,
    GstCaps *caps = NULL;
    GstStateChangeReturn stateChangeRet;
 
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
@@ -3071,7 +6155,7 @@ cgmi_Status cgmi_startUserDataFilter( void *pSession, userDataBufferCB bufferCB,
 
 cgmi_Status cgmi_stopUserDataFilter( void *pSession, userDataBufferCB bufferCB )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
@@ -3111,7 +6195,8 @@ cgmi_Status cgmi_stopUserDataFilter( void *pSession, userDataBufferCB bufferCB )
 
 cgmi_Status cgmi_GetNumPids( void *pSession, int *pCount )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
@@ -3124,14 +6209,17 @@ cgmi_Status cgmi_GetNumPids( void *pSession, int *pCount )
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   *pCount = pSess->numStreams;
+   snap = cgmi_psi_snapshot_get(pSess);
+   *pCount = snap->tables.numStreams;
+   cgmi_psi_snapshot_put(snap);
 
    return CGMI_ERROR_SUCCESS;
 }
 
 cgmi_Status cgmi_GetPidInfo( void *pSession, int index, tcgmi_PidData *pPidData )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
@@ -3144,21 +6232,26 @@ cgmi_Status cgmi_GetPidInfo( void *pSession, int index, tcgmi_PidData *pPidData
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   if ( index < 0 || index > pSess->numStreams - 1 )
+   snap = cgmi_psi_snapshot_get(pSess);
+
+   if ( index < 0 || index > snap->tables.numStreams - 1 )
    {
-      g_print("Index out of range [0, %d]!\n", pSess->numStreams - 1);
+      g_print("Index out of range [0, %d]!\n", snap->tables.numStreams - 1);
+      cgmi_psi_snapshot_put(snap);
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   pPidData->pid = pSess->streams[index].pid;
-   pPidData->streamType = pSess->streams[index].streamType;
+   pPidData->pid = snap->tables.streams[index].pid;
+   pPidData->streamType = snap->tables.streams[index].streamType;
+
+   cgmi_psi_snapshot_put(snap);
 
    return CGMI_ERROR_SUCCESS;
 }
 
 cgmi_Status cgmi_SetPidInfo( void *pSession, int index, tcgmi_StreamType type, int enable )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
       g_print("%s:Invalid session handle\n", __FUNCTION__);
@@ -3221,6 +6314,89 @@ cgmi_Status cgmi_SetPidInfo( void *pSession, int index, tcgmi_StreamType type, i
 }
 
 
+//
+// Re-points the demux to another program of the multiplex.  The source and
+// demux keep running, and when the program's PMT is cached already its
+// tables are applied right away instead of waiting for the demux.
+//
+cgmi_Status cgmi_SelectProgram( void *pSession, int programNumber )
+{
+   cgmi_Status stat = CGMI_ERROR_SUCCESS;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiProgramEntry *prog;
+   guint changed = 0;
+   gint index;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   if ( programNumber <= 0 )
+   {
+      g_print("Bad program number passed!\n");
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+   g_rec_mutex_lock(&pSess->psiMutex);
+
+   do
+   {
+      if ( NULL == pSess->demux || NULL == pSess->psiPrograms )
+      {
+         g_print("PAT is not available yet, cannot select program!\n");
+         stat = CGMI_ERROR_NOT_READY;
+         break;
+      }
+
+      prog = cgmi_psi_program_find( pSess, programNumber, &index );
+      if ( NULL == prog )
+      {
+         g_print("Program %d is not in the PAT!\n", programNumber);
+         stat = CGMI_ERROR_BAD_PARAM;
+         break;
+      }
+
+      if ( prog->programNumber == pSess->psiPmtProgram )
+         break;
+
+      g_print("Switching from program %d to program %d (PMT pid 0x%04x, %s)\n", pSess->psiPmtProgram,
+              programNumber, prog->pmtPid, prog->valid ? "cached" : "not cached");
+
+      pSess->psiPmtProgram = prog->programNumber;
+      pSess->audioLanguageIndex = INVALID_INDEX;
+      pSess->subtitleLanguageIndex = INVALID_INDEX;
+      pSess->currAudioLanguage[0] = '\0';
+
+      /* the demux takes the 1-based position of the program in the PAT */
+      g_object_set( G_OBJECT(pSess->demux), "program-number", index + 1, NULL );
+
+      if ( TRUE == prog->valid )
+      {
+         changed = cgmi_psi_apply( pSess, &prog->pmt ) | CGMI_PSI_CHANGED_SELECTED_PROGRAM;
+         pSess->psiPmtVersion = prog->pmtVersion;
+         pSess->psiSwitchPending = FALSE;
+         cgmi_psi_cache_remember( pSess, prog->programNumber, &prog->pmt );
+      }
+      else
+      {
+         // whichever of the section filter and cgmi_gst_psi_info gets the
+         // program's PMT first applies it and reports the switch
+         pSess->psiSwitchPending = TRUE;
+         pSess->psiPmtHash = PSI_HASH_INIT;
+      }
+
+   }while(0);
+
+   g_rec_mutex_unlock(&pSess->psiMutex);
+
+   if ( 0 != changed )
+      cgmi_psi_report( pSess, G_OBJECT(pSess->demux), changed, FALSE );
+
+   return stat;
+}
+
 static gboolean
 parse_debug_category (gchar * str, const gchar ** category)
 {
@@ -3314,11 +6490,115 @@ cgmi_Status cgmi_SetLogging(const char *gstDebugStr)
    return stat;
 }
 
+cgmi_Status cgmi_GetAvSyncStats(void *pSession, tcgmi_AvSyncStats *pStats)
+{
+   tSession *pSess = cgmi_LookupSession(pSession);
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   if ( NULL == pStats )
+   {
+      g_print("%s: pStats param is NULL\n", __FUNCTION__);
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+#if defined (DISABLE_MONITORING)
+   return CGMI_ERROR_NOT_SUPPORTED;
+#else
+   g_mutex_lock( &pSess->avSyncMutex );
+   *pStats = pSess->avSync;
+   pStats->sampleIntervalMs = pSess->monitorIntervalMs;
+   g_mutex_unlock( &pSess->avSyncMutex );
+
+   return CGMI_ERROR_SUCCESS;
+#endif
+}
+
+cgmi_Status cgmi_GetDecoderStats(void *pSession, tcgmi_DecoderStats *pStats)
+{
+   tSession *pSess = cgmi_LookupSession(pSession);
+#if !defined (DISABLE_MONITORING)
+   guint first;
+   guint ii;
+#endif
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   if ( NULL == pStats )
+   {
+      g_print("%s: pStats param is NULL\n", __FUNCTION__);
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+#if defined (DISABLE_MONITORING)
+   return CGMI_ERROR_NOT_SUPPORTED;
+#else
+   memset( pStats, 0, sizeof(*pStats) );
+
+   g_mutex_lock( &pSess->decStatsMutex );
+   pStats->current = pSess->decStatsCurrent;
+   pStats->intervalMs = DECODER_STATS_INTERVAL_MS;
+   pStats->numIntervals = pSess->decStatsCount;
+
+   // unroll the ring, oldest entry first
+   first = (pSess->decStatsHead + CGMI_DECODER_STATS_HISTORY - pSess->decStatsCount) % CGMI_DECODER_STATS_HISTORY;
+   for ( ii = 0; ii < pSess->decStatsCount; ii++ )
+   {
+      pStats->history[ii] = pSess->decStatsHistory[(first + ii) % CGMI_DECODER_STATS_HISTORY];
+   }
+   g_mutex_unlock( &pSess->decStatsMutex );
+
+   return CGMI_ERROR_SUCCESS;
+#endif
+}
+
+cgmi_Status cgmi_GetEventQueueStats(void *pSession, tcgmi_EventQueueStats *pStats)
+{
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tEventQueue *pQueue;
+
+   if ( cgmi_CheckSessionHandle(pSess) == FALSE )
+   {
+      g_print("%s:Invalid session handle\n", __FUNCTION__);
+      return CGMI_ERROR_INVALID_HANDLE;
+   }
+
+   if ( NULL == pStats )
+   {
+      g_print("%s: pStats param is NULL\n", __FUNCTION__);
+      return CGMI_ERROR_BAD_PARAM;
+   }
+
+   pQueue = pSess->eventQueue;
+   if ( NULL == pQueue )
+   {
+      return CGMI_ERROR_FAILED;
+   }
+
+   g_mutex_lock( &pQueue->mutex );
+   pStats->currentDepth = (unsigned int)MAX( g_atomic_int_get(&pQueue->depth), 0 );
+   pStats->maxDepth = (unsigned int)g_atomic_int_get( &pQueue->maxDepth );
+   pStats->numDispatched = pQueue->numDispatched;
+   pStats->avgLatencyUs = pQueue->numDispatched ? (unsigned int)(pQueue->totalLatencyUs / pQueue->numDispatched) : 0;
+   pStats->maxLatencyUs = (unsigned int)pQueue->maxLatencyUs;
+   g_mutex_unlock( &pQueue->mutex );
+
+   return CGMI_ERROR_SUCCESS;
+}
+
 cgmi_Status cgmi_GetTsbSlide(void *pSession, unsigned long *pTsbSlide)
 {
    cgmi_Status   stat = CGMI_ERROR_FAILED;
    gboolean is_live = FALSE;
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    do
    {
@@ -3360,7 +6640,8 @@ cgmi_Status cgmi_GetTsbSlide(void *pSession, unsigned long *pTsbSlide)
 
 cgmi_Status cgmi_GetNumSubtitleLanguages( void *pSession, int *count )
 {
-   tSession *pSess = (tSession *)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -3374,7 +6655,9 @@ cgmi_Status cgmi_GetNumSubtitleLanguages( void *pSession, int *count )
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   *count = pSess->numSubtitleLanguages;
+   snap = cgmi_psi_snapshot_get(pSess);
+   *count = snap->tables.numSubtitleLanguages;
+   cgmi_psi_snapshot_put(snap);
 
    return CGMI_ERROR_SUCCESS;
 }
@@ -3382,7 +6665,8 @@ cgmi_Status cgmi_GetNumSubtitleLanguages( void *pSession, int *count )
 cgmi_Status cgmi_GetSubtitleInfo( void *pSession, int index, char *buf, int bufSize, unsigned short *pid,
                                   unsigned char *type, unsigned short *compPageId, unsigned short *ancPageId )
 {
-   tSession *pSess = (tSession *)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tPsiSnapshot *snap;
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -3396,42 +6680,47 @@ cgmi_Status cgmi_GetSubtitleInfo( void *pSession, int index, char *buf, int bufS
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   if ( index > pSess->numSubtitleLanguages - 1 || index < 0 )
+   snap = cgmi_psi_snapshot_get(pSess);
+
+   if ( index > snap->tables.numSubtitleLanguages - 1 || index < 0 )
    {
       g_print("Bad index value passed for subtitle language!\n");
+      cgmi_psi_snapshot_put(snap);
       return CGMI_ERROR_BAD_PARAM;
    }
 
-   strncpy(buf, pSess->subtitleInfo[index].isoCode, bufSize);
+   strncpy(buf, snap->tables.subtitleInfo[index].isoCode, bufSize);
    buf[bufSize - 1] = 0;
 
    if ( pid != NULL )
    {
-      *pid = pSess->subtitleInfo[index].pid;
+      *pid = snap->tables.subtitleInfo[index].pid;
    }
 
    if ( type != NULL )
    {
-      *type = pSess->subtitleInfo[index].type;
+      *type = snap->tables.subtitleInfo[index].type;
    }
 
    if (  compPageId != NULL )
    {
-      *compPageId = pSess->subtitleInfo[index].compPageId;
+      *compPageId = snap->tables.subtitleInfo[index].compPageId;
    }
 
    if ( ancPageId != NULL )
    {
-      *ancPageId = pSess->subtitleInfo[index].ancPageId;
+      *ancPageId = snap->tables.subtitleInfo[index].ancPageId;
    }
 
+   cgmi_psi_snapshot_put(snap);
+
    return CGMI_ERROR_SUCCESS;
 }
 
 cgmi_Status cgmi_SetDefaultSubtitleLang( void *pSession, const char *language )
 {
    char *ptr;
-   tSession *pSess = (tSession *)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( NULL == language )
    {
@@ -3454,7 +6743,7 @@ cgmi_Status cgmi_SetDefaultSubtitleLang( void *pSession, const char *language )
 cgmi_Status cgmi_GetStc(void *pSession, uint64_t *pStc)
 {
    cgmi_Status stat = CGMI_ERROR_FAILED;
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    do
    {
@@ -3490,7 +6779,7 @@ cgmi_Status cgmi_GetStc(void *pSession, uint64_t *pStc)
 
 cgmi_Status cgmi_SetPictureSetting( void *pSession, tcgmi_PictureCtrl pctl, int value )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -3539,7 +6828,7 @@ cgmi_Status cgmi_SetPictureSetting( void *pSession, tcgmi_PictureCtrl pctl, int
 
 cgmi_Status cgmi_GetPictureSetting( void *pSession, tcgmi_PictureCtrl pctl, int *pvalue )
 {
-   tSession *pSess = (tSession*)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
 
    if ( cgmi_CheckSessionHandle(pSess) == FALSE )
    {
@@ -12,6 +12,7 @@ extern "C"
 #define MAX_SUBTITLE_LANGUAGES         16
 #define MAX_CLOSED_CAPTION_SERVICES    71
 #define MAX_STREAMS                    32
+#define MAX_PSI_SECTION_SIZE           1024   /* PAT/PMT sections never exceed this */
 #define SOCKET_RECEIVE_BUFFER_SIZE     1000000
 #define UDP_CHUNK_SIZE                 (1316*32)
 #define VIDEO_MAX_WIDTH                1920
@@ -57,20 +58,141 @@ typedef struct
    gint streamType;
 }tCgmiStream;
 
+/* audio/subtitle/CC and stream tables decoded from one PMT */
+typedef struct
+{
+   tAudioLang     audioLanguages[MAX_AUDIO_LANGUAGE_DESCRIPTORS];
+   tCCLang        closedCaptionServices[MAX_CLOSED_CAPTION_SERVICES];
+   tSubtitleInfo  subtitleInfo[MAX_SUBTITLE_LANGUAGES];
+   tCgmiStream    streams[MAX_STREAMS];
+   gint           numAudioLanguages;
+   gint           numClosedCaptionServices;
+   gint           numSubtitleLanguages;
+   gint           numStreams;
+}tPsiTables;
+
+/*
+ * PSI as published to the track info getters.  A snapshot is never modified
+ * once published; writers build a new one under psiMutex and swap it in,
+ * readers take a reference without locking (see cgmi_psi_snapshot_get).
+ */
+typedef struct
+{
+   gint           refCount;
+   tPsiTables     tables;
+}tPsiSnapshot;
+
 typedef struct
 {
    gchar audioLanguage[4];
 }tSessionSettings;
 
+/* one of the shared threads dispatching session bus messages */
 typedef struct
 {
-   void*              cookie;
-   GMainContext       *thread_ctx; 
+   GMainContext       *ctx;
+   GMainLoop          *loop;
    GThread            *thread;
+   gint               numSessions;
+}tDispatcher;
+
+#define AVSYNC_HISTORY_SIZE            32     /* drift samples the slope is fitted over */
+
+/* how to build playbin, the platform part is probed once in cgmi_Init */
+typedef struct
+{
+   gboolean           bInitialized;
+   gboolean           bisBroadcomHw;
+   GstElementFactory  *playbinFactory;
+   GstElementFactory  *videoSinkFactory;   /* forced video sink, NULL lets playbin autoplug */
+   guint              flags;               /* playbin flags, 0 keeps the playbin default */
+}tLaunchTemplate;
+
+/*
+ * Handles given to applications (sessions, section filters) are a slot index
+ * plus a generation count instead of raw pointers.  Lookups are lock free, a
+ * stale or forged handle resolves to NULL instead of being dereferenced.
+ *
+ *    31           12 11  10 9        0
+ *   +---------------+------+----------+
+ *   |  generation   | type |   slot   |
+ *   +---------------+------+----------+
+ */
+#define CGMI_HANDLE_SLOT_BITS          10
+#define CGMI_HANDLE_TYPE_BITS          2
+#define CGMI_HANDLE_GEN_BITS           (32 - CGMI_HANDLE_SLOT_BITS - CGMI_HANDLE_TYPE_BITS)
+#define CGMI_HANDLE_MAX_SLOTS          (1 << CGMI_HANDLE_SLOT_BITS)
+
+typedef enum
+{
+   CGMI_HANDLE_TYPE_SESSION = 1,
+   CGMI_HANDLE_TYPE_FILTER  = 2
+}tCgmiHandleType;
+
+typedef struct
+{
+   tCgmiHandleType    type;
+   GMutex             mutex;                           /* serializes alloc/free, lookups never take it */
+   gpointer           object[CGMI_HANDLE_MAX_SLOTS];
+   gint               live[CGMI_HANDLE_MAX_SLOTS];     /* generation in use, 0 while the slot is free */
+   guint              lastGen[CGMI_HANDLE_MAX_SLOTS];
+   guint              nextSlot;
+   guint              count;
+}tCgmiHandleTable;
+
+/* event waiting to be delivered to the application, see cgmi_event_emit */
+typedef struct _tEventRecord
+{
+   struct _tEventRecord *next;
+   cgmi_EventCallback   eventCB;
+   void                 *usrParam;
+   void                 *handle;
+   tcgmi_Event          event;
+   uint64_t             code;
+   gint64               queuedTime;
+}tEventRecord;
+
+/*
+ * Per session event queue.  Emitters push lock free, one event pool thread
+ * at a time drains it in emit order.  It is kept when the session goes back
+ * to the pool so a drain still running never sees a recycled session, and
+ * is refcounted so one running when the session is freed never sees a
+ * freed queue.
+ */
+typedef struct
+{
+   tEventRecord       *pending;                   /* newest first, taken whole by the dispatcher */
+   gint               refCount;                   /* the session's, plus one while a drain is scheduled */
+   gint               scheduled;                  /* a drain is queued or running */
+   gint               depth;
+   gint               maxDepth;
+   GMutex             mutex;                      /* stats and the idle handshake */
+   GCond              idleCond;
+   GThread            *dispatchThread;
+   guint64            numDispatched;
+   gint64             totalLatencyUs;
+   gint64             maxLatencyUs;
+}tEventQueue;
+
+/* HTTP protocol probe running alongside pipeline construction in cgmi_Load */
+typedef struct
+{
+   GThread       *thread;
+   gchar         uri[MAX_URI_SIZE];
+   gchar         playbackURI[MAX_URI_SIZE];
+   gboolean      bisDLNAContent;
+   cgmi_Status   stat;
+   unsigned int  diagIndex;
+}tDlnaProbe;
+
+typedef struct
+{
+   void*              cookie;
+   void*              handle;                     /* what the application sees, see tCgmiHandleTable */
+   GMainContext       *thread_ctx;                /* context of the shared dispatcher */
+   tDispatcher        *dispatcher;
    GSource            *sourceWatch;
-   GThread            *monitor;
    gchar              playbackURI[MAX_URI_SIZE]; /* URI to playback */
-   GMainLoop          *loop;
    GstElement         *pipeline;
    GstElement         *source;
    GstElement         *videoSink;
@@ -85,20 +207,17 @@ typedef struct
    void*              usrParam;
    tCgmiRect          vidSrcRect;
    tCgmiRect          vidDestRect;
-   tAudioLang         audioLanguages[MAX_AUDIO_LANGUAGE_DESCRIPTORS];
-   tCCLang            closedCaptionServices[MAX_CLOSED_CAPTION_SERVICES];
-   tSubtitleInfo      subtitleInfo[MAX_SUBTITLE_LANGUAGES];
+   tPsiSnapshot       *psiSnapshot;            /* streams, audio, subtitle and CC tables */
+   gint               psiReaders;              /* getters between loading psiSnapshot and referencing it */
+   GSList             *psiRetired;             /* replaced snapshots a getter may still be referencing, psiMutex */
+   GSource            *psiAudioSource;         /* cgmi_psi_audio_query still to run, psiMutex */
    gchar              defaultAudioLanguage[4];
    gchar              defaultSubtitleLanguage[4];
-   gint               numAudioLanguages;
    gint               audioLanguageIndex;
-   gint               numClosedCaptionServices;
-   gint               numStreams;
-   gint               numSubtitleLanguages;
    gint               subtitleLanguageIndex;
-   tCgmiStream        streams[MAX_STREAMS];
    /* user registered data */ 
    cgmi_EventCallback eventCB;
+   tEventQueue        *eventQueue;               /* eventCB only ever runs from here */
    GstElement         *userDataAppsink;
    GstPad             *userDataPad;
    GstPad             *userDataAppsinkPad;
@@ -120,7 +239,7 @@ typedef struct
    float              pendingSeekPosition;
    gboolean           bisDLNAContent;
    gboolean           steadyState;
-   guint              steadyStateWindow;
+   guint              steadyStateWindow;       /* ms */
    gboolean           maskRateChangedEvent;
    gboolean           noVideo;
    gboolean           bQueryDiscreteAudioInfo;
@@ -130,22 +249,101 @@ typedef struct
    gchar              newAudioLanguage[4];
    gboolean           suppressLoadDone;
    gboolean           isPlaying;
-   GRecMutex          psiMutex;
-   GMutex             monThreadMutex;
-   GCond              monThreadCond;
+   GRecMutex          psiMutex;                /* serializes PSI writers, readers go through psiSnapshot */
+   /* last PSI applied by cgmi_gst_psi_info, repeats of it are skipped */
+   gboolean           psiValid;
+   guint32            psiPatHash;
+   gint               psiPmtVersion;
+   guint32            psiPmtHash;
+   gint               psiNumPmtAudio;          /* leading audioLanguages entries that came from the PMT */
+   /* every program of the PAT, PMTs fed raw from demux section filters, see cgmi_psi_filter_open */
+   guint              psiPmtProgram;           /* program number of the selected program */
+   gboolean           psiSwitchPending;        /* its PMT is not applied yet, psiMutex */
+   GPtrArray          *psiPrograms;            /* tPsiProgramEntry in PAT order, psiMutex */
+   GPtrArray          *psiStalePrograms;       /* left the PAT, filters still to be destroyed */
+   tPsiTables         psiRaw;                  /* PMT being decoded, psiMutex */
+   GMutex             psiFilterMutex;          /* filterId of the entries and psiFilterSource */
+   GSource            *psiFilterSource;        /* cgmi_psi_filter_open still to run */
+   /* PSI published from the cache at load until the live PSI is in, see cgmi_psi_cache_seed */
+   gchar              psiCacheKey[MAX_URI_SIZE];    /* uri as passed to cgmi_Load */
+   gboolean           psiFromCache;
+   guint              psiCacheProgram;
+   guint              psiCacheProgramIndex;    /* 1-based position of psiCacheProgram in the PAT */
    gchar              *sessionSettingsStr;
    tSessionSettings   sessionSettings;
    gboolean           hasFullGstPipeline;
    void               *hwVideoDecHandle;
    void               *hwAudioDecHandle;
+   /* speculative "shadow" pipeline prerolled by cgmi_Preload */
+   GstElement         *preloadPipeline;
+   gchar              preloadURI[MAX_URI_SIZE];          /* uri as passed to cgmi_Preload */
+   gchar              preloadPlaybackURI[MAX_URI_SIZE];  /* uri handed to playbin */
+   gboolean           preloadIsDLNAContent;
+   gint               preloadPsiReady;
+   /* cgmi_LoadAsync: preroll completion is reported from the bus handler */
+   GMutex             asyncLoadMutex;
+   gboolean           asyncLoadPending;
+   GSource            *asyncLoadTimeout;
+   GCond              asyncLoadCond;
+   gboolean           asyncLoadJob;            /* cgmi_load_finish_func queued or running */
+   /* old pipelines still being torn down by the reaper */
+   GMutex             reapMutex;
+   GCond              reapCond;
+   gint               reapPending;
+   /* decoder health sampling, serviced by the shared monitor thread */
+   guint              monitorIntervalMs;
+   gint64             monitorNextRun;
+   guint              videoPtsErrorsPrev;
+   guint              videoDecodeDropsPrev;
+   guint              videoDecodeErrorsPrev;
+   guint              audioPtsErrorsPrev;
+   guint              errorWindow;             /* ms */
+   gint64             monitorLastSample;       /* last drift sample */
+   gint64             counterLastPoll;         /* last error counter read */
+   gint64             counterNextPoll;
+   gboolean           decoderNotifies;         /* counters arrive via notify:: */
+   /* current | pending << 8 as last seen on the bus, read without blocking */
+   gint               cachedState;
+   /* A/V sync analyzer, fed by the monitor and read by cgmi_GetAvSyncStats */
+   GMutex             avSyncMutex;
+   tcgmi_AvSyncStats  avSync;
+   gint               avDriftMs[AVSYNC_HISTORY_SIZE];
+   gint64             avDriftTime[AVSYNC_HISTORY_SIZE];
+   guint              avDriftHead;
+   guint              avDriftCount;
+   guint              avDriftSustainedMs;
+   /* decoder counter history, read by cgmi_GetDecoderStats */
+   GMutex                 decStatsMutex;
+   tcgmi_DecoderCounters  decStatsCurrent;
+   tcgmi_DecoderCounters  decStatsBase;              /* counters when the open interval started */
+   gint64                 decStatsIntervalStart;
+   tcgmi_DecoderCounters  decStatsHistory[CGMI_DECODER_STATS_HISTORY];
+   guint                  decStatsHead;
+   guint                  decStatsCount;
 }tSession;
 
+/* One program of the multiplex and the last PMT seen for it */
+typedef struct
+{
+   tSession       *pSess;
+   guint          programNumber;
+   guint          pmtPid;
+   void           *filterId;
+   gboolean       valid;                         /* pmt holds a complete PMT */
+   guint          pmtVersion;
+   guint32        pmtCrc;
+   tPsiTables     pmt;
+   guchar         section[MAX_PSI_SECTION_SIZE];
+}tPsiProgramEntry;
+
 gboolean cisco_gst_init( int argc, char *argv[] );
 void cisco_gst_deinit( void );
 gint cisco_gst_set_pipeline(tSession *pSession, char *uri, const char *manualPipeline );
 tSession*  cisco_create_session(void * usrParam);
 void cisco_delete_session(tSession *pSession);
 
+tSession* cgmi_LookupSession(void *pSession);
+
 gint cisco_gst_play(tSession *pSession  );
 gint cisco_gst_pause(tSession *pSession  );
 
@@ -153,7 +351,12 @@ gint cisco_gst_pause(tSession *pSession  );
 cgmi_Status cgmi_utils_init(void);
 cgmi_Status cgmi_utils_finalize(void);
 cgmi_Status cgmi_utils_is_content_dlna(const gchar* url, gboolean *bisDLNAContent);
+gboolean cgmi_utils_is_dlna_detect_cached(const gchar* url);
 cgmi_Status cgmi_utils_get_json_value(gchar *output, gint outsize, const gchar *json, const gchar *name);
+void* cgmi_handle_alloc( tCgmiHandleTable *table, gpointer object );
+gpointer cgmi_handle_lookup( tCgmiHandleTable *table, const void *handle );
+gboolean cgmi_handle_free( tCgmiHandleTable *table, const void *handle );
+guint cgmi_handle_foreach( tCgmiHandleTable *table, GFunc func, gpointer userData );
 #ifdef __cplusplus
 }
 #endif
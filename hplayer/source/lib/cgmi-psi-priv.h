@@ -0,0 +1,56 @@
+#ifndef __CGMI_PSI_PRIV_H__
+#define __CGMI_PSI_PRIV_H__
+
+#include <glib.h>
+#include "cgmi-priv-player.h"
+#include "cgmiPlayerApi.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PSI_PID_PAT              0x0000
+#define PSI_TABLE_ID_PAT         0x00
+#define PSI_TABLE_ID_PMT         0x02
+#define PSI_MAX_PROGRAMS         64
+
+typedef struct
+{
+   guint          programNumber;
+   guint          pmtPid;
+}tPsiProgram;
+
+typedef struct
+{
+   guint          transportStreamId;
+   guint          version;
+   guint32        crc;
+   gint           numPrograms;
+   tPsiProgram    programs[PSI_MAX_PROGRAMS];   /* network PID (program 0) is left out */
+}tPsiPat;
+
+typedef struct
+{
+   guint          programNumber;
+   guint          version;
+   guint          pcrPid;
+   guint32        crc;
+}tPsiPmtHeader;
+
+guint32 cgmi_psi_crc32( const guchar *data, gint size );
+guint32 cgmi_psi_section_crc( const guchar *section, gint size );
+cgmi_Status cgmi_psi_parse_pat( const guchar *section, gint size, tPsiPat *pat );
+cgmi_Status cgmi_psi_parse_pmt( const guchar *section, gint size, tPsiPmtHeader *pmt, tPsiTables *psi );
+void cgmi_psi_parse_descriptors( tPsiTables *psi, gint stream, guint esPid, guint esType,
+                                 const guchar *desc, gint size );
+
+void cgmi_psi_cache_store( const gchar *uri, guint program, guint programIndex, const tPsiTables *psi );
+gboolean cgmi_psi_cache_lookup( const gchar *uri, guint *program, guint *programIndex, tPsiTables *psi );
+void cgmi_psi_cache_clear( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,489 @@
+/*
+    CGMI
+    Copyright (C) {2015}  {Cisco System}
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+
+    Contributing Authors: Matt Snoby, Kris Kersey, Zack Wine, Chris Foster,
+                          Tankut Akgul, Saravanakumar Periyaswamy
+
+*/
+
+/*
+ * PSI parser checks.  Feeds a captured PAT and PMT, every truncation of
+ * them and a few corrupted copies to cgmi_psi_parse_pat/cgmi_psi_parse_pmt
+ * and checks what comes out.  Run as "bench [iterations]" it also times
+ * parsing the raw PMT against the GObject walk cgmi_gst_psi_info does over
+ * the demux's stream-info objects.
+ */
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <glib.h>
+#include <glib-object.h>
+#include "cgmi-psi-priv.h"
+
+#define DEFAULT_BENCH_ITERATIONS 100000
+
+#define CHECK(cond) \
+   do { \
+      gChecks++; \
+      if ( !(cond) ) \
+      { \
+         g_print("CGMI_PSI_TEST %s:%d - %s :: Check failed: %s\n", __FILE__, __LINE__, __FUNCTION__, #cond); \
+         gFailures++; \
+      } \
+   } while(0)
+
+static int gChecks;
+static int gFailures;
+
+//
+// Captured PAT: transport stream 1, version 5, the network PID plus
+// program 1 on PID 0x100 and program 2 on PID 0x200.
+//
+static const guchar gPatSection[] =
+{
+   0x00, 0xB0, 0x15, 0x00, 0x01, 0xCB, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x10,
+   0x00, 0x01, 0xE1, 0x00, 0x00, 0x02, 0xE2, 0x00, 0xA0, 0x2D, 0x67, 0xCD
+};
+
+//
+// Captured PMT: program 1, version 3, PCR on 0x101, a CA descriptor in the
+// program info and
+//    0x101 video with a caption service descriptor (eng digital 1, spa line 21 field 1)
+//    0x102 audio, eng
+//    0x103 audio, spa
+//    0x104 DVB subtitles, eng, type 0x10, composition page 1, ancillary page 2
+//
+static const guchar gPmtSection[] =
+{
+   0x02, 0xB0, 0x4C, 0x00, 0x01, 0xC7, 0x00, 0x00, 0xE1, 0x01, 0xF0, 0x06,
+   0x09, 0x04, 0x0B, 0x00, 0xE7, 0xFF, 0x02, 0xE1, 0x01, 0xF0, 0x0F, 0x86,
+   0x0D, 0xE2, 0x65, 0x6E, 0x67, 0xC1, 0x3F, 0xFF, 0x73, 0x70, 0x61, 0x7E,
+   0x3F, 0xFF, 0x81, 0xE1, 0x02, 0xF0, 0x06, 0x0A, 0x04, 0x65, 0x6E, 0x67,
+   0x00, 0x81, 0xE1, 0x03, 0xF0, 0x06, 0x0A, 0x04, 0x73, 0x70, 0x61, 0x00,
+   0x06, 0xE1, 0x04, 0xF0, 0x0A, 0x59, 0x08, 0x65, 0x6E, 0x67, 0x10, 0x00,
+   0x01, 0x00, 0x02, 0xF9, 0x9B, 0x16, 0x78
+};
+
+#define PMT_FIRST_ES_OFFSET      18    /* fixed header plus the CA descriptor */
+#define PMT_CC_DESC_LEN_OFFSET   24
+
+//
+// Rewrites the CRC_32 of a modified copy so it gets past the CRC check.
+//
+static void test_section_recrc( guchar *section, gint size )
+{
+   guint32 crc = cgmi_psi_crc32( section, size - 4 );
+
+   section[size - 4] = (crc >> 24) & 0xFF;
+   section[size - 3] = (crc >> 16) & 0xFF;
+   section[size - 2] = (crc >> 8) & 0xFF;
+   section[size - 1] = crc & 0xFF;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// CRC
+////////////////////////////////////////////////////////////////////////////////
+
+static void test_crc( void )
+{
+   CHECK( 0x0376E6E7 == cgmi_psi_crc32((const guchar *)"123456789", 9) );
+   CHECK( 0 == cgmi_psi_crc32(gPatSection, sizeof(gPatSection)) );
+   CHECK( 0 == cgmi_psi_crc32(gPmtSection, sizeof(gPmtSection)) );
+
+   CHECK( 0xA02D67CD == cgmi_psi_section_crc(gPatSection, sizeof(gPatSection)) );
+   CHECK( 0xF99B1678 == cgmi_psi_section_crc(gPmtSection, sizeof(gPmtSection)) );
+   CHECK( 0 == cgmi_psi_section_crc(gPatSection, sizeof(gPatSection) - 1) );
+   CHECK( 0 == cgmi_psi_section_crc(NULL, sizeof(gPatSection)) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PAT
+////////////////////////////////////////////////////////////////////////////////
+
+static void test_pat( void )
+{
+   guchar section[sizeof(gPatSection)];
+   tPsiPat pat;
+   gint size;
+
+   CHECK( CGMI_ERROR_SUCCESS == cgmi_psi_parse_pat(gPatSection, sizeof(gPatSection), &pat) );
+   CHECK( 1 == pat.transportStreamId );
+   CHECK( 5 == pat.version );
+   CHECK( 0xA02D67CD == pat.crc );
+   CHECK( 2 == pat.numPrograms );
+   CHECK( 1 == pat.programs[0].programNumber );
+   CHECK( 0x100 == pat.programs[0].pmtPid );
+   CHECK( 2 == pat.programs[1].programNumber );
+   CHECK( 0x200 == pat.programs[1].pmtPid );
+
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pat(gPatSection, sizeof(gPatSection), NULL) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pat(NULL, sizeof(gPatSection), &pat) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pat(gPmtSection, sizeof(gPmtSection), &pat) );
+
+   for ( size = 0; size < (gint)sizeof(gPatSection); size++ )
+      CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pat(gPatSection, size, &pat) );
+
+   // a flipped bit anywhere is caught by the CRC
+   memcpy( section, gPatSection, sizeof(section) );
+   section[14] ^= 0x01;
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pat(section, sizeof(section), &pat) );
+
+   // current_next_indicator clear, the table is not applicable yet
+   memcpy( section, gPatSection, sizeof(section) );
+   section[5] &= ~0x01;
+   test_section_recrc( section, sizeof(section) );
+   CHECK( CGMI_ERROR_NOT_READY == cgmi_psi_parse_pat(section, sizeof(section), &pat) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PMT
+////////////////////////////////////////////////////////////////////////////////
+
+static void test_pmt( void )
+{
+   guchar section[sizeof(gPmtSection)];
+   tPsiPmtHeader pmt;
+   tPsiTables psi;
+   gint size;
+
+   memset( &psi, 0, sizeof(psi) );
+   CHECK( CGMI_ERROR_SUCCESS == cgmi_psi_parse_pmt(gPmtSection, sizeof(gPmtSection), &pmt, &psi) );
+   CHECK( 1 == pmt.programNumber );
+   CHECK( 3 == pmt.version );
+   CHECK( 0x101 == pmt.pcrPid );
+   CHECK( 0xF99B1678 == pmt.crc );
+
+   CHECK( 4 == psi.numStreams );
+   CHECK( 0x101 == psi.streams[0].pid && 0x02 == psi.streams[0].streamType );
+   CHECK( 0x102 == psi.streams[1].pid && 0x81 == psi.streams[1].streamType );
+   CHECK( 0x103 == psi.streams[2].pid && 0x81 == psi.streams[2].streamType );
+   CHECK( 0x104 == psi.streams[3].pid && 0x06 == psi.streams[3].streamType );
+
+   CHECK( 2 == psi.numAudioLanguages );
+   CHECK( 0x102 == psi.audioLanguages[0].pid && 1 == psi.audioLanguages[0].index );
+   CHECK( 0 == strcmp(psi.audioLanguages[0].isoCode, "eng") );
+   CHECK( 0x103 == psi.audioLanguages[1].pid && 2 == psi.audioLanguages[1].index );
+   CHECK( 0 == strcmp(psi.audioLanguages[1].isoCode, "spa") );
+   CHECK( 0x81 == psi.audioLanguages[1].streamType );
+   CHECK( FALSE == psi.audioLanguages[1].bDiscrete );
+
+   CHECK( 2 == psi.numClosedCaptionServices );
+   CHECK( 0 == strcmp(psi.closedCaptionServices[0].isoCode, "eng") );
+   CHECK( TRUE == psi.closedCaptionServices[0].isDigital && 1 == psi.closedCaptionServices[0].serviceNum );
+   CHECK( 0 == strcmp(psi.closedCaptionServices[1].isoCode, "spa") );
+   CHECK( FALSE == psi.closedCaptionServices[1].isDigital && 0 == psi.closedCaptionServices[1].serviceNum );
+
+   CHECK( 1 == psi.numSubtitleLanguages );
+   CHECK( 0x104 == psi.subtitleInfo[0].pid );
+   CHECK( 0 == strcmp(psi.subtitleInfo[0].isoCode, "eng") );
+   CHECK( 0x10 == psi.subtitleInfo[0].type );
+   CHECK( 1 == psi.subtitleInfo[0].compPageId && 2 == psi.subtitleInfo[0].ancPageId );
+
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(gPmtSection, sizeof(gPmtSection), NULL, &psi) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(gPmtSection, sizeof(gPmtSection), &pmt, NULL) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(gPatSection, sizeof(gPatSection), &pmt, &psi) );
+
+   for ( size = 0; size < (gint)sizeof(gPmtSection); size++ )
+      CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(gPmtSection, size, &pmt, &psi) );
+
+   memcpy( section, gPmtSection, sizeof(section) );
+   section[40] ^= 0x80;
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(section, sizeof(section), &pmt, &psi) );
+
+   memcpy( section, gPmtSection, sizeof(section) );
+   section[5] &= ~0x01;
+   test_section_recrc( section, sizeof(section) );
+   CHECK( CGMI_ERROR_NOT_READY == cgmi_psi_parse_pmt(section, sizeof(section), &pmt, &psi) );
+
+   // program_info_length running into the CRC
+   memcpy( section, gPmtSection, sizeof(section) );
+   section[11] = 0xFF;
+   test_section_recrc( section, sizeof(section) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(section, sizeof(section), &pmt, &psi) );
+
+   // ES_info_length of the video stream running into the CRC
+   memcpy( section, gPmtSection, sizeof(section) );
+   section[PMT_FIRST_ES_OFFSET + 4] = 0xFF;
+   test_section_recrc( section, sizeof(section) );
+   CHECK( CGMI_ERROR_BAD_PARAM == cgmi_psi_parse_pmt(section, sizeof(section), &pmt, &psi) );
+
+   // a caption descriptor longer than its loop ends that loop only
+   memcpy( section, gPmtSection, sizeof(section) );
+   section[PMT_CC_DESC_LEN_OFFSET] = 0x20;
+   test_section_recrc( section, sizeof(section) );
+   memset( &psi, 0, sizeof(psi) );
+   CHECK( CGMI_ERROR_SUCCESS == cgmi_psi_parse_pmt(section, sizeof(section), &pmt, &psi) );
+   CHECK( 4 == psi.numStreams );
+   CHECK( 0 == psi.numClosedCaptionServices );
+   CHECK( 2 == psi.numAudioLanguages );
+   CHECK( 1 == psi.numSubtitleLanguages );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Cache
+////////////////////////////////////////////////////////////////////////////////
+
+static void test_cache( void )
+{
+   tPsiPmtHeader pmt;
+   tPsiTables psi, cached;
+   guint program = 0, programIndex = 0;
+
+   cgmi_psi_parse_pmt( gPmtSection, sizeof(gPmtSection), &pmt, &psi );
+
+   cgmi_psi_cache_clear();
+   CHECK( FALSE == cgmi_psi_cache_lookup("udp://239.1.1.1:5000", &program, &programIndex, &cached) );
+
+   cgmi_psi_cache_store( "udp://239.1.1.1:5000", 1, 0, &psi );
+   CHECK( TRUE == cgmi_psi_cache_lookup("udp://239.1.1.1:5000", &program, &programIndex, &cached) );
+   CHECK( 1 == program && 0 == programIndex );
+   CHECK( 0 == memcmp(&psi, &cached, sizeof(psi)) );
+   CHECK( FALSE == cgmi_psi_cache_lookup("udp://239.1.1.2:5000", &program, &programIndex, &cached) );
+
+   cgmi_psi_cache_clear();
+   CHECK( FALSE == cgmi_psi_cache_lookup("udp://239.1.1.1:5000", &program, &programIndex, &cached) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Benchmark.  A stand in for the demux's stream-info object: the
+// descriptors come back as a GValueArray of GStrings, copied on every
+// g_object_get the way the demux hands them out.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+   GObject        parent;
+   guint          pid;
+   guint          streamType;
+   GValueArray    *descriptors;
+}TestStreamInfo;
+
+typedef struct
+{
+   GObjectClass   parent_class;
+}TestStreamInfoClass;
+
+enum
+{
+   PROP_0,
+   PROP_PID,
+   PROP_STREAM_TYPE,
+   PROP_DESCRIPTORS
+};
+
+GType test_stream_info_get_type( void );
+G_DEFINE_TYPE( TestStreamInfo, test_stream_info, G_TYPE_OBJECT )
+
+static void test_stream_info_get_property( GObject *object, guint prop_id, GValue *value, GParamSpec *pspec )
+{
+   TestStreamInfo *si = (TestStreamInfo *)object;
+
+   switch ( prop_id )
+   {
+      case PROP_PID:
+         g_value_set_uint( value, si->pid );
+         break;
+      case PROP_STREAM_TYPE:
+         g_value_set_uint( value, si->streamType );
+         break;
+      case PROP_DESCRIPTORS:
+         g_value_set_boxed( value, si->descriptors );
+         break;
+      default:
+         G_OBJECT_WARN_INVALID_PROPERTY_ID( object, prop_id, pspec );
+         break;
+   }
+}
+
+static void test_stream_info_finalize( GObject *object )
+{
+   TestStreamInfo *si = (TestStreamInfo *)object;
+
+   if ( NULL != si->descriptors )
+      g_value_array_free( si->descriptors );
+
+   G_OBJECT_CLASS(test_stream_info_parent_class)->finalize( object );
+}
+
+static void test_stream_info_class_init( TestStreamInfoClass *klass )
+{
+   GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+   gobject_class->get_property = test_stream_info_get_property;
+   gobject_class->finalize = test_stream_info_finalize;
+
+   g_object_class_install_property( gobject_class, PROP_PID,
+      g_param_spec_uint("pid", "PID", "Elementary stream PID", 0, 0x1FFF, 0, G_PARAM_READABLE) );
+   g_object_class_install_property( gobject_class, PROP_STREAM_TYPE,
+      g_param_spec_uint("stream-type", "Stream type", "Elementary stream type", 0, 0xFF, 0, G_PARAM_READABLE) );
+   g_object_class_install_property( gobject_class, PROP_DESCRIPTORS,
+      g_param_spec_boxed("descriptors", "Descriptors", "ES descriptors, one GString each",
+                         G_TYPE_VALUE_ARRAY, G_PARAM_READABLE) );
+}
+
+static void test_stream_info_init( TestStreamInfo *si )
+{
+   si->descriptors = g_value_array_new( 0 );
+}
+
+//
+// Splits the captured PMT's ES loop into stream-info objects.
+//
+static GPtrArray *bench_build_stream_infos( void )
+{
+   GPtrArray *infos = g_ptr_array_new_with_free_func( g_object_unref );
+   TestStreamInfo *si;
+   GString *string;
+   GValue value = { 0, };
+   gint pos, end, infoLen, descEnd;
+
+   end = sizeof(gPmtSection) - 4;
+   for ( pos = PMT_FIRST_ES_OFFSET; pos + 5 <= end; pos = descEnd )
+   {
+      si = g_object_new( test_stream_info_get_type(), NULL );
+      si->streamType = gPmtSection[pos];
+      si->pid = ((gPmtSection[pos + 1] & 0x1F) << 8) | gPmtSection[pos + 2];
+      infoLen = ((gPmtSection[pos + 3] & 0x0F) << 8) | gPmtSection[pos + 4];
+      pos += 5;
+      descEnd = pos + infoLen;
+
+      while ( pos + 2 <= descEnd )
+      {
+         string = g_string_new_len( (const gchar *)&gPmtSection[pos], gPmtSection[pos + 1] + 2 );
+         g_value_init( &value, G_TYPE_GSTRING );
+         g_value_take_boxed( &value, string );
+         g_value_array_append( si->descriptors, &value );
+         g_value_unset( &value );
+         pos += gPmtSection[pos + 1] + 2;
+      }
+
+      g_ptr_array_add( infos, si );
+   }
+
+   return infos;
+}
+
+//
+// The per-stream walk cgmi_gst_psi_info does over the demux's objects.
+//
+static void bench_gobject_walk( GPtrArray *infos, tPsiTables *psi )
+{
+   GValueArray *descriptors = NULL;
+   GString *string;
+   guint esPid, esType;
+   guint j, z;
+
+   memset( psi, 0, sizeof(tPsiTables) );
+   for ( j = 0; j < infos->len; j++ )
+   {
+      g_object_get( g_ptr_array_index(infos, j), "pid", &esPid, "stream-type", &esType,
+                    "descriptors", &descriptors, NULL );
+      psi->streams[psi->numStreams].pid = esPid;
+      psi->streams[psi->numStreams].streamType = esType;
+      for ( z = 0; NULL != descriptors && z < descriptors->n_values; z++ )
+      {
+         string = (GString *)g_value_get_boxed( g_value_array_get_nth(descriptors, z) );
+         cgmi_psi_parse_descriptors( psi, psi->numStreams, esPid, esType,
+                                     (const guchar *)string->str, string->len );
+      }
+      psi->numStreams++;
+      if ( NULL != descriptors )
+      {
+         g_value_array_free( descriptors );
+         descriptors = NULL;
+      }
+   }
+}
+
+static int test_bench( int iterations )
+{
+   GPtrArray *infos;
+   tPsiPmtHeader pmt;
+   tPsiTables psi, walked;
+   tPsiPat pat;
+   gint64 start, parseTime, walkTime, patTime;
+   int i;
+
+   infos = bench_build_stream_infos();
+
+   // both paths have to agree before their times mean anything
+   cgmi_psi_parse_pmt( gPmtSection, sizeof(gPmtSection), &pmt, &psi );
+   bench_gobject_walk( infos, &walked );
+   if ( 0 != memcmp(&psi, &walked, sizeof(psi)) )
+   {
+      g_print("GObject walk and section parser disagree\n");
+      g_ptr_array_free( infos, TRUE );
+      return -1;
+   }
+
+   start = g_get_monotonic_time();
+   for ( i = 0; i < iterations; i++ )
+      cgmi_psi_parse_pat( gPatSection, sizeof(gPatSection), &pat );
+   patTime = g_get_monotonic_time() - start;
+
+   start = g_get_monotonic_time();
+   for ( i = 0; i < iterations; i++ )
+      cgmi_psi_parse_pmt( gPmtSection, sizeof(gPmtSection), &pmt, &psi );
+   parseTime = g_get_monotonic_time() - start;
+
+   start = g_get_monotonic_time();
+   for ( i = 0; i < iterations; i++ )
+      bench_gobject_walk( infos, &walked );
+   walkTime = g_get_monotonic_time() - start;
+
+   g_print("%-28s %10.3f us per PAT\n", "cgmi_psi_parse_pat", (double)patTime / iterations);
+   g_print("%-28s %10.3f us per PMT\n", "cgmi_psi_parse_pmt", (double)parseTime / iterations);
+   g_print("%-28s %10.3f us per PMT\n", "stream-info GObject walk", (double)walkTime / iterations);
+
+   g_ptr_array_free( infos, TRUE );
+
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   int iterations = DEFAULT_BENCH_ITERATIONS;
+
+#if !GLIB_CHECK_VERSION(2,36,0)
+   g_type_init();
+#endif
+
+   test_crc();
+   test_pat();
+   test_pmt();
+   test_cache();
+
+   g_print("%d checks, %d failed\n", gChecks, gFailures);
+   if ( 0 != gFailures )
+      return 1;
+
+   if ( argc > 1 && strcmp(argv[1], "bench") == 0 )
+   {
+      if ( argc > 2 && atoi(argv[2]) > 0 )
+         iterations = atoi(argv[2]);
+      return test_bench( iterations );
+   }
+
+   return 0;
+}
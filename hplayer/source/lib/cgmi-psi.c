@@ -0,0 +1,425 @@
+/*
+    CGMI
+    Copyright (C) {2015}  {Cisco System}
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+    USA
+
+    Contributing Authors: Matt Snoby, Kris Kersey, Zack Wine, Chris Foster,
+                          Tankut Akgul, Saravanakumar Periyaswamy
+
+*/
+
+/*
+ * PAT/PMT section parsing (ISO/IEC 13818-1 2.4.4).  Decodes raw sections
+ * straight into caller supplied tables, nothing is allocated and every read
+ * is checked against the section and descriptor lengths.  It makes no
+ * GStreamer calls, so captured sections can be fed to it outside of a
+ * pipeline.  The per-URI cache of decoded PSI lives here as well.
+*/
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <glib.h>
+#include "cgmi-psi-priv.h"
+
+#define PSI_SECTION_HEADER_SIZE  3          /* table_id and section_length */
+#define PSI_CRC_SIZE             4
+#define PSI_PAT_FIXED_SIZE       8          /* through last_section_number */
+#define PSI_PMT_FIXED_SIZE       12         /* through program_info_length */
+#define PSI_ES_FIXED_SIZE        5
+#define PSI_CC_SERVICE_SIZE      6
+
+static guint32 gCrcTable[256];
+
+static void cgmi_psi_crc_init( void )
+{
+   static gsize initialized = 0;
+   guint32 crc;
+   gint i, j;
+
+   if ( g_once_init_enter(&initialized) )
+   {
+      for ( i = 0; i < 256; i++ )
+      {
+         crc = (guint32)i << 24;
+         for ( j = 0; j < 8; j++ )
+            crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+         gCrcTable[i] = crc;
+      }
+      g_once_init_leave(&initialized, 1);
+   }
+}
+
+//
+// MPEG-2 CRC_32.  Run over a whole section including its CRC_32 field the
+// result is 0 for an intact section.
+//
+guint32 cgmi_psi_crc32( const guchar *data, gint size )
+{
+   guint32 crc = 0xFFFFFFFF;
+
+   cgmi_psi_crc_init();
+
+   while ( size-- > 0 )
+      crc = (crc << 8) ^ gCrcTable[((crc >> 24) ^ *data++) & 0xFF];
+
+   return crc;
+}
+
+//
+// Checks the section header and returns the section's total length, or 0 if
+// it is not a complete long form section of the given table.
+//
+static gint cgmi_psi_section_size( const guchar *section, gint size, guint tableId )
+{
+   gint total;
+
+   if ( NULL == section || size < PSI_SECTION_HEADER_SIZE )
+      return 0;
+
+   if ( section[0] != tableId || 0 == (section[1] & 0x80) )
+      return 0;
+
+   total = PSI_SECTION_HEADER_SIZE + (((section[1] & 0x0F) << 8) | section[2]);
+   if ( total > size || total > MAX_PSI_SECTION_SIZE )
+      return 0;
+
+   return total;
+}
+
+//
+// The CRC_32 field carried in the section, without verifying it.  Cheap
+// enough to tell a repeated section from a new one before parsing.
+//
+guint32 cgmi_psi_section_crc( const guchar *section, gint size )
+{
+   gint total;
+
+   if ( NULL == section || size < PSI_SECTION_HEADER_SIZE )
+      return 0;
+
+   total = PSI_SECTION_HEADER_SIZE + (((section[1] & 0x0F) << 8) | section[2]);
+   if ( total > size || total < PSI_SECTION_HEADER_SIZE + PSI_CRC_SIZE )
+      return 0;
+
+   section += total - PSI_CRC_SIZE;
+   return ((guint32)section[0] << 24) | ((guint32)section[1] << 16) | ((guint32)section[2] << 8) | section[3];
+}
+
+cgmi_Status cgmi_psi_parse_pat( const guchar *section, gint size, tPsiPat *pat )
+{
+   gint total, pos, end;
+   guint program;
+
+   if ( NULL == pat )
+      return CGMI_ERROR_BAD_PARAM;
+
+   total = cgmi_psi_section_size( section, size, PSI_TABLE_ID_PAT );
+   if ( total < PSI_PAT_FIXED_SIZE + PSI_CRC_SIZE )
+      return CGMI_ERROR_BAD_PARAM;
+
+   if ( 0 != cgmi_psi_crc32(section, total) )
+      return CGMI_ERROR_BAD_PARAM;
+
+   // a table that is not applicable yet
+   if ( 0 == (section[5] & 0x01) )
+      return CGMI_ERROR_NOT_READY;
+
+   memset( pat, 0, sizeof(tPsiPat) );
+   pat->transportStreamId = (section[3] << 8) | section[4];
+   pat->version = (section[5] >> 1) & 0x1F;
+   pat->crc = cgmi_psi_section_crc( section, total );
+
+   end = total - PSI_CRC_SIZE;
+   for ( pos = PSI_PAT_FIXED_SIZE; pos + 4 <= end; pos += 4 )
+   {
+      program = (section[pos] << 8) | section[pos + 1];
+      if ( 0 == program )
+         continue;
+
+      if ( pat->numPrograms >= PSI_MAX_PROGRAMS )
+      {
+         g_print("Maximum number of PAT programs %d has been reached!!!\n", PSI_MAX_PROGRAMS);
+         break;
+      }
+      pat->programs[pat->numPrograms].programNumber = program;
+      pat->programs[pat->numPrograms].pmtPid = ((section[pos + 2] & 0x1F) << 8) | section[pos + 3];
+      pat->numPrograms++;
+   }
+
+   return CGMI_ERROR_SUCCESS;
+}
+
+cgmi_Status cgmi_psi_parse_pmt( const guchar *section, gint size, tPsiPmtHeader *pmt, tPsiTables *psi )
+{
+   gint total, pos, end, infoLen;
+   guint esType, esPid;
+
+   if ( NULL == pmt || NULL == psi )
+      return CGMI_ERROR_BAD_PARAM;
+
+   total = cgmi_psi_section_size( section, size, PSI_TABLE_ID_PMT );
+   if ( total < PSI_PMT_FIXED_SIZE + PSI_CRC_SIZE )
+      return CGMI_ERROR_BAD_PARAM;
+
+   if ( 0 != cgmi_psi_crc32(section, total) )
+      return CGMI_ERROR_BAD_PARAM;
+
+   if ( 0 == (section[5] & 0x01) )
+      return CGMI_ERROR_NOT_READY;
+
+   pmt->programNumber = (section[3] << 8) | section[4];
+   pmt->version = (section[5] >> 1) & 0x1F;
+   pmt->pcrPid = ((section[8] & 0x1F) << 8) | section[9];
+   pmt->crc = cgmi_psi_section_crc( section, total );
+
+   end = total - PSI_CRC_SIZE;
+   infoLen = ((section[10] & 0x0F) << 8) | section[11];
+   pos = PSI_PMT_FIXED_SIZE + infoLen;
+   if ( pos > end )
+      return CGMI_ERROR_BAD_PARAM;
+
+   memset( psi, 0, sizeof(tPsiTables) );
+
+   while ( pos + PSI_ES_FIXED_SIZE <= end && psi->numStreams < MAX_STREAMS )
+   {
+      esType = section[pos];
+      esPid = ((section[pos + 1] & 0x1F) << 8) | section[pos + 2];
+      infoLen = ((section[pos + 3] & 0x0F) << 8) | section[pos + 4];
+      pos += PSI_ES_FIXED_SIZE;
+      if ( pos + infoLen > end )
+         return CGMI_ERROR_BAD_PARAM;
+
+      psi->streams[psi->numStreams].pid = esPid;
+      psi->streams[psi->numStreams].streamType = esType;
+      cgmi_psi_parse_descriptors( psi, psi->numStreams, esPid, esType, &section[pos], infoLen );
+      psi->numStreams++;
+
+      pos += infoLen;
+   }
+
+   return CGMI_ERROR_SUCCESS;
+}
+
+//
+// Decodes the descriptor loop of elementary stream 'stream' into psi.  A
+// descriptor running past the end of the loop ends it.
+//
+void cgmi_psi_parse_descriptors( tPsiTables *psi, gint stream, guint esPid, guint esType,
+                                 const guchar *desc, gint size )
+{
+   const guchar *body;
+   gint len, pos = 0;
+   gint i, num;
+
+   while ( pos + 2 <= size )
+   {
+      len = desc[pos + 1];
+      body = &desc[pos + 2];
+      if ( pos + 2 + len > size )
+         break;
+
+      switch ( desc[pos] )
+      {
+         case 0x0A: /* ISO_639_language_descriptor */
+            if ( len < 4 )
+               break;
+            if ( psi->numAudioLanguages >= MAX_AUDIO_LANGUAGE_DESCRIPTORS )
+            {
+               g_print("Maximum number of audio language descriptors %d has been reached!!!\n",
+                       MAX_AUDIO_LANGUAGE_DESCRIPTORS);
+               break;
+            }
+            psi->audioLanguages[psi->numAudioLanguages].pid = esPid;
+            psi->audioLanguages[psi->numAudioLanguages].streamType = esType;
+            psi->audioLanguages[psi->numAudioLanguages].index = stream;
+            memcpy( psi->audioLanguages[psi->numAudioLanguages].isoCode, body, 3 );
+            psi->audioLanguages[psi->numAudioLanguages].isoCode[3] = 0;
+            psi->audioLanguages[psi->numAudioLanguages].bDiscrete = FALSE;
+            psi->numAudioLanguages++;
+            break;
+
+         case 0x59: /* Subtitling descriptor */
+            if ( len < 8 || psi->numSubtitleLanguages >= MAX_SUBTITLE_LANGUAGES )
+               break;
+            psi->subtitleInfo[psi->numSubtitleLanguages].pid = esPid;
+            memcpy( psi->subtitleInfo[psi->numSubtitleLanguages].isoCode, body, 3 );
+            psi->subtitleInfo[psi->numSubtitleLanguages].isoCode[3] = 0;
+            psi->subtitleInfo[psi->numSubtitleLanguages].type = body[3];
+            psi->subtitleInfo[psi->numSubtitleLanguages].compPageId = (gushort)((body[4] << 8) | body[5]);
+            psi->subtitleInfo[psi->numSubtitleLanguages].ancPageId = (gushort)((body[6] << 8) | body[7]);
+            psi->numSubtitleLanguages++;
+            break;
+
+         case 0x86: /* Closed Caption Service Descriptor */
+            if ( len < 1 )
+               break;
+            num = body[0] & 0x1F;
+            if ( num > (len - 1) / PSI_CC_SERVICE_SIZE )
+               num = (len - 1) / PSI_CC_SERVICE_SIZE;
+            if ( num > MAX_CLOSED_CAPTION_SERVICES )
+            {
+               g_print("Maximum number of closed caption descriptors %d has been reached!!!\n",
+                       MAX_CLOSED_CAPTION_SERVICES);
+               num = MAX_CLOSED_CAPTION_SERVICES;
+            }
+
+            psi->numClosedCaptionServices = num;
+            for ( i = 0; i < num; i++ )
+            {
+               const guchar *service = &body[1 + i * PSI_CC_SERVICE_SIZE];
+
+               memset( psi->closedCaptionServices[i].isoCode, 0, 4 );
+               memcpy( psi->closedCaptionServices[i].isoCode, service, 3 );
+               if ( service[3] & 0x80 )
+               {
+                  psi->closedCaptionServices[i].isDigital = TRUE;
+                  psi->closedCaptionServices[i].serviceNum = service[3] & 0x3F;
+               }
+               else
+               {
+                  psi->closedCaptionServices[i].isDigital = FALSE;
+                  //Code field number into service number
+                  psi->closedCaptionServices[i].serviceNum = service[3] & 0x01;
+               }
+            }
+            break;
+
+         default:
+            break;
+      }
+
+      pos += len + 2;
+   }
+}
+
+//
+// PSI cache.  The tables decoded from the selected program's PMT are kept
+// for the last PSI_CACHE_SIZE load URIs, the most recently stored or looked
+// up first.  Entries are recycled, so a full cache costs no allocations.
+//
+#define PSI_CACHE_SIZE           16
+
+typedef struct
+{
+   gchar          *uri;
+   guint          program;
+   guint          programIndex;
+   tPsiTables     tables;
+}tPsiCacheEntry;
+
+static GMutex gPsiCacheMutex;
+static GQueue gPsiCache = G_QUEUE_INIT;
+
+// gPsiCacheMutex held
+static GList *cgmi_psi_cache_find( const gchar *uri )
+{
+   GList *link;
+
+   for ( link = gPsiCache.head; NULL != link; link = link->next )
+   {
+      if ( 0 == strcmp(((tPsiCacheEntry *)link->data)->uri, uri) )
+         return link;
+   }
+
+   return NULL;
+}
+
+void cgmi_psi_cache_store( const gchar *uri, guint program, guint programIndex, const tPsiTables *psi )
+{
+   tPsiCacheEntry *entry;
+   GList *link;
+
+   if ( NULL == uri || '\0' == uri[0] )
+      return;
+
+   g_mutex_lock( &gPsiCacheMutex );
+
+   link = cgmi_psi_cache_find( uri );
+   if ( NULL != link )
+   {
+      entry = (tPsiCacheEntry *)link->data;
+      g_queue_unlink( &gPsiCache, link );
+      g_queue_push_head_link( &gPsiCache, link );
+   }
+   else
+   {
+      if ( g_queue_get_length(&gPsiCache) >= PSI_CACHE_SIZE )
+      {
+         entry = (tPsiCacheEntry *)g_queue_pop_tail( &gPsiCache );
+         g_free( entry->uri );
+      }
+      else
+      {
+         entry = g_malloc( sizeof(tPsiCacheEntry) );
+      }
+      entry->uri = g_strdup( uri );
+      g_queue_push_head( &gPsiCache, entry );
+   }
+
+   entry->program = program;
+   entry->programIndex = programIndex;
+   memcpy( &entry->tables, psi, sizeof(tPsiTables) );
+
+   g_mutex_unlock( &gPsiCacheMutex );
+}
+
+gboolean cgmi_psi_cache_lookup( const gchar *uri, guint *program, guint *programIndex, tPsiTables *psi )
+{
+   tPsiCacheEntry *entry;
+   GList *link;
+
+   if ( NULL == uri )
+      return FALSE;
+
+   g_mutex_lock( &gPsiCacheMutex );
+
+   link = cgmi_psi_cache_find( uri );
+   if ( NULL != link )
+   {
+      entry = (tPsiCacheEntry *)link->data;
+      g_queue_unlink( &gPsiCache, link );
+      g_queue_push_head_link( &gPsiCache, link );
+
+      *program = entry->program;
+      *programIndex = entry->programIndex;
+      memcpy( psi, &entry->tables, sizeof(tPsiTables) );
+   }
+
+   g_mutex_unlock( &gPsiCacheMutex );
+
+   return (NULL != link);
+}
+
+void cgmi_psi_cache_clear( void )
+{
+   tPsiCacheEntry *entry;
+
+   g_mutex_lock( &gPsiCacheMutex );
+
+   while ( NULL != (entry = (tPsiCacheEntry *)g_queue_pop_head(&gPsiCache)) )
+   {
+      g_free( entry->uri );
+      g_free( entry );
+   }
+
+   g_mutex_unlock( &gPsiCacheMutex );
+}
@@ -30,6 +30,7 @@ typedef tcgmi_FilterFormat ciscoGstFilterFormat;
 
 typedef struct
 {
+   void                  *id;              /* handle the application sees */
    int                   pid;
    void                  *parentSession;
    void                  *filterPrivate;
@@ -42,6 +42,8 @@
 
 static cgmi_Status cgmiCreateFilter( void *pSession, int pid, void *pFilterPriv, ciscoGstFilterFormat format, void **pFilterId  );
 
+static tCgmiHandleTable gFilterHandles = { CGMI_HANDLE_TYPE_FILTER };
+
 #ifdef CGMI_SECTTION_FILTER_HEX_DUMP
 static void printHex( void *buffer, int size )
 {
@@ -201,7 +203,7 @@ static GstFlowReturn cgmi_filter_gst_appsink_new_buffer( GstAppSink *sink, gpoin
 
       // Ask nicely for a buffer from the app
       retStat = secFilter->bufferCB(pSess->usrParam, secFilter->filterPrivate,
-                                    (void *)secFilter, &retBuffer, &retBufferSize);
+                                    secFilter->id, &retBuffer, &retBufferSize);
 
       // Verify the app provided a useful buffer
       if ( retStat != CGMI_ERROR_SUCCESS )
@@ -241,7 +243,7 @@ static GstFlowReturn cgmi_filter_gst_appsink_new_buffer( GstAppSink *sink, gpoin
 
       // Return filled buffer to the app
       retStat = secFilter->sectionCB(pSess->usrParam, secFilter->filterPrivate,
-                                     secFilter, CGMI_ERROR_SUCCESS, retBuffer, (int)sinkDataSize);
+                                     secFilter->id, CGMI_ERROR_SUCCESS, retBuffer, (int)sinkDataSize);
 #if GST_CHECK_VERSION(1,0,0)
       gst_buffer_unmap(buffer, &map);
 #endif
@@ -349,11 +351,11 @@ cgmi_Status cgmi_CreateFilter( void *pSession, int pid, void *pFilterPriv, tcgmi
 cgmi_Status cgmi_DestroySectionFilter( void *pSession, void *pFilterId )
 {
    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession *)pSession;
-   tSectionFilter *secFilter = (tSectionFilter *)pFilterId;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tSectionFilter *secFilter = cgmi_handle_lookup(&gFilterHandles, pFilterId);
 
    // Check preconditions
-   if ( pSession == NULL || pFilterId == NULL )
+   if ( pSess == NULL || secFilter == NULL || secFilter->parentSession != pSess )
    {
       return CGMI_ERROR_BAD_PARAM;
    }
@@ -388,6 +390,7 @@ cgmi_Status cgmi_DestroySectionFilter( void *pSession, void *pFilterId )
    // Clean house
    secFilter->appsink = NULL;
 
+   cgmi_handle_free(&gFilterHandles, secFilter->id);
    g_free(secFilter);
 
    return retStat;
@@ -396,12 +399,12 @@ cgmi_Status cgmi_DestroySectionFilter( void *pSession, void *pFilterId )
 cgmi_Status cgmi_SetSectionFilter( void *pSession, void *pFilterId, tcgmi_FilterData *pFilterData )
 {
    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession *)pSession;
-   tSectionFilter *secFilter = (tSectionFilter *)pFilterId;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tSectionFilter *secFilter = cgmi_handle_lookup(&gFilterHandles, pFilterId);
    GValueArray *valueArray;
 
    // Check preconditions
-   if ( pSession == NULL || pFilterId == NULL )
+   if ( pSess == NULL || secFilter == NULL || secFilter->parentSession != pSess )
    {
       return CGMI_ERROR_BAD_PARAM;
    }
@@ -503,11 +506,11 @@ cgmi_Status cgmi_StartSectionFilter( void *pSession,
                                      sectionBufferCB sectionCB )
 {
    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession *)pSession;
-   tSectionFilter *secFilter = (tSectionFilter *)pFilterId;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tSectionFilter *secFilter = cgmi_handle_lookup(&gFilterHandles, pFilterId);
 
    // Check preconditions
-   if ( pSession == NULL || pFilterId == NULL )
+   if ( pSess == NULL || secFilter == NULL || secFilter->parentSession != pSess )
    {
       return CGMI_ERROR_BAD_PARAM;
    }
@@ -544,11 +547,11 @@ cgmi_Status cgmi_StartSectionFilter( void *pSession,
 cgmi_Status cgmi_StopSectionFilter( void *pSession, void *pFilterId )
 {
    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession *)pSession;
-   tSectionFilter *secFilter = (tSectionFilter *)pFilterId;
+   tSession *pSess = cgmi_LookupSession(pSession);
+   tSectionFilter *secFilter = cgmi_handle_lookup(&gFilterHandles, pFilterId);
 
    // Check preconditions
-   if ( pSession == NULL || pFilterId == NULL )
+   if ( pSess == NULL || secFilter == NULL || secFilter->parentSession != pSess )
    {
       return CGMI_ERROR_BAD_PARAM;
    }
@@ -586,13 +589,13 @@ cgmi_Status cgmi_StopSectionFilter( void *pSession, void *pFilterId )
 static cgmi_Status cgmiCreateFilter( void *pSession, int pid, void *pFilterPriv, ciscoGstFilterFormat format, void **pFilterId )
 {
    cgmi_Status retStat = CGMI_ERROR_SUCCESS;
-   tSession *pSess = (tSession *)pSession;
+   tSession *pSess = cgmi_LookupSession(pSession);
    tSectionFilter *secFilter = NULL;
    void *filterHandle = NULL;
    int filterId = -1;
    
    // Check preconditions
-   if ( NULL == pSession )
+   if ( NULL == pSess || NULL == pFilterId )
    {
       return CGMI_ERROR_BAD_PARAM;
    }
@@ -603,13 +606,20 @@ static cgmi_Status cgmiCreateFilter( void *pSession, int pid, void *pFilterPriv,
       return CGMI_ERROR_OUT_OF_MEMORY;
    }
 
-   // Set return pointer if we were able to allocate one
-   *pFilterId = secFilter;
+   secFilter->id = cgmi_handle_alloc(&gFilterHandles, secFilter);
+   if ( secFilter->id == NULL )
+   {
+      g_free(secFilter);
+      return CGMI_ERROR_OUT_OF_MEMORY;
+   }
+
+   // Set return handle if we were able to allocate one
+   *pFilterId = secFilter->id;
 
    // Init sectionFilter values
    secFilter->pid = pid;
    secFilter->format = format;
-   secFilter->parentSession = pSession;
+   secFilter->parentSession = pSess;
    secFilter->filterPrivate = pFilterPriv;
    secFilter->handle = NULL;
    secFilter->padAddedCbId = 0;
@@ -671,7 +681,11 @@ static cgmi_Status cgmiCreateFilter( void *pSession, int pid, void *pFilterPriv,
    // Clean up if there was an error
    if ( retStat != CGMI_ERROR_SUCCESS )
    {
-      g_signal_handler_disconnect(pSess->demux, secFilter->padAddedCbId);
+      if ( 0 != secFilter->padAddedCbId )
+      {
+         g_signal_handler_disconnect(pSess->demux, secFilter->padAddedCbId);
+      }
+      cgmi_handle_free(&gFilterHandles, secFilter->id);
       g_free(secFilter);
       *pFilterId = NULL;
    }
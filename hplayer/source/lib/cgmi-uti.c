@@ -70,6 +70,26 @@ typedef struct
    contentProtocol  protocol;
 }httpRespHdr;
 
+#ifdef ENABLE_DLNA_AUTODETECT
+
+#define DETECT_CACHE_TTL_SEC           300   // how long a protocol detection result stays valid
+#define DETECT_CACHE_MAX_ENTRIES       64
+#define CURL_HANDLE_POOL_SIZE          4     // idle easy handles kept around, their connections are shared
+
+typedef struct
+{
+   contentProtocol  protocol;
+   gint64           expiry;                  // monotonic time in us
+}tDetectCacheEntry;
+
+static GHashTable *gDetectCache = NULL;      // scheme+host+path prefix -> tDetectCacheEntry
+static GQueue     gCurlHandlePool = G_QUEUE_INIT;
+static GMutex     gDetectMutex;
+static CURLSH     *gCurlShare = NULL;         // DNS cache and keep-alive connections of every pooled handle
+static GMutex     gCurlShareMutex[CURL_LOCK_DATA_LAST];
+
+#endif
+
 
 #ifdef ENABLE_DLNA_AUTODETECT
 static size_t hdrResponseCb(void *ptr, size_t size, size_t nmemb, void *pData)
@@ -116,6 +136,140 @@ static size_t hdrResponseCb(void *ptr, size_t size, size_t nmemb, void *pData)
    return size * nmemb;
 }
 
+//
+// Protocol detection results are shared by every asset living in the same
+// directory of the same server, i.e. the url up to its last '/' (query
+// string excluded).
+//
+static gchar *detect_cache_key(const gchar *url)
+{
+   const gchar *end;
+   const gchar *query;
+   const gchar *slash;
+
+   query = strchr(url, '?');
+   end = (NULL != query) ? query : url + strlen(url);
+
+   slash = g_strrstr_len(url, end - url, "/");
+   if ( NULL != slash && slash > url && '/' != *(slash - 1) )
+   {
+      end = slash + 1;
+   }
+
+   return g_strndup(url, end - url);
+}
+
+static gboolean detect_cache_lookup(const gchar *key, contentProtocol *pProtocol)
+{
+   tDetectCacheEntry *pEntry;
+   gboolean found = FALSE;
+
+   g_mutex_lock(&gDetectMutex);
+   if ( NULL != gDetectCache )
+   {
+      pEntry = g_hash_table_lookup(gDetectCache, key);
+      if ( NULL != pEntry )
+      {
+         if ( g_get_monotonic_time() < pEntry->expiry )
+         {
+            *pProtocol = pEntry->protocol;
+            found = TRUE;
+         }
+         else
+         {
+            g_hash_table_remove(gDetectCache, key);
+         }
+      }
+   }
+   g_mutex_unlock(&gDetectMutex);
+
+   return found;
+}
+
+static void detect_cache_insert(const gchar *key, contentProtocol protocol)
+{
+   tDetectCacheEntry *pEntry;
+
+   g_mutex_lock(&gDetectMutex);
+   if ( NULL != gDetectCache )
+   {
+      // this is a small cache, when it fills up just start over
+      if ( g_hash_table_size(gDetectCache) >= DETECT_CACHE_MAX_ENTRIES )
+      {
+         g_hash_table_remove_all(gDetectCache);
+      }
+
+      pEntry = g_malloc0(sizeof(tDetectCacheEntry));
+      if ( NULL != pEntry )
+      {
+         pEntry->protocol = protocol;
+         pEntry->expiry = g_get_monotonic_time() + (gint64)DETECT_CACHE_TTL_SEC * G_USEC_PER_SEC;
+         g_hash_table_replace(gDetectCache, g_strdup(key), pEntry);
+      }
+   }
+   g_mutex_unlock(&gDetectMutex);
+}
+
+static void curl_share_lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr)
+{
+   g_mutex_lock(&gCurlShareMutex[data]);
+}
+
+static void curl_share_unlock(CURL *handle, curl_lock_data data, void *userptr)
+{
+   g_mutex_unlock(&gCurlShareMutex[data]);
+}
+
+//
+// The pooled easy handles share one connection cache, so a probe of a
+// server any of them has talked to recently skips the TCP handshake no
+// matter which handle it gets.
+//
+static CURL *curl_handle_get(void)
+{
+   CURL *ctx;
+
+   g_mutex_lock(&gDetectMutex);
+   ctx = g_queue_pop_head(&gCurlHandlePool);
+   g_mutex_unlock(&gDetectMutex);
+
+   if ( NULL == ctx )
+   {
+      ctx = curl_easy_init();
+   }
+   else
+   {
+      // clears the options, the share among them
+      curl_easy_reset(ctx);
+   }
+
+   if ( NULL != ctx && NULL != gCurlShare )
+   {
+      curl_easy_setopt(ctx, CURLOPT_SHARE, gCurlShare);
+   }
+
+   return ctx;
+}
+
+static void curl_handle_put(CURL *ctx)
+{
+   if ( NULL == ctx )
+      return;
+
+   g_mutex_lock(&gDetectMutex);
+   if ( g_queue_get_length(&gCurlHandlePool) < CURL_HANDLE_POOL_SIZE )
+   {
+      g_queue_push_head(&gCurlHandlePool, ctx);
+      ctx = NULL;
+   }
+   g_mutex_unlock(&gDetectMutex);
+
+   if ( NULL != ctx )
+   {
+      curl_easy_cleanup(ctx);
+   }
+}
+
 #endif
 
 
@@ -130,6 +284,26 @@ cgmi_Status cgmi_utils_init(void)
       //
 #ifdef ENABLE_DLNA_AUTODETECT
       curl_global_init(CURL_GLOBAL_ALL);
+
+      g_mutex_lock(&gDetectMutex);
+      if ( NULL == gDetectCache )
+      {
+         gDetectCache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+      }
+      if ( NULL == gCurlShare )
+      {
+         gCurlShare = curl_share_init();
+         if ( NULL != gCurlShare )
+         {
+            curl_share_setopt(gCurlShare, CURLSHOPT_LOCKFUNC, curl_share_lock);
+            curl_share_setopt(gCurlShare, CURLSHOPT_UNLOCKFUNC, curl_share_unlock);
+            curl_share_setopt(gCurlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+#if LIBCURL_VERSION_NUM >= 0x073900
+            curl_share_setopt(gCurlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+         }
+      }
+      g_mutex_unlock(&gDetectMutex);
 #endif
 
 
@@ -147,6 +321,26 @@ cgmi_Status cgmi_utils_finalize(void)
       // finalize the CURL library for this process.
       //
 #ifdef ENABLE_DLNA_AUTODETECT
+      CURL *ctx;
+
+      g_mutex_lock(&gDetectMutex);
+      while ( NULL != (ctx = g_queue_pop_head(&gCurlHandlePool)) )
+      {
+         curl_easy_cleanup(ctx);
+      }
+      // only once no easy handle uses it any more
+      if ( NULL != gCurlShare )
+      {
+         curl_share_cleanup(gCurlShare);
+         gCurlShare = NULL;
+      }
+      if ( NULL != gDetectCache )
+      {
+         g_hash_table_destroy(gDetectCache);
+         gDetectCache = NULL;
+      }
+      g_mutex_unlock(&gDetectMutex);
+
       curl_global_cleanup();
 #endif
 
@@ -158,7 +352,9 @@ cgmi_Status cgmi_utils_finalize(void)
 /**
  *  \brief \b cgmi_utils_is_content_dlna
  *
- *  Checks to see if the url is pointing to DLNA based content.
+ *  Checks to see if the url is pointing to DLNA based content.  Results are cached per
+ *  server directory for DETECT_CACHE_TTL_SEC, only for 2xx responses, and keep-alive
+ *  connections are shared by all the pooled curl handles.
  *
  *  \param[in] url  pointer to an http url shall be tested to see if it is pointing to a DLNA server
  *
@@ -183,13 +379,29 @@ cgmi_Status cgmi_utils_is_content_dlna(const gchar* url, gboolean *bisDLNAConten
 #ifdef ENABLE_DLNA_AUTODETECT
    httpRespHdr respHdr = {-1, CONTENT_TYPE_UNSUPPORTED, CONTENT_PROTOCOL_UNICAST_HTTP};
    CURL* ctx = NULL;
+   CURLcode res;
+   long httpCode = 0;
    struct curl_slist *headers = NULL;
+   gchar *cacheKey = NULL;
+   contentProtocol protocol;
 #endif
 
    do
    {
 #ifdef ENABLE_DLNA_AUTODETECT
-      ctx = curl_easy_init();
+      cacheKey = detect_cache_key(url);
+      if ( detect_cache_lookup(cacheKey, &protocol) )
+      {
+         *bisDLNAContent = (CONTENT_PROTOCOL_DLNA == protocol) ? TRUE : FALSE;
+         break;
+      }
+
+      ctx = curl_handle_get();
+      if ( NULL == ctx )
+      {
+         printf("Could not get a curl handle\n");
+         break;
+      }
       curl_easy_setopt(ctx, CURLOPT_HEADERFUNCTION, hdrResponseCb);
       curl_easy_setopt(ctx, CURLOPT_HEADERDATA, &respHdr);
 
@@ -202,21 +414,63 @@ cgmi_Status cgmi_utils_is_content_dlna(const gchar* url, gboolean *bisDLNAConten
       curl_easy_setopt(ctx,CURLOPT_CONNECTTIMEOUT, 2);
       curl_easy_setopt(ctx,CURLOPT_TIMEOUT, 3);
 
-      curl_easy_perform(ctx);
+      res = curl_easy_perform(ctx);
       if(CONTENT_PROTOCOL_DLNA == respHdr.protocol)
       {
          *bisDLNAContent = TRUE;
       }
+
+      // only remember real answers, a timed out probe or an error response
+      // is retried on the next load
+      if(CURLE_OK == res)
+      {
+         curl_easy_getinfo(ctx, CURLINFO_RESPONSE_CODE, &httpCode);
+      }
+      if(httpCode >= 200 && httpCode < 300)
+      {
+         detect_cache_insert(cacheKey, respHdr.protocol);
+      }
 #endif
    }while (0);
 
 #ifdef ENABLE_DLNA_AUTODETECT
    curl_slist_free_all(headers);
-   curl_easy_cleanup(ctx);
+   curl_handle_put(ctx);
+   g_free(cacheKey);
 #endif
    return status;
 }
 
+/**
+ *  \brief \b cgmi_utils_is_dlna_detect_cached
+ *
+ *  Tells whether cgmi_utils_is_content_dlna can answer for this url without a network
+ *  request, either from the detection cache or because DLNA autodetection is disabled.
+ *
+ *  \param[in] url  pointer to an http url
+ *
+ * \return  TRUE when no HEAD request would be made for the url
+ *
+ *  \ingroup CGMI
+ *
+ */
+gboolean cgmi_utils_is_dlna_detect_cached(const gchar* url)
+{
+#ifdef ENABLE_DLNA_AUTODETECT
+   gchar *cacheKey;
+   contentProtocol protocol;
+   gboolean found;
+
+   cacheKey = detect_cache_key(url);
+   found = detect_cache_lookup(cacheKey, &protocol);
+   g_free(cacheKey);
+
+   return found;
+#else
+   return TRUE;
+#endif
+}
+
 /**
  *  \brief \b cgmi_utils_get_json_value
  *
@@ -272,3 +526,175 @@ cgmi_Status cgmi_utils_get_json_value(gchar *output, gint outsize, const gchar *
    return CGMI_ERROR_FAILED;
 }
 
+
+/**
+ *  \brief \b cgmi_handle_alloc
+ *
+ *  Binds an object to a free slot of a handle table.  Slots are handed out
+ *  round robin so a handle that was just released is not immediately reused,
+ *  and every reuse of a slot bumps its generation.
+ *
+ *  \param[in] table   handle table
+ *
+ *  \param[in] object  object the handle resolves to
+ *
+ * \return  the new handle, NULL when the table is full
+ *
+ *  \ingroup CGMI
+ *
+ */
+void* cgmi_handle_alloc( tCgmiHandleTable *table, gpointer object )
+{
+   guint32 handle = 0;
+   guint slot;
+   guint gen;
+   guint i;
+
+   if ( NULL == table || NULL == object )
+      return NULL;
+
+   g_mutex_lock( &table->mutex );
+   for ( i = 0; i < CGMI_HANDLE_MAX_SLOTS; i++ )
+   {
+      slot = (table->nextSlot + i) % CGMI_HANDLE_MAX_SLOTS;
+      if ( 0 != table->live[slot] )
+         continue;
+
+      gen = (table->lastGen[slot] + 1) & ((1 << CGMI_HANDLE_GEN_BITS) - 1);
+      if ( 0 == gen )
+         gen = 1;
+      table->lastGen[slot] = gen;
+
+      // publish the object before the generation that makes it reachable
+      g_atomic_pointer_set( &table->object[slot], object );
+      g_atomic_int_set( &table->live[slot], (gint)gen );
+
+      table->nextSlot = (slot + 1) % CGMI_HANDLE_MAX_SLOTS;
+      table->count++;
+      handle = (gen << (CGMI_HANDLE_SLOT_BITS + CGMI_HANDLE_TYPE_BITS)) |
+               ((guint32)table->type << CGMI_HANDLE_SLOT_BITS) | slot;
+      break;
+   }
+   g_mutex_unlock( &table->mutex );
+
+   if ( 0 == handle )
+      printf("No free handles left (%d in use)\n", CGMI_HANDLE_MAX_SLOTS);
+
+   return GUINT_TO_POINTER( handle );
+}
+
+/**
+ *  \brief \b cgmi_handle_lookup
+ *
+ *  Resolves a handle without taking any lock.  The generation is read before
+ *  and after the object so a slot released or reused in between is caught.
+ *
+ *  \param[in] table   handle table
+ *
+ *  \param[in] handle  handle from cgmi_handle_alloc
+ *
+ * \return  the object, NULL when the handle is stale, of another type or not a handle
+ *
+ *  \ingroup CGMI
+ *
+ */
+gpointer cgmi_handle_lookup( tCgmiHandleTable *table, const void *handle )
+{
+   guint32 h = GPOINTER_TO_UINT( handle );
+   guint slot = h & (CGMI_HANDLE_MAX_SLOTS - 1);
+   guint type = (h >> CGMI_HANDLE_SLOT_BITS) & ((1 << CGMI_HANDLE_TYPE_BITS) - 1);
+   gint gen = (gint)(h >> (CGMI_HANDLE_SLOT_BITS + CGMI_HANDLE_TYPE_BITS));
+   gpointer object;
+
+   // anything wider than 32 bits is an old style raw pointer
+   if ( NULL == table || 0 == gen || type != table->type || (guintptr)handle != (guintptr)h )
+      return NULL;
+
+   if ( g_atomic_int_get(&table->live[slot]) != gen )
+      return NULL;
+
+   object = g_atomic_pointer_get( &table->object[slot] );
+
+   if ( g_atomic_int_get(&table->live[slot]) != gen )
+      return NULL;
+
+   return object;
+}
+
+/**
+ *  \brief \b cgmi_handle_free
+ *
+ *  Releases a handle.  Lookups of it fail from here on, even once the slot is
+ *  handed out again.
+ *
+ *  \param[in] table   handle table
+ *
+ *  \param[in] handle  handle from cgmi_handle_alloc
+ *
+ * \return  TRUE if the handle was live, FALSE if it was already released
+ *
+ *  \ingroup CGMI
+ *
+ */
+gboolean cgmi_handle_free( tCgmiHandleTable *table, const void *handle )
+{
+   guint32 h = GPOINTER_TO_UINT( handle );
+   guint slot = h & (CGMI_HANDLE_MAX_SLOTS - 1);
+   gboolean bFreed = FALSE;
+
+   if ( NULL == cgmi_handle_lookup(table, handle) )
+      return FALSE;
+
+   g_mutex_lock( &table->mutex );
+   if ( g_atomic_int_get(&table->live[slot]) == (gint)(h >> (CGMI_HANDLE_SLOT_BITS + CGMI_HANDLE_TYPE_BITS)) )
+   {
+      g_atomic_int_set( &table->live[slot], 0 );
+      g_atomic_pointer_set( &table->object[slot], NULL );
+      table->count--;
+      bFreed = TRUE;
+   }
+   g_mutex_unlock( &table->mutex );
+
+   return bFreed;
+}
+
+/**
+ *  \brief \b cgmi_handle_foreach
+ *
+ *  Calls func for every object that currently has a live handle.  The table
+ *  stays locked meanwhile, so cgmi_handle_free, and with it the release of
+ *  the object, waits until func returns.  func must not allocate or free
+ *  handles of the same table.
+ *
+ *  \param[in] table        handle table
+ *
+ *  \param[in] func         called with each object and userData
+ *
+ *  \param[in] userData     passed to func
+ *
+ * \return  number of objects visited
+ *
+ *  \ingroup CGMI
+ *
+ */
+guint cgmi_handle_foreach( tCgmiHandleTable *table, GFunc func, gpointer userData )
+{
+   guint num = 0;
+   guint slot;
+
+   if ( NULL == table || NULL == func )
+      return 0;
+
+   g_mutex_lock( &table->mutex );
+   for ( slot = 0; slot < CGMI_HANDLE_MAX_SLOTS; slot++ )
+   {
+      if ( 0 != table->live[slot] )
+      {
+         func( table->object[slot], userData );
+         num++;
+      }
+   }
+   g_mutex_unlock( &table->mutex );
+
+   return num;
+}